@@ -22,6 +22,7 @@
 # include  "Module.h"
 # include  "PGate.h"
 # include  "PWire.h"
+# include  "compiler.h"
 # include  <cassert>
 
 using namespace std;
@@ -43,6 +44,16 @@ Module::~Module()
 {
 }
 
+void* Module::operator new(size_t size)
+{
+      return pform_arena.alloc(size);
+}
+
+void Module::operator delete(void*obj, size_t size)
+{
+      pform_arena.free(obj, size);
+}
+
 void Module::add_gate(PGate*gate)
 {
       gates_.push_back(gate);
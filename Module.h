@@ -75,6 +75,10 @@ class Module : public PScopeExtra, public PNamedItem {
       explicit Module(LexicalScope*parent, perm_string name);
       ~Module();
 
+	// Module objects live in the pform_arena (see compiler.h).
+      static void* operator new(size_t size);
+      static void  operator delete(void*obj, size_t size);
+
 	/* Initially false. This is set to true if the module has been
 	   declared as a library module. This makes the module
 	   ineligible for being chosen as an implicit root. It has no
@@ -44,6 +44,16 @@ PExpr::~PExpr()
 {
 }
 
+void* PExpr::operator new(size_t size)
+{
+      return pform_arena.alloc(size);
+}
+
+void PExpr::operator delete(void*obj, size_t size)
+{
+      pform_arena.free(obj, size);
+}
+
 void PExpr::declare_implicit_nets(LexicalScope*, NetNet::Type)
 {
 }
@@ -62,6 +62,10 @@ class PExpr : public LineInfo {
       PExpr();
       virtual ~PExpr();
 
+	// PExpr objects live in the pform_arena (see compiler.h).
+      static void* operator new(size_t size);
+      static void  operator delete(void*obj, size_t size);
+
       virtual void dump(std::ostream&) const;
 
         // This method tests whether the expression contains any identifiers
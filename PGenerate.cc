@@ -19,6 +19,7 @@
 
 # include  "PGenerate.h"
 # include  "PWire.h"
+# include  "compiler.h"
 # include  "ivl_assert.h"
 
 using namespace std;
@@ -38,6 +39,16 @@ PGenerate::~PGenerate()
 {
 }
 
+void* PGenerate::operator new(size_t size)
+{
+      return pform_arena.alloc(size);
+}
+
+void PGenerate::operator delete(void*obj, size_t size)
+{
+      pform_arena.free(obj, size);
+}
+
 void PGenerate::add_gate(PGate*gate)
 {
       gates.push_back(gate);
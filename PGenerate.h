@@ -56,6 +56,10 @@ class PGenerate : public PNamedItem, public LexicalScope {
       explicit PGenerate(LexicalScope*parent, unsigned id_number);
       ~PGenerate();
 
+	// PGenerate objects live in the pform_arena (see compiler.h).
+      static void* operator new(size_t size);
+      static void  operator delete(void*obj, size_t size);
+
 	// Generate schemes have an ID number, for when the scope is
 	// implicit.
       const unsigned id_number;
@@ -21,6 +21,7 @@
 # include "ivl_assert.h"
 # include  "PWire.h"
 # include  "PExpr.h"
+# include  "compiler.h"
 # include  <cassert>
 
 using namespace std;
@@ -47,6 +48,16 @@ PWire::PWire(perm_string n,
       }
 }
 
+void* PWire::operator new(size_t size)
+{
+      return pform_arena.alloc(size);
+}
+
+void PWire::operator delete(void*obj, size_t size)
+{
+      pform_arena.free(obj, size);
+}
+
 NetNet::Type PWire::get_wire_type() const
 {
       return type_;
@@ -59,6 +59,10 @@ class PWire : public PNamedItem {
 	    NetNet::PortType pt,
 	    PWSRType rt = SR_NET);
 
+	// PWire objects live in the pform_arena (see compiler.h).
+      static void* operator new(size_t size);
+      static void  operator delete(void*obj, size_t size);
+
 	// Return a hierarchical name.
       perm_string basename() const;
 
@@ -21,6 +21,7 @@
 
 # include  "Statement.h"
 # include  "PExpr.h"
+# include  "compiler.h"
 # include  "ivl_assert.h"
 
 using namespace std;
@@ -29,6 +30,16 @@ Statement::~Statement()
 {
 }
 
+void* Statement::operator new(size_t size)
+{
+      return pform_arena.alloc(size);
+}
+
+void Statement::operator delete(void*obj, size_t size)
+{
+      pform_arena.free(obj, size);
+}
+
 PAssign_::PAssign_(PExpr*lval__, PExpr*ex, bool is_constant)
 : event_(0), count_(0), lval_(lval__), rval_(ex), is_constant_(is_constant)
 {
@@ -80,6 +80,10 @@ class Statement : virtual public LineInfo {
       Statement() { }
       virtual ~Statement() =0;
 
+	// Statement objects live in the pform_arena (see compiler.h).
+      static void* operator new(size_t size);
+      static void  operator delete(void*obj, size_t size);
+
       virtual void dump(std::ostream&out, unsigned ind) const;
       virtual NetProc* elaborate(Design*des, NetScope*scope) const;
       virtual void elaborate_scope(Design*des, NetScope*scope) const;
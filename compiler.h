@@ -23,6 +23,7 @@
 # include  <map>
 # include  "netlist.h"
 # include  "StringHeap.h"
+# include  "Arena.h"
 
 /*
  * This defines constants and defaults for the compiler in general.
@@ -273,6 +274,18 @@ extern StringHeapLex bits_strings;
  */
 extern StringHeapLex filename_strings;
 
+/*
+ * The pform_arena holds the parse tree objects (PExpr, Statement,
+ * PWire, PGenerate and Module), and the net_arena holds the
+ * elaborated expressions and statements (NetExpr and NetProc). Both
+ * recycle freed blocks, since the parser and the optimizers replace
+ * a lot of these objects as they go. The pform is not needed once the
+ * design is elaborated, so main() releases the pform_arena in one
+ * step before running the functors.
+ */
+extern RecyclingArena pform_arena;
+extern RecyclingArena net_arena;
+
 
 /*
  * system task/function listings.
@@ -20,6 +20,7 @@
 # include "config.h"
 
 # include  <algorithm>
+# include  <map>
 # include  <vector>
 # include  <cstdlib>
 # include  "netlist.h"
@@ -39,8 +40,16 @@ using namespace std;
 
 struct cprop_functor  : public functor_t {
 
+      cprop_functor();
+
       unsigned count;
 
+	// Totals for the report, by kind of optimization.
+      unsigned count_const;
+      unsigned count_simplify;
+      unsigned count_chain;
+      unsigned count_dangling;
+
       virtual void signal(Design*des, NetNet*obj);
       virtual void lpm_add_sub(Design*des, NetAddSub*obj);
       virtual void lpm_compare(Design*des, const NetCompare*obj);
@@ -49,16 +58,233 @@ struct cprop_functor  : public functor_t {
       virtual void lpm_logic(Design*des, NetLogic*obj);
       virtual void lpm_mux(Design*des, NetMux*obj);
       virtual void lpm_part_select(Design*des, NetPartSelect*obj);
+      virtual void lpm_ureduce(Design*des, NetUReduce*obj);
 
       void lpm_compare_eq_(Design*des, const NetCompare*obj);
+
+    private:
+      void replace_with_const_(Design*des, NetNode*obj, Link&out,
+			       const verinum&val);
+      bool logic_const_(Design*des, NetLogic*obj);
+      bool logic_simplify_(Design*des, NetLogic*obj);
+      bool logic_chain_(Design*des, NetLogic*obj);
+      bool logic_dangling_(NetLogic*obj);
  };
 
+cprop_functor::cprop_functor()
+: count(0), count_const(0), count_simplify(0), count_chain(0),
+  count_dangling(0)
+{
+}
+
+/*
+ * A delay expression is zero if it is missing or a constant 0.
+ */
+static bool is_zero_delay(const NetExpr*expr)
+{
+      if (expr == 0)
+	    return true;
+      const NetEConst*ce = dynamic_cast<const NetEConst*>(expr);
+      return ce && ce->value().is_zero();
+}
+
+static bool is_zero_delay(const NetObj*obj)
+{
+      return is_zero_delay(obj->rise_time())
+	    && is_zero_delay(obj->fall_time())
+	    && is_zero_delay(obj->decay_time());
+}
+
+/*
+ * Get the constant value that drives the input pin, if there is
+ * one. Undriven inputs are not taken to be constant, since they may
+ * be driven from outside (e.g. by VPI) later.
+ */
+static bool input_constant(const Link&pin, unsigned wid, verinum&val)
+{
+      if (! pin.is_linked())
+	    return false;
+
+      const Nexus*nex = pin.nexus();
+      if (! nex->drivers_constant())
+	    return false;
+      if (! nex->drivers_present())
+	    return false;
+
+      val = nex->driven_vector();
+      return val.len() == wid;
+}
+
+/*
+ * Return true if all the nets connected to the nexus are compiler
+ * generated and not otherwise referenced, so that nothing outside
+ * the netlist (force, procedural assign, VPI) can observe or change
+ * the value of the nexus. The skip link is not looked at.
+ */
+static bool nexus_is_internal(const Nexus*nex, const Link*skip)
+{
+      for (const Link*cur = nex->first_nlink() ; cur ; cur = cur->next_nlink()) {
+	    if (cur == skip)
+		  continue;
+
+	    const NetPins*obj = cur->get_obj();
+	    const NetNet*sig = dynamic_cast<const NetNet*>(obj);
+	    if (sig == 0)
+		  continue;
+
+	    if (! sig->local_flag())
+		  return false;
+	    if (sig->peek_lref() > 0)
+		  return false;
+
+	    switch (sig->type()) {
+		case NetNet::IMPLICIT:
+		case NetNet::WIRE:
+		case NetNet::TRI:
+		case NetNet::UNRESOLVED_WIRE:
+		  break;
+		default:
+		  return false;
+	    }
+      }
+
+      return true;
+}
+
+/*
+ * If the only driver of the nexus is a 1-bit-per-bit logic gate with
+ * no delay, and the nexus is internal, return that gate.
+ */
+static NetLogic* sole_logic_driver(const Nexus*nex)
+{
+      NetLogic*drv = 0;
+      for (const Link*cur = nex->first_nlink() ; cur ; cur = cur->next_nlink()) {
+	    if (cur->get_dir() != Link::OUTPUT)
+		  continue;
+	    if (drv)
+		  return 0;
+	    drv = dynamic_cast<NetLogic*>(const_cast<NetPins*>(cur->get_obj()));
+	    if (drv == 0)
+		  return 0;
+	    if (cur->get_pin() != 0)
+		  return 0;
+      }
+
+      if (drv == 0 || ! is_zero_delay(drv))
+	    return 0;
+      if (! nexus_is_internal(nex, 0))
+	    return 0;
+
+      return drv;
+}
+
+/*
+ * These are the gates that treat z inputs as x and drive a value
+ * that is a simple bitwise function of the inputs.
+ */
+static bool is_simple_logic(const NetLogic*obj)
+{
+      switch (obj->type()) {
+	  case NetLogic::AND:
+	  case NetLogic::NAND:
+	  case NetLogic::OR:
+	  case NetLogic::NOR:
+	  case NetLogic::XOR:
+	  case NetLogic::XNOR:
+	    return obj->pin_count() >= 3;
+	  case NetLogic::BUF:
+	  case NetLogic::NOT:
+	    return obj->pin_count() == 2;
+	  default:
+	    return false;
+      }
+}
+
+static bool is_commutative(const NetLogic*obj)
+{
+      return obj->type() != NetLogic::BUF && obj->type() != NetLogic::NOT;
+}
+
+static bool all_bits_are(const verinum&val, verinum::V bit)
+{
+      for (unsigned idx = 0 ; idx < val.len() ; idx += 1) {
+	    if (val.get(idx) != bit)
+		  return false;
+      }
+      return true;
+}
+
+static verinum::V eval_logic_bit(NetLogic::TYPE type,
+				 const std::vector<verinum>&in, unsigned bit)
+{
+      verinum::V val = in[0].get(bit);
+      switch (type) {
+	  case NetLogic::AND:
+	  case NetLogic::NAND:
+	    for (size_t idx = 1 ; idx < in.size() ; idx += 1)
+		  val = val & in[idx].get(bit);
+	    break;
+	  case NetLogic::OR:
+	  case NetLogic::NOR:
+	    for (size_t idx = 1 ; idx < in.size() ; idx += 1)
+		  val = val | in[idx].get(bit);
+	    break;
+	  case NetLogic::XOR:
+	  case NetLogic::XNOR:
+	    for (size_t idx = 1 ; idx < in.size() ; idx += 1)
+		  val = val ^ in[idx].get(bit);
+	    break;
+	  default:
+	    break;
+      }
+
+      switch (type) {
+	  case NetLogic::NAND:
+	  case NetLogic::NOR:
+	  case NetLogic::XNOR:
+	  case NetLogic::NOT:
+	    return ~val;
+	  default:
+	    return bit4_z2x(val);
+      }
+}
+
 void cprop_functor::signal(Design*, NetNet*)
 {
 }
 
-void cprop_functor::lpm_add_sub(Design*, NetAddSub*)
+/*
+ * Replace an adder/subtractor that has constant inputs with the
+ * constant result.
+ */
+void cprop_functor::lpm_add_sub(Design*des, NetAddSub*obj)
 {
+      if (obj->pin_Cout().is_linked())
+	    return;
+      if (! is_zero_delay(obj))
+	    return;
+
+      verinum aval, bval;
+      if (! input_constant(obj->pin_DataA(), obj->width(), aval))
+	    return;
+      if (! input_constant(obj->pin_DataB(), obj->width(), bval))
+	    return;
+
+      aval.has_sign(false);
+      bval.has_sign(false);
+      verinum result;
+      if (obj->attribute(perm_string::literal("LPM_Direction")) == verinum("SUB"))
+	    result = aval - bval;
+      else
+	    result = aval + bval;
+      result = cast_to_width(result, obj->width());
+
+      if (debug_optimizer)
+	    cerr << obj->get_fileline() << ": cprop_functor::lpm_add_sub: "
+		 << "Replace NetAddSub with " << result << "." << endl;
+
+      replace_with_const_(des, obj, obj->pin_Result(), result);
+      count_const += 1;
 }
 
 void cprop_functor::lpm_compare(Design*des, const NetCompare*obj)
@@ -140,34 +366,296 @@ void cprop_functor::lpm_ff(Design*, NetFF*obj)
       }
 }
 
-void cprop_functor::lpm_logic(Design*, NetLogic*)
+/*
+ * Replace the node with a constant that drives its output with the
+ * same strength. The node is deleted.
+ */
+void cprop_functor::replace_with_const_(Design*des, NetNode*obj, Link&out,
+					const verinum&val)
+{
+      NetConst*result_obj = new NetConst(obj->scope(), obj->name(), val);
+      result_obj->set_line(*obj);
+      result_obj->pin(0).drive0(out.drive0());
+      result_obj->pin(0).drive1(out.drive1());
+      des->add_node(result_obj);
+      connect(out, result_obj->pin(0));
+      delete obj;
+      count += 1;
+}
+
+void cprop_functor::lpm_logic(Design*des, NetLogic*obj)
+{
+      if (! is_simple_logic(obj))
+	    return;
+      if (! is_zero_delay(obj))
+	    return;
+
+      if (logic_dangling_(obj))
+	    return;
+      if (logic_const_(des, obj))
+	    return;
+      if (logic_simplify_(des, obj))
+	    return;
+      logic_chain_(des, obj);
+}
+
+/*
+ * Remove gates that drive nothing but unreferenced compiler
+ * generated nets. These are typically left behind by the other
+ * optimizations here.
+ */
+bool cprop_functor::logic_dangling_(NetLogic*obj)
+{
+      const Link&out = obj->pin(0);
+      if (out.is_linked()) {
+	    const Nexus*nex = out.nexus();
+	    for (const Link*cur = nex->first_nlink() ; cur ; cur = cur->next_nlink()) {
+		  if (cur == &out)
+			continue;
+		  const NetNet*sig = dynamic_cast<const NetNet*>(cur->get_obj());
+		  if (sig == 0 || sig->peek_eref() > 0)
+			return false;
+	    }
+	    if (! nexus_is_internal(nex, &out))
+		  return false;
+      }
+
+      if (debug_optimizer)
+	    cerr << obj->get_fileline() << ": cprop_functor::lpm_logic: "
+		 << "Remove gate " << obj->name()
+		 << " that drives nothing." << endl;
+
+      delete obj;
+      count += 1;
+      count_dangling += 1;
+      return true;
+}
+
+/*
+ * Evaluate gates whose inputs are all constant, or whose output is
+ * fixed by a constant controlling input (e.g. a 0 into an AND).
+ */
+bool cprop_functor::logic_const_(Design*des, NetLogic*obj)
+{
+      unsigned wid = obj->width();
+      std::vector<verinum> in;
+      verinum::V ctrl = verinum::Vx;
+      switch (obj->type()) {
+	  case NetLogic::AND:
+	  case NetLogic::NAND:
+	    ctrl = verinum::V0;
+	    break;
+	  case NetLogic::OR:
+	  case NetLogic::NOR:
+	    ctrl = verinum::V1;
+	    break;
+	  default:
+	    break;
+      }
+
+      bool controlled = false;
+      for (unsigned idx = 1 ; idx < obj->pin_count() ; idx += 1) {
+	    verinum tmp;
+	    if (! input_constant(obj->pin(idx), wid, tmp)) {
+		  if (ctrl == verinum::Vx)
+			return false;
+		  continue;
+	    }
+	    if (ctrl != verinum::Vx && all_bits_are(tmp, ctrl)) {
+		  in.clear();
+		  in.push_back(tmp);
+		  controlled = true;
+		  break;
+	    }
+	    in.push_back(tmp);
+      }
+
+      if (!controlled && in.size()+1 != obj->pin_count())
+	    return false;
+
+      verinum result (verinum::Vx, wid);
+      for (unsigned bit = 0 ; bit < wid ; bit += 1)
+	    result.set(bit, eval_logic_bit(obj->type(), in, bit));
+
+      if (debug_optimizer)
+	    cerr << obj->get_fileline() << ": cprop_functor::lpm_logic: "
+		 << "Replace gate " << obj->name()
+		 << " with constant " << result << "." << endl;
+
+      replace_with_const_(des, obj, obj->pin(0), result);
+      count_const += 1;
+      return true;
+}
+
+/*
+ * Drop constant inputs that do not affect the result (a 1 into an
+ * AND, a 0 into an OR or XOR). A gate that is left with one input is
+ * replaced with a BUF or NOT.
+ */
+bool cprop_functor::logic_simplify_(Design*des, NetLogic*obj)
+{
+      verinum::V ident;
+      bool invert = false;
+      switch (obj->type()) {
+	  case NetLogic::NAND:
+	    invert = true;
+	    // fallthrough
+	  case NetLogic::AND:
+	    ident = verinum::V1;
+	    break;
+	  case NetLogic::NOR:
+	  case NetLogic::XNOR:
+	    invert = true;
+	    // fallthrough
+	  case NetLogic::OR:
+	  case NetLogic::XOR:
+	    ident = verinum::V0;
+	    break;
+	  default:
+	    return false;
+      }
+
+      unsigned wid = obj->width();
+      std::vector<unsigned> keep;
+      for (unsigned idx = 1 ; idx < obj->pin_count() ; idx += 1) {
+	    verinum tmp;
+	    if (input_constant(obj->pin(idx), wid, tmp)
+		&& all_bits_are(tmp, ident))
+		  continue;
+	    keep.push_back(idx);
+      }
+
+      if (keep.size()+1 == obj->pin_count() || keep.empty())
+	    return false;
+
+      NetLogic::TYPE type = obj->type();
+      if (keep.size() == 1)
+	    type = invert? NetLogic::NOT : NetLogic::BUF;
+
+      NetLogic*tmp = new NetLogic(obj->scope(), obj->name(), keep.size()+1,
+				  type, wid, obj->is_cassign());
+      tmp->set_line(*obj);
+      tmp->pin(0).drive0(obj->pin(0).drive0());
+      tmp->pin(0).drive1(obj->pin(0).drive1());
+      connect(tmp->pin(0), obj->pin(0));
+      for (size_t idx = 0 ; idx < keep.size() ; idx += 1)
+	    connect(tmp->pin(idx+1), obj->pin(keep[idx]));
+
+      if (debug_optimizer)
+	    cerr << obj->get_fileline() << ": cprop_functor::lpm_logic: "
+		 << "Remove " << (obj->pin_count()-1-keep.size())
+		 << " constant inputs from gate " << obj->name() << "." << endl;
+
+      des->add_node(tmp);
+      delete obj;
+      count += 1;
+      count_simplify += 1;
+      return true;
+}
+
+/*
+ * Look through BUF and NOT gates that drive inputs of this gate. A
+ * BUF in front of a gate does nothing, since the gate already treats
+ * z as x, and the gate can read the input of the BUF instead. Pairs
+ * of inversions cancel the same way. The skipped gates are removed
+ * later if nothing else reads them.
+ */
+bool cprop_functor::logic_chain_(Design*des, NetLogic*obj)
 {
+      bool unary = obj->pin_count() == 2;
+      unsigned wid = obj->width();
+
+      for (unsigned idx = 1 ; idx < obj->pin_count() ; idx += 1) {
+	    if (! obj->pin(idx).is_linked())
+		  continue;
+
+	    NetLogic*drv = sole_logic_driver(obj->pin(idx).nexus());
+	    if (drv == 0 || drv == obj || drv->width() != wid)
+		  continue;
+	    if (drv->pin_count() != 2)
+		  continue;
+	      // Leave loops of gates that feed themselves alone.
+	    if (drv->pin(1).is_linked(drv->pin(0)))
+		  continue;
+
+	    if (drv->type() == NetLogic::BUF) {
+		  if (debug_optimizer)
+			cerr << obj->get_fileline() << ": cprop_functor::lpm_logic: "
+			     << "Gate " << obj->name() << " skips BUF "
+			     << drv->name() << "." << endl;
+
+		  obj->pin(idx).unlink();
+		  connect(obj->pin(idx), drv->pin(1));
+		  count += 1;
+		  count_chain += 1;
+		  return true;
+	    }
+
+	      // Only a unary gate can absorb an inverter. NOT(NOT(x))
+	      // becomes BUF(x) and BUF(NOT(x)) becomes NOT(x).
+	    if (drv->type() != NetLogic::NOT || !unary)
+		  continue;
+
+	    NetLogic::TYPE type = obj->type() == NetLogic::NOT
+		  ? NetLogic::BUF : NetLogic::NOT;
+
+	    if (debug_optimizer)
+		  cerr << obj->get_fileline() << ": cprop_functor::lpm_logic: "
+		       << "Gate " << obj->name() << " absorbs NOT "
+		       << drv->name() << "." << endl;
+
+	    NetLogic*tmp = new NetLogic(obj->scope(), obj->name(), 2,
+					type, wid, obj->is_cassign());
+	    tmp->set_line(*obj);
+	    tmp->pin(0).drive0(obj->pin(0).drive0());
+	    tmp->pin(0).drive1(obj->pin(0).drive1());
+	    connect(tmp->pin(0), obj->pin(0));
+	    connect(tmp->pin(1), drv->pin(1));
+	    des->add_node(tmp);
+	    delete obj;
+	    count += 1;
+	    count_chain += 1;
+	    return true;
+      }
+
+      return false;
 }
 
 /*
- * This detects the case where the mux selects between a value and
- * Vz. In this case, replace the device with a mos with the sel
- * input used to enable the output.
+ * If the select input of the mux is a defined constant, or all the
+ * data inputs are the same, the mux passes a single input through to
+ * the output. Replace the device with a BUFZ from that input.
  */
 void cprop_functor::lpm_mux(Design*des, NetMux*obj)
 {
-      if (obj->size() != 2)
-	    return;
-      if (obj->sel_width() != 1)
-	    return;
+      unsigned sel_val = 0;
+      bool same_data = obj->size() >= 2;
+      for (unsigned idx = 1 ; idx < obj->size() ; idx += 1) {
+	    if (! obj->pin_Data(0).is_linked(obj->pin_Data(idx))) {
+		  same_data = false;
+		  break;
+	    }
+      }
 
-      Nexus*sel_nex = obj->pin_Sel().nexus();
+      if (! same_data) {
+	    Nexus*sel_nex = obj->pin_Sel().nexus();
 
-	/* If the select input is constant, then replace with a BUFZ */
+	      // If the select is not constant, there is nothing we can do.
+	    if (! sel_nex->drivers_constant())
+		  return;
 
-	// If the select is not constant, there is nothing we can do.
-      if (! sel_nex->drivers_constant())
-	    return;
+	      // If the constant select has 'bz or 'bx bits, then give up.
+	    verinum sel_vec = sel_nex->driven_vector();
+	    if (sel_vec.len() != obj->sel_width() || ! sel_vec.is_defined())
+		  return;
+	    if (sel_vec.len() > 8*sizeof(unsigned long))
+		  return;
 
-	// If the constant select is 'bz or 'bx, then give up.
-      verinum::V sel_val = sel_nex->driven_value();
-      if (sel_val == verinum::Vz || sel_val == verinum::Vx)
-	    return;
+	    unsigned long tmp = sel_vec.as_ulong();
+	    if (tmp >= obj->size())
+		  return;
+	    sel_val = tmp;
+      }
 
 	// The Select input must be a defined constant value, so we
 	// can replace the device with a BUFZ.
@@ -175,23 +663,25 @@ void cprop_functor::lpm_mux(Design*des, NetMux*obj)
       NetBUFZ*tmp = new NetBUFZ(obj->scope(), obj->name(), obj->width(), true);
       tmp->set_line(*obj);
 
-      if (debug_optimizer)
-	    cerr << obj->get_fileline() << ": debug: "
-		 << "Replace binary MUX with constant select=" << sel_val
-		 << " with a BUFZ to the selected input." << endl;
+      if (debug_optimizer) {
+	    cerr << obj->get_fileline() << ": debug: ";
+	    if (same_data)
+		  cerr << "Replace MUX with identical data inputs";
+	    else
+		  cerr << "Replace MUX with constant select=" << sel_val;
+	    cerr << " with a BUFZ to the selected input." << endl;
+      }
 
       tmp->rise_time(obj->rise_time());
       tmp->fall_time(obj->fall_time());
       tmp->decay_time(obj->decay_time());
 
       connect(tmp->pin(0), obj->pin_Result());
-      if (sel_val == verinum::V1)
-	    connect(tmp->pin(1), obj->pin_Data(1));
-      else
-	    connect(tmp->pin(1), obj->pin_Data(0));
+      connect(tmp->pin(1), obj->pin_Data(sel_val));
       delete obj;
       des->add_node(tmp);
       count += 1;
+      count_simplify += 1;
 }
 
 static bool compare_base(NetPartSelect*a, NetPartSelect*b)
@@ -330,6 +820,185 @@ void cprop_functor::lpm_part_select(Design*des, NetPartSelect*obj)
       count += 1;
 }
 
+/*
+ * Replace a reduction of a constant with the constant result.
+ */
+void cprop_functor::lpm_ureduce(Design*des, NetUReduce*obj)
+{
+      if (! is_zero_delay(obj))
+	    return;
+
+      verinum val;
+      if (! input_constant(obj->pin(1), obj->width(), val))
+	    return;
+      if (val.len() == 0)
+	    return;
+
+      verinum::V res = val.get(0);
+      for (unsigned idx = 1 ; idx < val.len() ; idx += 1) {
+	    switch (obj->type()) {
+		case NetUReduce::AND:
+		case NetUReduce::NAND:
+		  res = res & val.get(idx);
+		  break;
+		case NetUReduce::OR:
+		case NetUReduce::NOR:
+		  res = res | val.get(idx);
+		  break;
+		case NetUReduce::XOR:
+		case NetUReduce::XNOR:
+		  res = res ^ val.get(idx);
+		  break;
+		case NetUReduce::NONE:
+		  return;
+	    }
+      }
+
+      switch (obj->type()) {
+	  case NetUReduce::NAND:
+	  case NetUReduce::NOR:
+	  case NetUReduce::XNOR:
+	    res = ~res;
+	    break;
+	  case NetUReduce::NONE:
+	    return;
+	  default:
+	    res = bit4_z2x(res);
+	    break;
+      }
+
+      if (debug_optimizer)
+	    cerr << obj->get_fileline() << ": cprop_functor::lpm_ureduce: "
+		 << "Replace reduction with constant " << res << "." << endl;
+
+      replace_with_const_(des, obj, obj->pin(0), verinum(res, 1));
+      count_const += 1;
+}
+
+/*
+ * Structural hashing: two zero-delay gates of the same type and
+ * width with the same inputs drive the same value, so the second
+ * can be removed and its output joined to the output of the first.
+ * This is only done when both outputs drive nothing but compiler
+ * generated nets, so that no signal that can be forced or seen
+ * through VPI changes.
+ *
+ * The table is rebuilt on each pass. Merging changes the nexus of
+ * the readers of the removed gate, so entries made earlier in the
+ * pass may go stale. Stale entries never match (the functor does
+ * not create nexus objects, so the addresses are not reused), and
+ * the next pass picks up the merges they would have found.
+ */
+struct cprop_hash_key_s {
+      int kind;
+      unsigned width;
+      std::vector<const Nexus*> inputs;
+
+      bool operator < (const cprop_hash_key_s&that) const
+      {
+	    if (kind != that.kind)
+		  return kind < that.kind;
+	    if (width != that.width)
+		  return width < that.width;
+	    return inputs < that.inputs;
+      }
+};
+
+struct cprop_hash_functor  : public functor_t {
+
+      cprop_hash_functor() : count(0) { }
+
+      unsigned count;
+
+      virtual void lpm_logic(Design*des, NetLogic*obj);
+      virtual void lpm_ureduce(Design*des, NetUReduce*obj);
+
+    private:
+      void merge_(NetNode*obj, cprop_hash_key_s&key, bool commutative);
+
+      std::map<cprop_hash_key_s,NetNode*> table_;
+};
+
+/*
+ * The output of a node can be merged if the node is its only driver
+ * and the nexus is internal.
+ */
+static bool output_mergeable(NetNode*obj)
+{
+      const Link&out = obj->pin(0);
+      if (! out.is_linked())
+	    return false;
+      if (obj->pin(0).drive0() != IVL_DR_STRONG
+	  || obj->pin(0).drive1() != IVL_DR_STRONG)
+	    return false;
+      if (! is_zero_delay(obj))
+	    return false;
+
+      const Nexus*nex = out.nexus();
+      for (const Link*cur = nex->first_nlink() ; cur ; cur = cur->next_nlink()) {
+	    if (cur != &out && cur->get_dir() == Link::OUTPUT)
+		  return false;
+      }
+
+      return nexus_is_internal(nex, &out);
+}
+
+void cprop_hash_functor::merge_(NetNode*obj, cprop_hash_key_s&key,
+				bool commutative)
+{
+      for (unsigned idx = 1 ; idx < obj->pin_count() ; idx += 1) {
+	    if (! obj->pin(idx).is_linked())
+		  return;
+	    key.inputs.push_back(obj->pin(idx).nexus());
+      }
+
+	// The order of the inputs to an AND, OR, etc. does not
+	// matter, so look those up in a canonical order.
+      if (commutative)
+	    sort(key.inputs.begin(), key.inputs.end());
+
+      if (! output_mergeable(obj))
+	    return;
+
+      std::map<cprop_hash_key_s,NetNode*>::iterator cur = table_.find(key);
+      if (cur == table_.end()) {
+	    table_[key] = obj;
+	    return;
+      }
+
+      NetNode*keep = cur->second;
+
+      if (debug_optimizer)
+	    cerr << obj->get_fileline() << ": cprop_hash_functor: "
+		 << "Merge " << obj->name() << " into identical node "
+		 << keep->name() << "." << endl;
+
+      connect(keep->pin(0), obj->pin(0));
+      delete obj;
+      count += 1;
+}
+
+void cprop_hash_functor::lpm_logic(Design*, NetLogic*obj)
+{
+      if (! is_simple_logic(obj))
+	    return;
+
+      cprop_hash_key_s key;
+      key.kind = 2*obj->type() + (obj->is_cassign()? 1 : 0);
+      key.width = obj->width();
+
+      merge_(obj, key, is_commutative(obj));
+}
+
+void cprop_hash_functor::lpm_ureduce(Design*, NetUReduce*obj)
+{
+      cprop_hash_key_s key;
+      key.kind = -1 - (int)obj->type();
+      key.width = obj->width();
+
+      merge_(obj, key, false);
+}
+
 /*
  * This functor looks to see if the constant is connected to nothing
  * but signals. If that is the case, delete the dangling constant and
@@ -429,19 +1098,33 @@ void cprop_dc_functor::lpm_const(Design*, NetConst*obj)
 
 void cprop(Design*des)
 {
-	// Continually propagate constants until a scan finds nothing
-	// to do.
+	// Continually propagate constants and merge identical nodes
+	// until a scan finds nothing to do.
       cprop_functor prop;
+      unsigned count_merged = 0;
+      unsigned count;
       do {
 	    prop.count = 0;
 	    des->functor(&prop);
+
+	    cprop_hash_functor hash;
+	    des->functor(&hash);
+	    count_merged += hash.count;
+
+	    count = prop.count + hash.count;
 	    if (verbose_flag) {
 		  cout << " ... Iteration detected "
-		       << prop.count << " optimizations." << endl << flush;
+		       << count << " optimizations." << endl << flush;
 	    }
-      } while (prop.count > 0);
+      } while (count > 0);
 
       if (verbose_flag) {
+	    cout << " ... Replaced " << prop.count_const
+		 << " nodes with constants, simplified " << prop.count_simplify
+		 << ", shortened " << prop.count_chain << " BUF/NOT chains" << endl
+		 << " ... Removed " << prop.count_dangling
+		 << " dangling gates, merged " << count_merged
+		 << " identical nodes" << endl << flush;
 	    cout << " ... Look for dangling constants" << endl << flush;
       }
       cprop_dc_functor dc;
@@ -51,6 +51,7 @@ const char HELP[] =
 #define MAXSIZE 4096
 
 #include <stdio.h>
+#include <stdarg.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <string.h>
@@ -353,33 +354,173 @@ static int t_version_only(void)
       return 0;
 }
 
-static void build_preprocess_command(int e_flag)
+/*
+ * The preprocessor and ivl command lines are collected as argument
+ * lists. Where fork() is available the commands are run directly
+ * from these lists, with the preprocessor output piped into ivl and
+ * no shell in between. Otherwise the lists are joined into a shell
+ * command line and passed to system().
+ */
+struct command_s {
+      char**argv;
+      unsigned argc;
+};
+
+static void command_add(struct command_s*cmd, const char*fmt, ...)
+{
+      va_list ap;
+      va_start(ap, fmt);
+      vsnprintf(tmp, sizeof tmp, fmt, ap);
+      va_end(ap);
+
+      cmd->argv = realloc(cmd->argv, (cmd->argc+2) * sizeof(char*));
+      cmd->argv[cmd->argc++] = strdup(tmp);
+      cmd->argv[cmd->argc] = 0;
+}
+
+static void command_clear(struct command_s*cmd)
+{
+      unsigned idx;
+      for (idx = 0 ; idx < cmd->argc ; idx += 1)
+	    free(cmd->argv[idx]);
+      free(cmd->argv);
+      cmd->argv = 0;
+      cmd->argc = 0;
+}
+
+/*
+ * Append the command to the shell command line in str. Arguments that
+ * contain anything but the most ordinary characters are quoted.
+ */
+static char*command_string(char*str, const struct command_s*cmd)
+{
+      unsigned idx;
+      size_t nstr = str? strlen(str) : 0;
+
+      for (idx = 0 ; idx < cmd->argc ; idx += 1) {
+	    const char*arg = cmd->argv[idx];
+	    int quote = arg[0] == 0
+		  || arg[strspn(arg, "abcdefghijklmnopqrstuvwxyz"
+				"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+				"0123456789_-+=.,:/")] != 0;
+	    size_t narg = strlen(arg) + 4;
+
+	    str = realloc(str, nstr + narg);
+	    nstr += snprintf(str+nstr, narg, "%s%s%s%s", nstr? " " : "",
+			     quote? "\"" : "", arg, quote? "\"" : "");
+      }
+
+      return str;
+}
+
+static void build_preprocess_command(struct command_s*cmd, int e_flag)
+{
+      command_add(cmd, "%s%civlpp", ivlpp_dir, sep);
+      if (verbose_flag)
+	    command_add(cmd, "-v");
+      if (!e_flag)
+	    command_add(cmd, "-L");
+      if (strchr(warning_flags, 'r'))
+	    command_add(cmd, "-Wredef-all");
+      else if (strchr(warning_flags, 'R'))
+	    command_add(cmd, "-Wredef-chg");
+      command_add(cmd, "-F%s", defines_path);
+      command_add(cmd, "-f%s", source_path);
+      command_add(cmd, "-p%s", compiled_defines_path);
+}
+
+#ifndef __MINGW32__
+/*
+ * Start the command with the given standard input and output, and
+ * return its process id. If the command cannot be executed, the child
+ * exits with status 127 like the shell does.
+ */
+static pid_t command_start(const struct command_s*cmd, int fd_in, int fd_out,
+			   int fd_close)
+{
+      pid_t pid = fork();
+      if (pid != 0)
+	    return pid;
+
+      if (fd_in >= 0) {
+	    dup2(fd_in, 0);
+	    close(fd_in);
+      }
+      if (fd_out >= 0) {
+	    dup2(fd_out, 1);
+	    close(fd_out);
+      }
+      if (fd_close >= 0)
+	    close(fd_close);
+
+      execv(cmd->argv[0], cmd->argv);
+      fprintf(stderr, "%s: %s\n", cmd->argv[0], strerror(errno));
+      _exit(127);
+}
+
+/*
+ * Run the pp command (if there is one) piped into the cc command, with
+ * the output of the cc command optionally written to out_path. Return
+ * the wait status of the cc command, as system() would for the same
+ * shell pipeline.
+ */
+static int run_pipeline(const struct command_s*pp, const struct command_s*cc,
+			const char*out_path)
 {
-      snprintf(tmp, sizeof tmp, "%s%civlpp%s%s%s -F\"%s\" -f\"%s\" -p\"%s\"%s",
-	       ivlpp_dir, sep,
-               verbose_flag ? " -v" : "",
-	       e_flag ? "" : " -L",
-               strchr(warning_flags, 'r') ? " -Wredef-all" :
-               strchr(warning_flags, 'R') ? " -Wredef-chg" : "",
-               defines_path, source_path,
-	       compiled_defines_path,
-	       e_flag ? "" : " |");
+      int fd_pipe[2] = { -1, -1 };
+      int fd_out = -1;
+      pid_t pp_pid = -1, cc_pid;
+      int rc = -1;
+
+      fflush(0);
+
+      if (out_path) {
+	    fd_out = open(out_path, O_WRONLY|O_CREAT|O_TRUNC, 0666);
+	    if (fd_out < 0) {
+		  fprintf(stderr, "%s: %s\n", out_path, strerror(errno));
+		  return 1 << 8;
+	    }
+      }
+
+      if (pp) {
+	    if (pipe(fd_pipe) < 0) {
+		  perror("pipe");
+		  if (fd_out >= 0)
+			close(fd_out);
+		  return -1;
+	    }
+	    pp_pid = command_start(pp, -1, fd_pipe[1], fd_pipe[0]);
+	    close(fd_pipe[1]);
+      }
+
+      cc_pid = command_start(cc, fd_pipe[0], fd_out, -1);
+      if (fd_pipe[0] >= 0)
+	    close(fd_pipe[0]);
+      if (fd_out >= 0)
+	    close(fd_out);
+
+      if (pp_pid > 0)
+	    waitpid(pp_pid, 0, 0);
+      if (cc_pid < 0 || waitpid(cc_pid, &rc, 0) < 0)
+	    return -1;
+
+      return rc;
 }
+#endif
 
 static int t_preprocess_only(void)
 {
       int rc;
       char*cmd;
-      unsigned ncmd;
-
-      build_preprocess_command(1);
+      struct command_s pp = { 0, 0 };
+      const char*out_path = strcmp(opath,"-") != 0? opath : 0;
 
-      ncmd = strlen(tmp);
-      cmd = malloc(ncmd+1);
-      strcpy(cmd, tmp);
+      build_preprocess_command(&pp, 1);
 
-      if (strcmp(opath,"-") != 0) {
-	    snprintf(tmp, sizeof tmp, " > \"%s\"", opath);
+      cmd = command_string(0, &pp);
+      if (out_path) {
+	    size_t ncmd = strlen(cmd);
+	    snprintf(tmp, sizeof tmp, " > \"%s\"", out_path);
 	    cmd = realloc(cmd, ncmd+strlen(tmp)+1);
 	    strcpy(cmd+ncmd, tmp);
       }
@@ -387,7 +528,12 @@ static int t_preprocess_only(void)
       if (verbose_flag)
 	    printf("preprocess: %s\n", cmd);
 
+#ifdef __MINGW32__
       rc = system(cmd);
+#else
+      rc = run_pipeline(0, &pp, out_path);
+#endif
+      command_clear(&pp);
       remove(source_path);
       free(source_path);
 
@@ -423,72 +569,53 @@ static int t_preprocess_only(void)
  */
 static int t_compile(void)
 {
-      unsigned rc;
+      int rc;
+      char*cmd = 0;
+      struct command_s pp = { 0, 0 };
+      struct command_s cc = { 0, 0 };
 
 	/* Start by building the preprocess command line, if required.
 	   This pipes into the main ivl command. */
       if (!separate_compilation_flag)
-	    build_preprocess_command(0);
-      else
-	    strcpy(tmp, "");
-
-      size_t ncmd = strlen(tmp);
-      char*cmd = malloc(ncmd + 1);
-      strcpy(cmd, tmp);
+	    build_preprocess_command(&pp, 0);
 
 #ifndef __MINGW32__
       int rtn;
 #endif
 
 	/* Build the ivl command. */
-      snprintf(tmp, sizeof tmp, "%s%civl", base, sep);
-      rc = strlen(tmp);
-      cmd = realloc(cmd, ncmd+rc+1);
-      strcpy(cmd+ncmd, tmp);
-      ncmd += rc;
-
-      if (verbose_flag) {
-	    const char*vv = " -v";
-	    rc = strlen(vv);
-	    cmd = realloc(cmd, ncmd+rc+1);
-	    strcpy(cmd+ncmd, vv);
-	    ncmd += rc;
+      command_add(&cc, "%s%civl", base, sep);
+      if (verbose_flag)
+	    command_add(&cc, "-v");
+      if (npath != 0)
+	    command_add(&cc, "-N%s", npath);
+      command_add(&cc, "-C%s", iconfig_path);
+      command_add(&cc, "-C%s", iconfig_common_path);
+      if (separate_compilation_flag) {
+	    command_add(&cc, "-F%s", source_path);
+      } else {
+	    command_add(&cc, "--");
+	    command_add(&cc, "-");
       }
 
-      if (npath != 0) {
-	    snprintf(tmp, sizeof tmp, " -N\"%s\"", npath);
-	    rc = strlen(tmp);
-	    cmd = realloc(cmd, ncmd+rc+1);
-	    strcpy(cmd+ncmd, tmp);
-	    ncmd += rc;
+      if (pp.argc > 0) {
+	    cmd = command_string(cmd, &pp);
+	    cmd = realloc(cmd, strlen(cmd) + 3);
+	    strcat(cmd, " |");
       }
-
-      snprintf(tmp, sizeof tmp, " -C\"%s\"", iconfig_path);
-      rc = strlen(tmp);
-      cmd = realloc(cmd, ncmd+rc+1);
-      strcpy(cmd+ncmd, tmp);
-      ncmd += rc;
-
-      snprintf(tmp, sizeof tmp, " -C\"%s\"", iconfig_common_path);
-      rc = strlen(tmp);
-      cmd = realloc(cmd, ncmd+rc+1);
-      strcpy(cmd+ncmd, tmp);
-      ncmd += rc;
-
-      if (separate_compilation_flag)
-	    snprintf(tmp, sizeof tmp, " -F\"%s\"", source_path);
-      else
-	    snprintf(tmp, sizeof tmp, " -- -");
-      rc = strlen(tmp);
-      cmd = realloc(cmd, ncmd+rc+1);
-      strcpy(cmd+ncmd, tmp);
-
+      cmd = command_string(cmd, &cc);
 
       if (verbose_flag)
 	    printf("translate: %s\n", cmd);
 
 
+#ifdef __MINGW32__
       rc = system(cmd);
+#else
+      rc = run_pipeline(pp.argc > 0? &pp : 0, &cc, 0);
+#endif
+      command_clear(&pp);
+      command_clear(&cc);
       if ( ! getenv("IVERILOG_ICONFIG")) {
 	    remove(source_path);
 	    free(source_path);
@@ -505,7 +632,7 @@ static int t_compile(void)
 #else
       rtn = 0;
       if (rc != 0) {
-	    if (rc == 127) {
+	    if (WIFEXITED(rc) && WEXITSTATUS(rc) == 127) {
 		  fprintf(stderr, "Failed to execute: %s\n", cmd);
 		  rtn = 1;
 	    } else if (WIFEXITED(rc)) {
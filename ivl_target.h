@@ -586,6 +586,15 @@ extern int ivl_path_source_negedge(ivl_delaypath_t obj);
  *    caller a pointer to an ivl_scope_t array, and the size of the
  *    array.
  *
+ * ivl_design_scopes
+ *    This function returns to the caller a pointer to an array of all
+ *    the scopes of the design, and the size of the array. The scopes
+ *    are in pre-order: each root scope (in the order of
+ *    ivl_design_roots) is followed by its children (in the order of
+ *    ivl_scope_child), each of which is followed by its own children,
+ *    and so on. The array is built on the first call and belongs to
+ *    the design.
+ *
  * ivl_design_time_precision
  *    A design as a time precision. This is the size in seconds (a
  *    signed power of 10) of a simulation tick.
@@ -599,6 +608,9 @@ extern ivl_scope_t ivl_design_root(ivl_design_t des);
 extern void        ivl_design_roots(ivl_design_t des,
 				    ivl_scope_t **scopes,
 				    unsigned int *nscopes);
+extern void        ivl_design_scopes(ivl_design_t des,
+				     ivl_scope_t **scopes,
+				     unsigned int *nscopes);
 extern int         ivl_design_time_precision(ivl_design_t des);
 
 extern unsigned        ivl_design_consts(ivl_design_t des);
@@ -1582,6 +1594,17 @@ extern ivl_lval_t  ivl_lval_nest(ivl_lval_t net);
  * ivl_nexus_ptr
  *    Return a nexus pointer given the nexus and an index.
  *
+ * ivl_nexus_ptr_array
+ *    This function returns to the caller a pointer to an array of all
+ *    the nexus pointers of the nexus, and the size of the array. The
+ *    drivers (the pointers where drive0 or drive1 is not HiZ) are
+ *    first in the array, followed by the receivers, and the number of
+ *    drivers is returned through ndrivers. Within each group, the
+ *    pointers are in the ivl_nexus_ptr order. The array is built on
+ *    the first call and belongs to the nexus. This lets a target
+ *    visit all the drivers or all the pins of a nexus without an
+ *    accessor call per pin.
+ *
  * ivl_nexus_set_private
  * ivl_nexus_get_private
  *    The target module often needs to associate data with a nexus for
@@ -1641,6 +1664,10 @@ extern ivl_lval_t  ivl_lval_nest(ivl_lval_t net);
 extern const char*     ivl_nexus_name(ivl_nexus_t net) __attribute__((deprecated));
 extern unsigned        ivl_nexus_ptrs(ivl_nexus_t net);
 extern ivl_nexus_ptr_t ivl_nexus_ptr(ivl_nexus_t net, unsigned idx);
+extern void            ivl_nexus_ptr_array(ivl_nexus_t net,
+					   ivl_nexus_ptr_t **ptrs,
+					   unsigned *nptrs,
+					   unsigned *ndrivers);
 
 extern void  ivl_nexus_set_private(ivl_nexus_t net, void*data);
 extern void* ivl_nexus_get_private(ivl_nexus_t net);
@@ -1843,6 +1870,11 @@ extern unsigned    ivl_parameter_lineno(ivl_parameter_t net);
  *    anything that can become and ivl_signal_t, include synthetic
  *    signals generated by the compiler.
  *
+ * ivl_scope_sig_array
+ *    This returns to the caller a pointer to the array of signals of
+ *    the scope, and the size of the array. The signals are in the
+ *    same order as for ivl_scope_sig.
+ *
  * ivl_scope_time_precision
  *    Scopes have their own intrinsic time precision, typically from
  *    the timescale compiler directive. This method returns the
@@ -1903,6 +1935,9 @@ extern ivl_signal_t ivl_scope_port(ivl_scope_t net, unsigned idx);
 extern ivl_nexus_t  ivl_scope_mod_port(ivl_scope_t net, unsigned idx);
 extern unsigned     ivl_scope_sigs(ivl_scope_t net);
 extern ivl_signal_t ivl_scope_sig(ivl_scope_t net, unsigned idx);
+extern void         ivl_scope_sig_array(ivl_scope_t net,
+					ivl_signal_t **sigs,
+					unsigned *nsigs);
 extern unsigned     ivl_scope_switches(ivl_scope_t net);
 extern ivl_switch_t ivl_scope_switch(ivl_scope_t net, unsigned idx);
 extern ivl_scope_type_t ivl_scope_type(ivl_scope_t net);
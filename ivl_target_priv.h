@@ -57,6 +57,9 @@ struct ivl_design_s {
 	// This is used to implement the ivl_design_roots function.
       std::vector<ivl_scope_t> root_scope_list;
 
+	// This is used to implement the ivl_design_scopes function.
+      std::vector<ivl_scope_t> all_scope_list;
+
 	// Keep an array of constants objects.
       std::vector<ivl_net_const_t> consts;
 
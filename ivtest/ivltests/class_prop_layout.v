@@ -0,0 +1,50 @@
+// Check that class properties of mixed types keep their values when
+// they are read and written through base and derived class handles.
+
+module test;
+
+   class base;
+      byte         b;
+      logic [39:0] l;
+      real         r;
+   endclass
+
+   class derived extends base;
+      string       s;
+      logic [7:0]  l2;
+      int          i;
+      base         inner;
+   endclass
+
+   derived d;
+   base    h;
+   bit     err = 0;
+
+   initial begin
+      d = new;
+      d.inner = new;
+      d.b  = 8'h5a;
+      d.l  = 40'hxx_1234_zz01;
+      d.r  = 1.5;
+      d.s  = "text";
+      d.l2 = 8'b1x0z_1x0z;
+      d.i  = -7;
+      d.inner.l = 40'h12_3456_789a;
+
+      h = d;
+      if (h.b !== 8'h5a) err = 1;
+      if (h.l !== 40'hxx_1234_zz01) err = 1;
+      if (h.r != 1.5) err = 1;
+      if (d.s != "text") err = 1;
+      if (d.l2 !== 8'b1x0z_1x0z) err = 1;
+      if (d.i !== -7) err = 1;
+      if (d.inner.l !== 40'h12_3456_789a) err = 1;
+
+      h.l = 40'h0;
+      if (d.l !== 40'h0) err = 1;
+
+      if (err) $display("FAILED");
+      else $display("PASSED");
+   end
+
+endmodule
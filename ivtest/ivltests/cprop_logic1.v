@@ -0,0 +1,93 @@
+// Check that gates with constant inputs, chains of buffers and
+// inverters, and duplicated gates still give the same results as
+// the equivalent procedural expressions for all 4-state inputs. The
+// compiler may fold, shorten or merge these gates.
+module main;
+
+   reg a, b, c;
+   reg [3:0] v;
+
+   wire one = 1'b1;
+   wire zero = 1'b0;
+   wire [3:0] k = 4'd3;
+
+   wire y1 = a & one;
+   wire y2 = (a | zero) ^ b;
+   wire y3 = a & zero & b;
+   wire y4 = ~(a | one);
+   wire y5 = ~(~(a & b));
+   wire y6 = (a & b) | c;
+   wire y7 = (b & a) ^ c;
+   wire y8 = &k;
+   wire [3:0] y9 = k + 4'd4;
+   wire [3:0] y10 = v ^ {zero, zero, zero, zero};
+   wire t1, t2, y11;
+
+   buf  g1 (t1, a);
+   buf  g2 (t2, t1);
+   not  g3 (y11, t2);
+
+   integer ia, ib, ic;
+   reg 	   fail;
+
+   initial begin
+      fail = 0;
+      for (ia = 0 ; ia < 4 ; ia = ia + 1)
+      for (ib = 0 ; ib < 4 ; ib = ib + 1)
+      for (ic = 0 ; ic < 4 ; ic = ic + 1) begin
+	 a = (ia == 0) ? 1'b0 : (ia == 1) ? 1'b1 : (ia == 2) ? 1'bx : 1'bz;
+	 b = (ib == 0) ? 1'b0 : (ib == 1) ? 1'b1 : (ib == 2) ? 1'bx : 1'bz;
+	 c = (ic == 0) ? 1'b0 : (ic == 1) ? 1'b1 : (ic == 2) ? 1'bx : 1'bz;
+	 v = {a, b, c, a};
+	 #1;
+	 if (y1 !== (a & 1'b1)) begin
+	    $display("FAILED -- y1=%b, a=%b", y1, a);
+	    fail = 1;
+	 end
+	 if (y2 !== ((a | 1'b0) ^ b)) begin
+	    $display("FAILED -- y2=%b, a=%b b=%b", y2, a, b);
+	    fail = 1;
+	 end
+	 if (y3 !== 1'b0) begin
+	    $display("FAILED -- y3=%b, a=%b b=%b", y3, a, b);
+	    fail = 1;
+	 end
+	 if (y4 !== 1'b0) begin
+	    $display("FAILED -- y4=%b, a=%b", y4, a);
+	    fail = 1;
+	 end
+	 if (y5 !== (a & b)) begin
+	    $display("FAILED -- y5=%b, a=%b b=%b", y5, a, b);
+	    fail = 1;
+	 end
+	 if (y6 !== ((a & b) | c)) begin
+	    $display("FAILED -- y6=%b, a=%b b=%b c=%b", y6, a, b, c);
+	    fail = 1;
+	 end
+	 if (y7 !== ((a & b) ^ c)) begin
+	    $display("FAILED -- y7=%b, a=%b b=%b c=%b", y7, a, b, c);
+	    fail = 1;
+	 end
+	 if (y8 !== 1'b0) begin
+	    $display("FAILED -- y8=%b", y8);
+	    fail = 1;
+	 end
+	 if (y9 !== 4'd7) begin
+	    $display("FAILED -- y9=%b", y9);
+	    fail = 1;
+	 end
+	 if (y10 !== (v ^ 4'b0000)) begin
+	    $display("FAILED -- y10=%b, v=%b", y10, v);
+	    fail = 1;
+	 end
+	 if (y11 !== ~a) begin
+	    $display("FAILED -- y11=%b, a=%b", y11, a);
+	    fail = 1;
+	 end
+      end
+
+      if (!fail)
+	$display("PASSED");
+   end
+
+endmodule // main
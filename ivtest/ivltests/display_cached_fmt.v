@@ -0,0 +1,17 @@
+// Check that a $display call site that is run repeatedly formats the
+// current values of its arguments each time.
+module test;
+  reg [7:0] r;
+  reg [11:0] w;
+  integer i;
+
+  initial begin
+    for (i = 0; i < 3; i = i + 1) begin
+      r = i * 100;
+      w = 12'h00f << (4*i);
+      $display("r=%d h=%h z=%0h b=%b %% w=%0d", r, r, w, r[3:0], w);
+    end
+    $write("%h", r);
+    $write("|%s|\n", "ab");
+  end
+endmodule
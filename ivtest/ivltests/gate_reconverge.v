@@ -0,0 +1,54 @@
+// Check that a gate at the end of reconvergent paths of different
+// depth is evaluated once per change of the input, after all of its
+// inputs have settled. If the gate were evaluated as soon as its
+// first input changed, it would glitch, and the edge counters below
+// would see the extra edges.
+module main;
+
+   reg        a;
+   wire       n1, n2, n3, y, z;
+   integer    ypos, yneg, zpos, zneg, i;
+   reg        failed;
+
+   not g1 (n1, a);
+   not g2 (n2, n1);
+   not g3 (n3, n2);
+     // y is always 0, and z is always ~a.
+   xor g4 (y, a, n2);
+   xor g5 (z, a, n1, n3);
+
+   always @(posedge y) begin
+      ypos = ypos + 1;
+      $display("y rose at %0t", $time);
+   end
+   always @(negedge y) yneg = yneg + 1;
+   always @(posedge z) zpos = zpos + 1;
+   always @(negedge z) zneg = zneg + 1;
+
+   initial begin
+      failed = 0;
+      a = 0;
+      #1;
+      ypos = 0;
+      yneg = 0;
+      zpos = 0;
+      zneg = 0;
+
+      for (i = 0 ; i < 4 ; i = i + 1)
+	#1 a = ~a;
+      #1;
+
+      if (y !== 1'b0 || ypos !== 0 || yneg !== 0) begin
+	 $display("FAILED: y=%b ypos=%0d yneg=%0d", y, ypos, yneg);
+	 failed = 1;
+      end
+      if (z !== 1'b1 || zpos !== 2 || zneg !== 2) begin
+	 $display("FAILED: z=%b zpos=%0d zneg=%0d", z, zpos, zneg);
+	 failed = 1;
+      end
+
+      if (!failed)
+	$display("PASSED");
+   end
+
+endmodule
@@ -0,0 +1,59 @@
+// Check that cones of simple gates give the same results as the
+// equivalent procedural expressions for all 4-state inputs. The code
+// generator may collapse these cones into LUT functors.
+module main;
+
+   reg a, b, c, d, e;
+   reg [3:0] vals;
+
+   wire y1 = ~(a & b) | (c ^ ~d);
+   wire y2 = (a | b) & ~(c | d);
+   wire y3 = ~(a ^ b) ^ (a & c);
+   wire y4 = ((a & b) | (c & d)) ^ e;
+   wire y5 = ~(~(~a));
+
+   integer ia, ib, ic, id, ie;
+   reg 	   fail;
+
+   initial begin
+      vals = 4'b0000;
+      fail = 0;
+      for (ia = 0 ; ia < 4 ; ia = ia + 1)
+      for (ib = 0 ; ib < 4 ; ib = ib + 1)
+      for (ic = 0 ; ic < 4 ; ic = ic + 1)
+      for (id = 0 ; id < 4 ; id = id + 1)
+      for (ie = 0 ; ie < 4 ; ie = ie + 1) begin
+	 a = (ia == 0) ? 1'b0 : (ia == 1) ? 1'b1 : (ia == 2) ? 1'bx : 1'bz;
+	 b = (ib == 0) ? 1'b0 : (ib == 1) ? 1'b1 : (ib == 2) ? 1'bx : 1'bz;
+	 c = (ic == 0) ? 1'b0 : (ic == 1) ? 1'b1 : (ic == 2) ? 1'bx : 1'bz;
+	 d = (id == 0) ? 1'b0 : (id == 1) ? 1'b1 : (id == 2) ? 1'bx : 1'bz;
+	 e = (ie == 0) ? 1'b0 : (ie == 1) ? 1'b1 : (ie == 2) ? 1'bx : 1'bz;
+	 #1;
+	 if (y1 !== (~(a & b) | (c ^ ~d))) begin
+	    $display("FAILED -- y1=%b, a=%b b=%b c=%b d=%b", y1, a, b, c, d);
+	    fail = 1;
+	 end
+	 if (y2 !== ((a | b) & ~(c | d))) begin
+	    $display("FAILED -- y2=%b, a=%b b=%b c=%b d=%b", y2, a, b, c, d);
+	    fail = 1;
+	 end
+	 if (y3 !== (~(a ^ b) ^ (a & c))) begin
+	    $display("FAILED -- y3=%b, a=%b b=%b c=%b", y3, a, b, c);
+	    fail = 1;
+	 end
+	 if (y4 !== (((a & b) | (c & d)) ^ e)) begin
+	    $display("FAILED -- y4=%b, a=%b b=%b c=%b d=%b e=%b",
+		     y4, a, b, c, d, e);
+	    fail = 1;
+	 end
+	 if (y5 !== ~a) begin
+	    $display("FAILED -- y5=%b, a=%b", y5, a);
+	    fail = 1;
+	 end
+      end
+
+      if (!fail)
+	$display("PASSED");
+   end
+
+endmodule // main
@@ -0,0 +1,77 @@
+// Check the buffered background output of vvp -b. A file that is
+// flushed, by name or by a $fflush of all files, can be read back
+// while it is still open, and a ".gz" file is complete once it is
+// closed.
+module main;
+
+   integer    mcd, gz, fd, code, ch0, ch1;
+   reg [8*16:1] line;
+   reg        failed;
+
+   initial begin
+      failed = 0;
+
+      mcd = $fopen("work/mcd_async.txt");
+      gz = $fopen("work/mcd_async.txt.gz");
+      $fdisplay(mcd | gz, "first");
+      $fdisplay(mcd | gz, "second");
+      $fflush(mcd);
+
+      fd = $fopen("work/mcd_async.txt", "r");
+      code = $fgets(line, fd);
+      if (line !== "first\n") begin
+	 $display("FAILED: first line is \"%0s\"", line);
+	 failed = 1;
+      end
+      code = $fgets(line, fd);
+      if (line !== "second\n") begin
+	 $display("FAILED: second line is \"%0s\"", line);
+	 failed = 1;
+      end
+      $fclose(fd);
+
+	// A $fflush without an argument flushes the channel as well.
+      $fdisplay(mcd, "third");
+      $fflush;
+
+      fd = $fopen("work/mcd_async.txt", "r");
+      code = $fgets(line, fd);
+      code = $fgets(line, fd);
+      code = $fgets(line, fd);
+      if (line !== "third\n") begin
+	 $display("FAILED: third line is \"%0s\"", line);
+	 failed = 1;
+      end
+      $fclose(fd);
+
+      $fdisplay(mcd, "fourth");
+      $fclose(mcd);
+      $fclose(gz);
+
+      fd = $fopen("work/mcd_async.txt", "r");
+      code = $fgets(line, fd);
+      code = $fgets(line, fd);
+      code = $fgets(line, fd);
+      code = $fgets(line, fd);
+      if (line !== "fourth\n") begin
+	 $display("FAILED: fourth line is \"%0s\"", line);
+	 failed = 1;
+      end
+      $fclose(fd);
+
+	// The compressed file starts with the gzip magic number. If
+	// vvp was built without zlib, it holds the plain text.
+      fd = $fopen("work/mcd_async.txt.gz", "rb");
+      ch0 = $fgetc(fd);
+      ch1 = $fgetc(fd);
+      if (!(ch0 == 8'h1f && ch1 == 8'h8b) && !(ch0 == "f" && ch1 == "i")) begin
+	 $display("FAILED: gzip file starts with %h %h", ch0, ch1);
+	 failed = 1;
+      end
+      $fclose(fd);
+
+      if (!failed)
+	$display("PASSED");
+   end
+
+endmodule
@@ -0,0 +1,86 @@
+// Check the builtin system functions that vvp runs natively. These
+// must return the same values as the versions in the system modules.
+`timescale 1ns/10ps
+module main;
+
+   integer    seed, r;
+   reg [31:0] u;
+   reg [7:0]  v;
+   reg        failed;
+
+   initial begin
+      failed = 0;
+
+      r = $random;
+      if (r !== 303379748) begin
+	 $display("FAILED: $random returned %0d", r);
+	 failed = 1;
+      end
+
+      seed = 0;
+      r = $random(seed);
+      if (r !== 303379748) begin
+	 $display("FAILED: $random(seed) returned %0d", r);
+	 failed = 1;
+      end
+      r = $random(seed);
+      if (r !== -1064739199) begin
+	 $display("FAILED: second $random(seed) returned %0d", r);
+	 failed = 1;
+      end
+      r = $random(seed);
+      if (r !== -2071669239) begin
+	 $display("FAILED: third $random(seed) returned %0d", r);
+	 failed = 1;
+      end
+
+      seed = 5;
+      u = $urandom(seed);
+      if (u !== 32'd345600) begin
+	 $display("FAILED: $urandom(seed) returned %0d", u);
+	 failed = 1;
+      end
+      u = $urandom(seed);
+      if (u !== 32'd2377867035) begin
+	 $display("FAILED: second $urandom(seed) returned %0d", u);
+	 failed = 1;
+      end
+
+      #12.34;
+      if ($time !== 64'd12 || $stime !== 32'd12 || $simtime !== 64'd1234) begin
+	 $display("FAILED: time is %0d/%0d/%0d", $time, $stime, $simtime);
+	 failed = 1;
+      end
+      if ($realtime != 12.34) begin
+	 $display("FAILED: $realtime returned %f", $realtime);
+	 failed = 1;
+      end
+
+	// This rounds up.
+      #0.26;
+      if ($time !== 64'd13 || $stime !== 32'd13) begin
+	 $display("FAILED: rounded time is %0d/%0d", $time, $stime);
+	 failed = 1;
+      end
+
+      v = 17;
+      if ($clog2(v) !== 5) begin
+	 $display("FAILED: $clog2(17) returned %0d", $clog2(v));
+	 failed = 1;
+      end
+      v = 1;
+      if ($clog2(v) !== 0) begin
+	 $display("FAILED: $clog2(1) returned %0d", $clog2(v));
+	 failed = 1;
+      end
+      v = 8'bx;
+      if ($clog2(v) !== 32'bx) begin
+	 $display("FAILED: $clog2(x) returned %0d", $clog2(v));
+	 failed = 1;
+      end
+
+      if (!failed)
+	$display("PASSED");
+   end
+
+endmodule
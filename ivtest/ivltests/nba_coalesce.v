@@ -0,0 +1,84 @@
+// Check that several non-blocking assignments to the same variable,
+// part of a variable or memory word in one time step leave the same
+// result as running them one after another.
+module main;
+
+   reg [15:0] r, p;
+   reg [7:0]  mem [0:7];
+   real       rm [0:1];
+   reg [7:0]  q;
+   integer    i, changes;
+   reg        failed;
+
+   always @(q) changes = changes + 1;
+
+   initial begin
+      failed = 0;
+      changes = 0;
+      r = 16'h0000;
+      p = 16'hxxxx;
+      q = 8'h00;
+      for (i = 0 ; i < 8 ; i = i + 1)
+	mem[i] = 8'h00;
+      #1;
+
+      r <= 16'h1111;
+      r <= 16'h2222;
+      r[3:0] <= 4'ha;
+
+      p[3:0] <= 4'h1;
+      p[11:8] <= 4'h2;
+      p[7:4] <= 4'h3;
+      p[1:0] <= 2'b00;
+
+      for (i = 0 ; i < 8 ; i = i + 1)
+	mem[i] <= i;
+      for (i = 0 ; i < 8 ; i = i + 2)
+	mem[i][7:4] <= 4'hf;
+
+      rm[0] <= 1.5;
+      rm[0] <= 2.5;
+
+      q <= 8'h01;
+      q <= 8'h02;
+      q <= 8'h03;
+      q <= #2 8'h04;
+      q <= #2 8'h05;
+      #1;
+
+      if (r !== 16'h222a) begin
+	 $display("FAILED -- r = %h", r);
+	 failed = 1;
+      end
+      if (p !== 16'hx230) begin
+	 $display("FAILED -- p = %h", p);
+	 failed = 1;
+      end
+      for (i = 0 ; i < 8 ; i = i + 1)
+	if (mem[i] !== ((i % 2) ? i : 8'hf0 | i)) begin
+	   $display("FAILED -- mem[%0d] = %h", i, mem[i]);
+	   failed = 1;
+	end
+      if (rm[0] != 2.5) begin
+	 $display("FAILED -- rm[0] = %f", rm[0]);
+	 failed = 1;
+      end
+      if (q !== 8'h03) begin
+	 $display("FAILED -- q = %h", q);
+	 failed = 1;
+      end
+      #2;
+      if (q !== 8'h05) begin
+	 $display("FAILED -- q = %h after delay", q);
+	 failed = 1;
+      end
+      if (changes != 2) begin
+	 $display("FAILED -- q changed %0d times", changes);
+	 failed = 1;
+      end
+
+      if (!failed)
+	$display("PASSED");
+   end
+
+endmodule
@@ -0,0 +1,56 @@
+// Check that non-blocking assignments to different parts of the same
+// vector in one time step each make a value of their own. Nets that
+// decode the whole vector must see the value between the two writes.
+module main;
+
+   reg [1:0]  q;
+   reg [7:0]  mem [0:1];
+   reg [3:0]  r;
+   wire       w = (q == 2'b01);
+   wire       m = (mem[1] == 8'h0f);
+   wire       x = (r == 4'b0011);
+   integer    wpos, mpos, xpos;
+   reg        failed;
+
+   always @(posedge w) wpos = wpos + 1;
+   always @(posedge m) mpos = mpos + 1;
+   always @(posedge x) xpos = xpos + 1;
+
+   initial begin
+      failed = 0;
+      wpos = 0;
+      mpos = 0;
+      xpos = 0;
+      q = 2'b00;
+      mem[1] = 8'h00;
+      r = 4'b0000;
+      #1;
+
+      q[0] <= 1'b1;
+      q[1] <= 1'b1;
+      mem[1][3:0] <= 4'hf;
+      mem[1][7:4] <= 4'hf;
+	// The second write repeats part of the first one, so r never
+	// has a value that the first write did not give it.
+      r <= 4'b0011;
+      r[1:0] <= 2'b11;
+      #1;
+
+      if (q !== 2'b11 || wpos !== 1) begin
+	 $display("FAILED: q=%b wpos=%0d", q, wpos);
+	 failed = 1;
+      end
+      if (mem[1] !== 8'hff || mpos !== 1) begin
+	 $display("FAILED: mem[1]=%h mpos=%0d", mem[1], mpos);
+	 failed = 1;
+      end
+      if (r !== 4'b0011 || xpos !== 1) begin
+	 $display("FAILED: r=%b xpos=%0d", r, xpos);
+	 failed = 1;
+      end
+
+      if (!failed)
+	$display("PASSED");
+   end
+
+endmodule
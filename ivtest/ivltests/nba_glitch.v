@@ -0,0 +1,70 @@
+// Check that a pulse made by two non-blocking assignments to the same
+// variable in one time step is seen by edge sensitive code, and that
+// assignments to different variables keep their order.
+module main;
+
+   reg        q, a, b;
+   reg [3:0]  v;
+   reg [7:0]  mem [0:1];
+   wire       w = q;
+   wire       m0 = mem[1][0];
+   wire       aandb = a & ~b;
+   integer    pos, neg, wneg, vpos, mpos, glitch;
+   reg        failed;
+
+   always @(posedge q) pos = pos + 1;
+   always @(negedge q) neg = neg + 1;
+   always @(negedge w) wneg = wneg + 1;
+   always @(posedge v[0]) vpos = vpos + 1;
+   always @(posedge m0) mpos = mpos + 1;
+   always @(posedge aandb) glitch = glitch + 1;
+
+   initial begin
+      failed = 0;
+      pos = 0;
+      neg = 0;
+      wneg = 0;
+      vpos = 0;
+      mpos = 0;
+      glitch = 0;
+      q = 1;
+      a = 0;
+      b = 0;
+      v = 4'b0001;
+      mem[1] = 8'h01;
+      #1;
+
+      q <= 0;
+      q <= 1;
+      v[0] <= 0;
+      v <= 4'b0011;
+      mem[1] <= 8'h00;
+      mem[1][0] <= 1'b1;
+	// b is set before a is set to 1, so a & ~b never goes high.
+      a <= 0;
+      b <= 1;
+      a <= 1;
+      #1;
+
+      if (q !== 1'b1 || pos !== 1 || neg !== 1 || wneg !== 1) begin
+	 $display("FAILED: q=%b pos=%0d neg=%0d wneg=%0d", q, pos, neg, wneg);
+	 failed = 1;
+      end
+      if (v !== 4'b0011 || vpos !== 1) begin
+	 $display("FAILED: v=%b vpos=%0d", v, vpos);
+	 failed = 1;
+      end
+      if (mem[1] !== 8'h01 || mpos !== 1) begin
+	 $display("FAILED: mem[1]=%h mpos=%0d", mem[1], mpos);
+	 failed = 1;
+      end
+      if (glitch !== 0) begin
+	 $display("FAILED: a & ~b pulsed %0d times", glitch);
+	 failed = 1;
+      end
+
+      if (!failed)
+	$display("PASSED");
+   end
+
+endmodule
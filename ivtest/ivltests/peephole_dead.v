@@ -0,0 +1,47 @@
+// Check code that the thread code optimizer can shorten: constant
+// writes to memory words that set the same flag and index register
+// again, a zero replication whose value is pushed and popped, and a
+// write to a word that does not exist.
+module main;
+
+   reg [7:0]  mem [0:3];
+   reg [3:0]  a, b;
+   reg [7:0]  c;
+   reg [7:0]  r [0:1];
+   integer    i;
+   reg        failed;
+
+   initial begin
+      failed = 0;
+      a = 4'h5;
+      b = 4'ha;
+      mem[1] = 8'h11;
+      mem[2] = 8'h22;
+      mem[2] = 8'h23;
+      mem[3] = 8'h33;
+      mem[7] = 8'h77;
+      c = {{0{a}}, a, b};
+      r[0] = c;
+      r[0] = r[0] + 1;
+
+      if (mem[1] !== 8'h11 || mem[2] !== 8'h23 || mem[3] !== 8'h33) begin
+	 $display("FAILED: mem = %h %h %h", mem[1], mem[2], mem[3]);
+	 failed = 1;
+      end
+      if (c !== 8'h5a || r[0] !== 8'h5b) begin
+	 $display("FAILED: c = %h, r[0] = %h", c, r[0]);
+	 failed = 1;
+      end
+
+      for (i = 0 ; i < 4 ; i = i + 1)
+	mem[i] = i;
+      if (mem[0] !== 8'h00 || mem[3] !== 8'h03) begin
+	 $display("FAILED: mem = %h %h after loop", mem[0], mem[3]);
+	 failed = 1;
+      end
+
+      if (!failed)
+	$display("PASSED");
+   end
+
+endmodule
@@ -0,0 +1,200 @@
+// Check queues of vectors, which are kept in a ring buffer: pushes and
+// pops that wrap around the end of the ring, growing a wrapped ring,
+// inserts and deletes near both ends, copying a wrapped queue and a
+// bounded queue. The elements are wider than a machine word.
+module top;
+  typedef logic [79:0] elem_t;
+
+  elem_t q [$];
+  elem_t q_wrap [$];
+  elem_t q_copy [$];
+  elem_t q_bnd [$:3];
+  elem_t model [0:63];
+  elem_t tmp;
+  integer model_size;
+  bit passed;
+
+  function automatic elem_t mk(input integer i);
+    mk = {i[15:0], 64'hf0f0_0000_0000_0000 + i};
+  endfunction
+
+  task automatic model_insert(input integer idx, input elem_t val);
+    for (int i = model_size; i > idx; i--)
+      model[i] = model[i-1];
+    model[idx] = val;
+    model_size++;
+  endtask
+
+  task automatic model_delete(input integer idx);
+    for (int i = idx; i < model_size-1; i++)
+      model[i] = model[i+1];
+    model_size--;
+  endtask
+
+  task automatic check(input integer lineno);
+    if (q.size() !== model_size) begin
+      $display("line %0d: Failed: queue size %0d != %0d",
+               lineno, q.size(), model_size);
+      passed = 1'b0;
+    end else begin
+      for (int i = 0; i < model_size; i++)
+        if (q[i] !== model[i]) begin
+          $display("line %0d: Failed: element [%0d] %h != %h",
+                   lineno, i, q[i], model[i]);
+          passed = 1'b0;
+        end
+    end
+  endtask
+
+  task automatic check_elem(input elem_t got, input elem_t expected,
+                            input integer lineno);
+    if (got !== expected) begin
+      $display("line %0d: Failed: %h != %h", lineno, got, expected);
+      passed = 1'b0;
+    end
+  endtask
+
+  initial begin
+    passed = 1'b1;
+    model_size = 0;
+
+      // Move the head up the ring, then push past the end of the
+      // ring so that the elements wrap.
+    for (int i = 0; i < 6; i++) begin
+      q.push_back(mk(i));
+      model_insert(model_size, mk(i));
+    end
+    for (int i = 0; i < 5; i++) begin
+      check_elem(q.pop_front(), mk(i), `__LINE__);
+      model_delete(0);
+    end
+    for (int i = 6; i < 12; i++) begin
+      q.push_back(mk(i));
+      model_insert(model_size, mk(i));
+    end
+    check(`__LINE__);
+
+      // Fill the wrapped ring from the front, then grow it.
+    q.push_front(mk(100));
+    model_insert(0, mk(100));
+    q.push_front(mk(101));
+    model_insert(0, mk(101));
+    check(`__LINE__);
+    check_elem(q[0], mk(101), `__LINE__);
+    check_elem(q[1], mk(100), `__LINE__);
+    check_elem(q[2], mk(5), `__LINE__);
+    check_elem(q[$], mk(11), `__LINE__);
+
+      // Insert and delete near both ends, and at the ends.
+    q.insert(1, mk(200));
+    model_insert(1, mk(200));
+    q.insert(q.size()-1, mk(201));
+    model_insert(model_size-1, mk(201));
+    q.insert(0, mk(202));
+    model_insert(0, mk(202));
+    q.insert(q.size(), mk(203));
+    model_insert(model_size, mk(203));
+    check(`__LINE__);
+    check_elem(q[0], mk(202), `__LINE__);
+    check_elem(q[2], mk(200), `__LINE__);
+    check_elem(q[q.size()-2], mk(11), `__LINE__);
+    check_elem(q[q.size()-3], mk(201), `__LINE__);
+
+    q.delete(1);
+    model_delete(1);
+    q.delete(q.size()-2);
+    model_delete(model_size-2);
+    q.delete(0);
+    model_delete(0);
+    q.delete(q.size()-1);
+    model_delete(model_size-1);
+    check(`__LINE__);
+    check_elem(q.pop_back(), mk(201), `__LINE__);
+    model_delete(model_size-1);
+    check_elem(q.pop_front(), mk(200), `__LINE__);
+    model_delete(0);
+    check(`__LINE__);
+
+      // Mix the operations so that the head and the tail wrap in
+      // both directions while the ring grows.
+    for (int i = 0; i < 300; i++) begin
+      case (i % 7)
+        0, 3: begin
+          q.push_back(mk(1000+i));
+          model_insert(model_size, mk(1000+i));
+        end
+        1: begin
+          q.push_front(mk(1000+i));
+          model_insert(0, mk(1000+i));
+        end
+        2: if (model_size > 0) begin
+          check_elem(q.pop_front(), model[0], `__LINE__);
+          model_delete(0);
+        end
+        4: if (model_size > 0) begin
+          q.insert(1, mk(1000+i));
+          model_insert(1, mk(1000+i));
+        end
+        5: if (model_size > 0) begin
+          q.insert(q.size()-1, mk(1000+i));
+          model_insert(model_size-1, mk(1000+i));
+        end
+        6: if (model_size > 2) begin
+          q.delete(1);
+          model_delete(1);
+          q.delete(q.size()-2);
+          model_delete(model_size-2);
+          check_elem(q.pop_back(), model[model_size-1], `__LINE__);
+          model_delete(model_size-1);
+        end
+      endcase
+      check(`__LINE__);
+    end
+
+      // Copy a queue whose elements wrap around the end of the ring:
+      // 6 and 7 are at the end of the ring, and 8 to 13 at the start.
+    for (int i = 0; i < 8; i++)
+      q_wrap.push_back(mk(i));
+    for (int i = 0; i < 6; i++)
+      tmp = q_wrap.pop_front();
+    for (int i = 8; i < 14; i++)
+      q_wrap.push_back(mk(i));
+
+    q_copy = q_wrap;
+    q_copy[0] = mk(99);
+    if (q_copy.size() !== 8) begin
+      $display("Failed: copy size %0d != 8", q_copy.size());
+      passed = 1'b0;
+    end
+    check_elem(q_wrap[0], mk(6), `__LINE__);
+    check_elem(q_copy[0], mk(99), `__LINE__);
+    for (int i = 1; i < 8; i++)
+      check_elem(q_copy[i], mk(6+i), `__LINE__);
+
+      // Copy the wrapped queue into a bounded queue, which keeps the
+      // first four elements, and then work on the full queue.
+    q_bnd = q_wrap; // Warning: not all items copied.
+    if (q_bnd.size() !== 4) begin
+      $display("Failed: bounded size %0d != 4", q_bnd.size());
+      passed = 1'b0;
+    end
+    for (int i = 0; i < 4; i++)
+      check_elem(q_bnd[i], mk(6+i), `__LINE__);
+
+    q_bnd.push_front(mk(50)); // Warning: back item removed.
+    q_bnd.push_back(mk(51)); // Warning: item not added.
+    q_bnd.insert(2, mk(52)); // Warning: back item removed.
+    check_elem(q_bnd.pop_front(), mk(50), `__LINE__);
+    q_bnd.push_back(mk(53));
+    if (q_bnd.size() !== 4) begin
+      $display("Failed: bounded size %0d != 4", q_bnd.size());
+      passed = 1'b0;
+    end
+    check_elem(q_bnd[0], mk(6), `__LINE__);
+    check_elem(q_bnd[1], mk(52), `__LINE__);
+    check_elem(q_bnd[2], mk(7), `__LINE__);
+    check_elem(q_bnd[3], mk(53), `__LINE__);
+
+    if (passed) $display("PASSED");
+  end
+endmodule : top
@@ -0,0 +1,27 @@
+// Tests that a changed package replaces the old one in the work library,
+// and that units compiled after the change see the new version (see the
+// VHDL files for details).
+
+module vhdl_pkg_rebuild_test;
+  int value_a, value_b;
+  logic [3:0] bits_a, bits_b;
+
+  pkg_rebuild_a dut_a(value_a, bits_a);
+  pkg_rebuild_b dut_b(value_b, bits_b);
+
+  initial begin
+    #1;   // wait for signal assignment
+
+    if(value_a !== 1 || bits_a !== 4'b0001) begin
+      $display("FAILED 1");
+      $finish;
+    end
+
+    if(value_b !== 2 || bits_b !== 4'b0010) begin
+      $display("FAILED 2");
+      $finish;
+    end
+
+    $display("PASSED");
+  end
+endmodule
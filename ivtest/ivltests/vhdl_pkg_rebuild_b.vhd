@@ -0,0 +1,17 @@
+-- Unit compiled against the second version of the package.
+
+library ieee;
+use ieee.std_logic_1164.all;
+use work.pkg_rebuild_pkg.all;
+
+entity pkg_rebuild_b is
+  port( value : out integer;
+        bits : out std_logic_vector(3 downto 0)
+    );
+end pkg_rebuild_b;
+
+architecture test of pkg_rebuild_b is
+begin
+  value <= c_value;
+  bits <= c_bits;
+end test;
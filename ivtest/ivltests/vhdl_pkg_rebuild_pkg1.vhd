@@ -0,0 +1,15 @@
+-- Tests that a changed package replaces the old one in the work library.
+-- This is the first version of the package, and vhdl_pkg_rebuild_pkg2.vhd
+-- is the second. The two versions are written to the work library as
+-- text of the same size, so only the contents tell them apart.
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+package pkg_rebuild_pkg is
+  constant c_value : integer := 1;
+  constant c_bits : std_logic_vector(3 downto 0) := "0001";
+end pkg_rebuild_pkg;
+
+package body pkg_rebuild_pkg is
+end pkg_rebuild_pkg;
@@ -0,0 +1,13 @@
+-- Tests that a changed package replaces the old one in the work library.
+-- This is the second version of the package (see vhdl_pkg_rebuild_pkg1.vhd).
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+package pkg_rebuild_pkg is
+  constant c_value : integer := 2;
+  constant c_bits : std_logic_vector(3 downto 0) := "0010";
+end pkg_rebuild_pkg;
+
+package body pkg_rebuild_pkg is
+end pkg_rebuild_pkg;
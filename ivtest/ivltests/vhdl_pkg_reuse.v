@@ -0,0 +1,41 @@
+// Tests that a package in the work library can be used by more than one
+// design unit (see the VHDL files for details).
+
+module vhdl_pkg_reuse_test;
+  int depth;
+  logic [7:0] low, reversed;
+
+  pkg_reuse_a dut_a();
+  pkg_reuse_b dut_b(depth, low, reversed);
+
+  initial begin
+    #1;   // wait for signal assignment
+
+    if(dut_a.pattern !== 8'b10000010) begin
+      $display("FAILED 1");
+      $finish;
+    end
+
+    if(dut_a.reversed !== 8'b01000001) begin
+      $display("FAILED 2");
+      $finish;
+    end
+
+    if(depth !== 10) begin
+      $display("FAILED 3");
+      $finish;
+    end
+
+    if(low !== 8'b00001111) begin
+      $display("FAILED 4");
+      $finish;
+    end
+
+    if(reversed !== 8'b11110000) begin
+      $display("FAILED 5");
+      $finish;
+    end
+
+    $display("PASSED");
+  end
+endmodule
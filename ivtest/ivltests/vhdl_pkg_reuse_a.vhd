@@ -0,0 +1,15 @@
+-- First unit that uses the package from the work library.
+
+library ieee;
+use ieee.std_logic_1164.all;
+use work.pkg_reuse_pkg.all;
+
+entity pkg_reuse_a is
+end pkg_reuse_a;
+
+architecture test of pkg_reuse_a is
+  signal pattern : word_t := c_pattern;
+  signal reversed : word_t;
+begin
+  reversed <= reverse(c_pattern);
+end test;
@@ -0,0 +1,19 @@
+-- Second unit that uses the package from the work library.
+
+library ieee;
+use ieee.std_logic_1164.all;
+use work.pkg_reuse_pkg.all;
+
+entity pkg_reuse_b is
+  port( depth : out integer;
+        low : out word_t;
+        reversed : out word_t
+    );
+end pkg_reuse_b;
+
+architecture test of pkg_reuse_b is
+begin
+  depth <= c_depth;
+  low <= c_low;
+  reversed <= reverse(c_low);
+end test;
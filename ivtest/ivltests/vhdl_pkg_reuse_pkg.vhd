@@ -0,0 +1,28 @@
+-- Tests that a package in the work library can be used by more than one
+-- design unit. The package is written to the work library when this
+-- file is compiled, and both units then load it from there.
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+package pkg_reuse_pkg is
+  constant c_depth : integer := 10;
+
+  subtype word_t is std_logic_vector(7 downto 0);
+  constant c_pattern : word_t := (7 => '1', 1 => '1', others => '0');
+  constant c_low : word_t := "00001111";
+
+  function reverse(input_word : word_t) return word_t;
+end pkg_reuse_pkg;
+
+package body pkg_reuse_pkg is
+  function reverse(input_word : word_t) return word_t is
+    variable output_word : word_t;
+  begin
+    for i in 7 downto 0 loop
+      output_word(i) := input_word(7 - i);
+    end loop;
+
+    return output_word;
+  end function;
+end pkg_reuse_pkg;
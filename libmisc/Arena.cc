@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 the Icarus Verilog contributors
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "Arena.h"
+# include  <new>
+# include  <cassert>
+
+/*
+ * Everything handed out is aligned to 16 bytes, which is enough for
+ * any object type on the machines we care about. This must be a power
+ * of 2, and the RecyclingArena GRAIN must be a multiple of it.
+ */
+static const size_t ARENA_ALIGN = 16;
+
+static inline size_t arena_round(size_t size)
+{
+      return (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+Arena::Arena(size_t chunk_size)
+: chunk_size_(chunk_size), chunks_(0), ptr_(0), avail_(0),
+  bytes_allocated_(0), bytes_reserved_(0)
+{
+}
+
+Arena::~Arena()
+{
+      release();
+}
+
+void* Arena::alloc(size_t size)
+{
+      size = arena_round(size? size : 1);
+      bytes_allocated_ += size;
+
+      if (size > avail_) {
+	    const size_t head = arena_round(sizeof(chunk_s));
+
+	      // Large items get a chunk of their own. Link it in after
+	      // the current chunk so that the remains of the current
+	      // chunk can still be used.
+	    if (size > chunk_size_/4) {
+		  chunk_s*chunk = static_cast<chunk_s*>(::operator new(head+size));
+		  bytes_reserved_ += head+size;
+		  if (chunks_) {
+			chunk->next = chunks_->next;
+			chunks_->next = chunk;
+		  } else {
+			chunk->next = 0;
+			chunks_ = chunk;
+		  }
+		  return reinterpret_cast<char*>(chunk) + head;
+	    }
+
+	    chunk_s*chunk = static_cast<chunk_s*>(::operator new(head+chunk_size_));
+	    bytes_reserved_ += head+chunk_size_;
+	    chunk->next = chunks_;
+	    chunks_ = chunk;
+	    ptr_ = reinterpret_cast<char*>(chunk) + head;
+	    avail_ = chunk_size_;
+      }
+
+      void*res = ptr_;
+      ptr_ += size;
+      avail_ -= size;
+      return res;
+}
+
+void Arena::release()
+{
+      while (chunks_) {
+	    chunk_s*next = chunks_->next;
+	    ::operator delete(chunks_);
+	    chunks_ = next;
+      }
+
+      ptr_ = 0;
+      avail_ = 0;
+      bytes_allocated_ = 0;
+      bytes_reserved_ = 0;
+}
+
+RecyclingArena::RecyclingArena(size_t chunk_size)
+: arena_(chunk_size)
+{
+      for (unsigned idx = 0 ; idx < NCLASSES ; idx += 1)
+	    free_[idx] = 0;
+}
+
+RecyclingArena::~RecyclingArena()
+{
+}
+
+void* RecyclingArena::alloc(size_t size)
+{
+      if (size == 0 || size > MAX_SMALL)
+	    return ::operator new(size);
+
+      unsigned cls = (size-1) / GRAIN;
+      if (free_cell_s*cell = free_[cls]) {
+	    free_[cls] = cell->next;
+	    return cell;
+      }
+
+      return arena_.alloc((cls+1) * GRAIN);
+}
+
+void RecyclingArena::free(void*ptr, size_t size)
+{
+      if (ptr == 0)
+	    return;
+
+      if (size == 0 || size > MAX_SMALL) {
+	    ::operator delete(ptr);
+	    return;
+      }
+
+      unsigned cls = (size-1) / GRAIN;
+      free_cell_s*cell = static_cast<free_cell_s*>(ptr);
+      cell->next = free_[cls];
+      free_[cls] = cell;
+}
+
+void RecyclingArena::release()
+{
+      for (unsigned idx = 0 ; idx < NCLASSES ; idx += 1)
+	    free_[idx] = 0;
+
+      arena_.release();
+}
@@ -0,0 +1,112 @@
+#ifndef IVL_Arena_H
+#define IVL_Arena_H
+/*
+ * Copyright (c) 2026 the Icarus Verilog contributors
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  <cstddef>
+
+/*
+ * An Arena is a region allocator. Memory is carved sequentially out
+ * of large chunks, so an allocation is little more than a pointer
+ * bump and carries no per-object malloc overhead. Individual objects
+ * are never returned to the arena. Instead, the release() method
+ * frees all the chunks at once. Destructors are NOT run by release(),
+ * so the caller must know that nothing still refers to the objects
+ * in the arena, and that anything they own outside the arena can be
+ * leaked or has already been freed.
+ *
+ * The plain Arena is the backing store of the RecyclingArena below,
+ * which is what classes that live in an arena use. Those classes
+ * define their own operator new to call RecyclingArena::alloc(), and
+ * an operator delete that passes the block to RecyclingArena::free().
+ */
+class Arena {
+
+    public:
+      explicit Arena(size_t chunk_size =DEFAULT_CHUNK_SIZE);
+      ~Arena();
+
+      void* alloc(size_t size);
+
+	// Free all the memory allocated from this arena.
+      void release();
+
+	// Statistics: the bytes handed out by alloc(), and the bytes
+	// actually held by the arena chunks.
+      size_t bytes_allocated() const { return bytes_allocated_; }
+      size_t bytes_reserved() const { return bytes_reserved_; }
+
+      enum { DEFAULT_CHUNK_SIZE = 256*1024 };
+
+    private:
+      struct chunk_s {
+	    chunk_s*next;
+      };
+
+      size_t chunk_size_;
+      chunk_s*chunks_;
+      char*ptr_;
+      size_t avail_;
+
+      size_t bytes_allocated_;
+      size_t bytes_reserved_;
+
+    private: // not implemented
+      Arena(const Arena&);
+      Arena& operator= (const Arena&);
+};
+
+/*
+ * A RecyclingArena is an Arena with free lists. Small blocks are
+ * sorted into size classes, and a freed block is put on the free list
+ * for its class, ready to be handed out again by the next alloc() of
+ * that size. This suits objects that are frequently replaced during
+ * processing (expressions being folded, for example) but that mostly
+ * live until the end. The size passed to free() must be the size
+ * passed to alloc(). Large blocks go directly to the system heap.
+ */
+class RecyclingArena {
+
+    public:
+      explicit RecyclingArena(size_t chunk_size =Arena::DEFAULT_CHUNK_SIZE);
+      ~RecyclingArena();
+
+      void* alloc(size_t size);
+      void  free(void*ptr, size_t size);
+
+      void release();
+
+      size_t bytes_reserved() const { return arena_.bytes_reserved(); }
+
+    private:
+      struct free_cell_s {
+	    free_cell_s*next;
+      };
+
+      enum { GRAIN = 16, MAX_SMALL = 512, NCLASSES = MAX_SMALL/GRAIN };
+
+      Arena arena_;
+      free_cell_s*free_[NCLASSES];
+
+    private: // not implemented
+      RecyclingArena(const RecyclingArena&);
+      RecyclingArena& operator= (const RecyclingArena&);
+};
+
+#endif /* IVL_Arena_H */
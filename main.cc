@@ -228,6 +228,9 @@ StringHeapLex filename_strings;
 
 StringHeapLex bits_strings;
 
+RecyclingArena pform_arena;
+RecyclingArena net_arena;
+
 /*
  * In library searches, Windows file names are never case sensitive.
  */
@@ -1262,7 +1265,9 @@ int main(int argc, char*argv[])
 	    assert(0);
       }
 
-	/* Done with all the pform data. Delete the modules. */
+	/* Done with all the pform data. Delete the modules, then
+	   release the rest of the parse tree in bulk. Nothing in the
+	   elaborated design refers back to it. */
       for (map<perm_string,Module*>::iterator idx = pform_modules.begin()
 		 ; idx != pform_modules.end() ; ++ idx ) {
 
@@ -1270,6 +1275,12 @@ int main(int argc, char*argv[])
 	    (*idx).second = 0;
       }
 
+      if (verbose_flag) {
+	    cerr << " ... releasing " << pform_arena.bytes_reserved()
+		 << " bytes of pform" << endl;
+      }
+      pform_arena.release();
+
       if (verbose_flag) {
 	    if (times_flag) {
 		  times(cycles+2);
@@ -1352,6 +1363,9 @@ int main(int argc, char*argv[])
 		 << " add_count=" << lex_strings.add_count()
 		 << " hit_count=" << lex_strings.add_hit_count()
 		 << endl;
+	    cout << "net_arena:"
+		 << " reserved=" << net_arena.bytes_reserved()
+		 << endl;
       }
 
       delete des;
@@ -48,6 +48,16 @@ NetExpr::~NetExpr()
 {
 }
 
+void* NetExpr::operator new(size_t size)
+{
+      return net_arena.alloc(size);
+}
+
+void NetExpr::operator delete(void*obj, size_t size)
+{
+      net_arena.free(obj, size);
+}
+
 ivl_type_t NetExpr::net_type() const
 {
       return net_type_;
@@ -40,37 +40,42 @@ void Nexus::connect(Link&r)
       delete[] name_;
       name_ = 0;
 
-	// Special case: This nexus is empty. Simply copy all the
-	// links of the other nexus to this one, and delete the old
-	// nexus.
+	// Special case: This nexus is empty. Simply take all the
+	// links of the other nexus, and make the old nexus forward
+	// to this one.
       if (list_ == 0) {
 	    if (r.next_ == 0) {
 		  list_ = &r;
 		  r.next_ = &r;
-		  r.nexus_ = this;
+		  r.tail_ = true;
+		  r.set_nexus_(this);
+		  size_ = 1;
 		  driven_ = NO_GUESS;
 	    } else {
 		  driven_ = r_nexus->driven_;
 		  list_ = r_nexus->list_;
-		  list_->nexus_ = this;
+		  size_ = r_nexus->size_;
 		  r_nexus->list_ = 0;
-		  delete r_nexus;
+		  r_nexus->size_ = 0;
+		  r_nexus->forward_to_(this);
 	    }
 	    return;
       }
 
 	// Special case: The Link is unconnected. Put it at the end of
-	// the current list and move the list_ pointer and nexus_ back
-	// pointer to suit.
+	// the current list and move the list_ pointer and tail_ flag
+	// to suit.
       if (r.next_ == 0) {
 	    if (r.get_dir() != Link::INPUT)
 		  driven_ = NO_GUESS;
 
-	    r.nexus_ = this;
+	    r.set_nexus_(this);
 	    r.next_ = list_->next_;
 	    list_->next_ = &r;
-	    list_->nexus_ = 0;
+	    list_->tail_ = false;
+	    r.tail_ = true;
 	    list_ = &r;
+	    size_ += 1;
 	    return;
       }
 
@@ -78,40 +83,51 @@ void Nexus::connect(Link&r)
 	    driven_ = NO_GUESS;
 
 	// Splice the list of links from the "tmp" nexus to the end of
-	// this nexus. Adjust the nexus pointers as needed.
+	// this nexus. The links keep pointing at the old nexus, which
+	// now forwards to this one.
       Link*save_first = list_->next_;
       list_->next_ = r_nexus->list_->next_;
       r_nexus->list_->next_ = save_first;
-      list_->nexus_ = 0;
+      list_->tail_ = false;
       list_ = r_nexus->list_;
-      list_->nexus_ = this;
+      size_ += r_nexus->size_;
 
       r_nexus->list_ = 0;
-      delete r_nexus;
+      r_nexus->size_ = 0;
+      r_nexus->forward_to_(this);
 }
 
 void connect(Link&l, Link&r)
 {
-      Nexus*tmp;
       assert(&l != &r);
+      Nexus*l_nexus = l.next_? l.find_nexus_() : 0;
+      Nexus*r_nexus = r.next_? r.find_nexus_() : 0;
+
 	// If either the l or r link already are part of a Nexus, then
-	// re-use that nexus. Go through some effort so that we are
-	// not gratuitously creating Nexus object.
-      if (l.next_ && (tmp=l.find_nexus_())) {
-	    connect(tmp, r);
-      } else if (r.next_ && (tmp=r.find_nexus_())) {
-	    connect(tmp, l);
+	// re-use that nexus. If both are, the larger nexus absorbs the
+	// smaller one, which keeps the forwarding chains short. Go
+	// through some effort so that we are not gratuitously
+	// creating Nexus object.
+      if (l_nexus && r_nexus) {
+	    if (l_nexus->size_ >= r_nexus->size_)
+		  l_nexus->connect(r);
+	    else
+		  r_nexus->connect(l);
+      } else if (l_nexus) {
+	    l_nexus->connect(r);
+      } else if (r_nexus) {
+	    r_nexus->connect(l);
       } else {
 	      // No existing Nexus (both links are so far unconnected)
 	      // so start one.
-	    tmp = new Nexus(l);
+	    Nexus*tmp = new Nexus(l);
 	    tmp->connect(r);
       }
 }
 
 Link::Link()
 : dir_(PASSIVE), drive0_(IVL_DR_STRONG), drive1_(IVL_DR_STRONG),
-  next_(0), nexus_(0)
+  tail_(false), next_(0), nexus_(0)
 {
       node_ = 0;
       pin_zero_ = true;
@@ -129,12 +145,24 @@ Link::~Link()
 
 Nexus* Link::find_nexus_() const
 {
-      assert(next_);
-      if (nexus_) return nexus_;
-      for (Link*cur = next_ ; cur != this ; cur = cur->next_) {
-	    if (cur->nexus_) return cur->nexus_;
-      }
-      return 0;
+      assert(next_ && nexus_);
+      Nexus*root = nexus_->find_root_();
+      if (root != nexus_)
+	    const_cast<Link*>(this)->set_nexus_(root);
+      return root;
+}
+
+void Link::set_nexus_(Nexus*nex)
+{
+      Nexus*old = nexus_;
+      if (old == nex)
+	    return;
+
+      if (nex)
+	    nex->refs_ += 1;
+      nexus_ = nex;
+      if (old)
+	    Nexus::release_(old);
 }
 
 Nexus* Link::nexus()
@@ -239,13 +267,7 @@ bool Link::is_linked(const Link&that) const
       if (! that.is_linked())
 	    return false;
 
-      const Link*cur = next_;
-      while (cur != this) {
-	    if (cur == &that) return true;
-	    cur = cur->next_;
-      }
-
-      return false;
+      return find_nexus_() == that.find_nexus_();
 }
 
 Nexus::Nexus(Link&that)
@@ -253,32 +275,104 @@ Nexus::Nexus(Link&that)
       name_ = 0;
       driven_ = NO_GUESS;
       t_cookie_ = 0;
+      forward_ = 0;
+      size_ = 0;
+      refs_ = 0;
 
       if (that.next_ == 0) {
 	    list_ = &that;
 	    that.next_ = &that;
-	    that.nexus_ = this;
-	    driven_ = NO_GUESS;
+	    that.tail_ = true;
+	    that.set_nexus_(this);
+	    size_ = 1;
 
       } else {
 	    Nexus*tmp = that.find_nexus_();
 	    list_ = tmp->list_;
-	    list_->nexus_ = this;
+	    size_ = tmp->size_;
 	    driven_ = tmp->driven_;
 	    name_ = tmp->name_;
 
 	    tmp->list_ = 0;
 	    tmp->name_ = 0;
-	    delete tmp;
+	    tmp->size_ = 0;
+	    tmp->forward_to_(this);
       }
 }
 
 Nexus::~Nexus()
 {
-      assert(list_ == 0);
+      assert(list_ == 0 && refs_ == 0);
       delete[] name_;
 }
 
+/*
+ * Find the live Nexus that this (possibly forwarding) Nexus has been
+ * merged into, and point the forwarding nodes along the way directly
+ * at it.
+ */
+Nexus* Nexus::find_root_()
+{
+      Nexus*root = this;
+      while (root->forward_)
+	    root = root->forward_;
+
+      Nexus*cur = this;
+      while (cur->forward_ && cur->forward_ != root) {
+	    Nexus*up = cur->forward_;
+	    cur->forward_ = root;
+	    root->refs_ += 1;
+	      // If this was the last reference to up, then up (and
+	      // maybe more of the chain) is released, and there is
+	      // nothing left to compress.
+	    bool up_live = up->refs_ > 1;
+	    release_(up);
+	    if (! up_live)
+		  break;
+	    cur = up;
+      }
+
+      return root;
+}
+
+/*
+ * Turn this (now empty) Nexus into a forwarding node for root.
+ */
+void Nexus::forward_to_(Nexus*root)
+{
+      assert(list_ == 0 && forward_ == 0 && root != this);
+      delete[] name_;
+      name_ = 0;
+      forward_ = root;
+      root->refs_ += 1;
+
+      if (refs_ == 0) {
+	    refs_ = 1;
+	    release_(this);
+      }
+}
+
+/*
+ * Drop a reference to a Nexus. Forwarding nodes that are no longer
+ * referenced are deleted, and that in turn drops a reference to the
+ * node they forward to. Live nexa are deleted by their owners when
+ * their last link goes away, not here.
+ */
+void Nexus::release_(Nexus*nex)
+{
+      while (nex) {
+	    assert(nex->refs_ > 0);
+	    nex->refs_ -= 1;
+	    if (nex->refs_ > 0 || nex->forward_ == 0)
+		  return;
+
+	    Nexus*up = nex->forward_;
+	    nex->forward_ = 0;
+	    delete nex;
+	    nex = up;
+      }
+}
+
 bool Nexus::assign_lval() const
 {
       for (const Link*cur = first_nlink() ; cur ; cur = cur->next_nlink()) {
@@ -396,12 +490,13 @@ void Nexus::unlink(Link*that)
 	// this case, the unlink is trivial. Also clear the Nexus
 	// pointers.
       if (that->next_ == that) {
-	    assert(that->nexus_ == this);
 	    assert(list_ == that);
 	    list_ = 0;
+	    size_ = 0;
 	    driven_ = NO_GUESS;
-	    that->nexus_ = 0;
 	    that->next_ = 0;
+	    that->tail_ = false;
+	    that->set_nexus_(0);
 	    return;
       }
 
@@ -422,13 +517,14 @@ void Nexus::unlink(Link*that)
 	// If "that" was the last item in the list, then change the
 	// list_ pointer to point to the new end of the list.
       if (list_ == that) {
-	    assert(that->nexus_ == this);
 	    list_ = prev;
-	    list_->nexus_ = this;
+	    list_->tail_ = true;
       }
+      size_ -= 1;
 
-      that->nexus_ = 0;
       that->next_ = 0;
+      that->tail_ = false;
+      that->set_nexus_(0);
 }
 
 Link* Nexus::first_nlink()
@@ -445,18 +541,18 @@ const Link* Nexus::first_nlink() const
 
 /*
  * The t_cookie can be set exactly once. This attaches an ivl_nexus_t
- * object to the Nexus, and causes the Link list to be marked up for
- * efficient use by the code generator. The change is to give all the
- * links a valid nexus_ pointer. This breaks most of the other
- * methods, but they are not used during code generation.
+ * object to the Nexus, and points all the links directly at this
+ * nexus, so that the code generator never needs to follow forwarding
+ * pointers.
 */
 void Nexus::t_cookie(ivl_nexus_t val) const
 {
       assert(val && !t_cookie_);
       t_cookie_ = val;
 
-      for (Link*cur = list_->next_ ; cur->nexus_ == 0 ; cur = cur->next_)
-	    cur->nexus_ = const_cast<Nexus*> (this);
+      Nexus*self = const_cast<Nexus*> (this);
+      for (Link*cur = self->first_nlink() ; cur ; cur = cur->next_nlink())
+	    cur->set_nexus_(self);
 }
 
 unsigned Nexus::vector_width() const
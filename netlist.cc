@@ -986,6 +986,16 @@ NetProc::~NetProc()
 {
 }
 
+void* NetProc::operator new(size_t size)
+{
+      return net_arena.alloc(size);
+}
+
+void NetProc::operator delete(void*obj, size_t size)
+{
+      net_arena.free(obj, size);
+}
+
 NetProcTop::NetProcTop(NetScope*s, ivl_process_type_t t, NetProc*st)
 : type_(t), statement_(st), scope_(s)
 {
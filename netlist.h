@@ -187,14 +187,19 @@ class Link {
       DIR dir_           : 2;
       ivl_drive_t drive0_ : 3;
       ivl_drive_t drive1_ : 3;
+	// True for the last Link in the list of a nexus.
+      bool tail_         : 1;
 
     private:
       Nexus* find_nexus_() const;
+      void set_nexus_(Nexus*);
 
     private:
 	// The Nexus uses these to maintain its list of Link
 	// objects. If this link is not connected to anything,
-	// then these pointers are both nil.
+	// then these pointers are both nil. The nexus_ pointer may
+	// point to a Nexus that has since been merged into another,
+	// so use find_nexus_() to get the real one.
       Link *next_;
       Nexus*nexus_;
 
@@ -345,15 +350,22 @@ class NetBranch  : public NetPins, public IslandBranch {
  * The links in a nexus are grouped into a circularly linked list,
  * with the nexus pointing to the last Link. Each link in turn points
  * to the next link in the nexus, with the last link pointing back to
- * the first. The last link also has a non-nil nexus_ pointer back to
- * this nexus.
+ * the first. The last link is marked with its tail_ flag.
+ *
+ * Each link also points to a Nexus, but that pointer is not updated
+ * when two nexa are merged. Instead, the absorbed Nexus is kept as a
+ * forwarding node that points to the Nexus that absorbed it, making
+ * a union-find forest. Link::find_nexus_() follows the forward_
+ * pointers to the live Nexus, and compresses the path as it goes. So
+ * merging two nexa is constant time no matter how many links they
+ * hold, and finding the nexus of a link is nearly so. The forwarding
+ * nodes are reference counted (by links and other forwarding nodes)
+ * and are deleted when nothing points to them any more.
  *
  * The t_cookie() is an ivl_nexus_t that the code generator uses to
  * store data in the nexus. When a Nexus is created, this cookie is
  * set to nil. The code generator may set the cookie once. This locks
- * the nexus, and rewrites the Link list to be optimal for the code
- * generator. In the process, *all* of the other methods are no longer
- * functional.
+ * the nexus, and points all the links straight at it.
  */
 class Nexus {
 
@@ -426,6 +438,17 @@ class Nexus {
       Link*list_;
       void unlink(Link*);
 
+	// Union-find support. A merged Nexus has a forward_ pointer
+	// to the Nexus that absorbed it. The size_ is the number of
+	// links in the list_, and refs_ is the number of links and
+	// forwarding nodes that point to this Nexus.
+      Nexus*forward_;
+      unsigned size_;
+      unsigned refs_;
+      Nexus* find_root_();
+      void forward_to_(Nexus*root);
+      static void release_(Nexus*nex);
+
       mutable char* name_; /* Cache the calculated name for the Nexus. */
       mutable ivl_nexus_t t_cookie_;
 
@@ -2001,6 +2024,10 @@ class NetExpr  : public LineInfo {
       explicit NetExpr(ivl_type_t t);
       virtual ~NetExpr() =0;
 
+	// NetExpr objects live in the net_arena (see compiler.h).
+      static void* operator new(size_t size);
+      static void  operator delete(void*obj, size_t size);
+
       virtual void expr_scan(struct expr_scan_t*) const =0;
       virtual void dump(std::ostream&) const;
 
@@ -2655,6 +2682,10 @@ class NetProc : public virtual LineInfo {
       explicit NetProc();
       virtual ~NetProc();
 
+	// NetProc objects live in the net_arena (see compiler.h).
+      static void* operator new(size_t size);
+      static void  operator delete(void*obj, size_t size);
+
 	// Find the nexa that are input by the statement. This is used
 	// for example by @* to find the inputs to the process for the
 	// sensitivity list.
@@ -5223,18 +5254,17 @@ inline __ObjectPathManip scope_path(const NetObj*obj)
 extern std::ostream& operator << (std::ostream&o, __ObjectPathManip);
 
 /*
- * If this link has a nexus_ pointer, then it is the last Link in the
- * list. next_nlink() returns 0 for the last Link.
+ * next_nlink() returns 0 for the last Link in the list.
  */
 inline Link* Link::next_nlink()
 {
-      if (nexus_) return 0;
+      if (tail_) return 0;
       else return next_;
 }
 
 inline const Link* Link::next_nlink() const
 {
-      if (nexus_) return 0;
+      if (tail_) return 0;
       else return next_;
 }
 
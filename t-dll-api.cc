@@ -107,6 +107,30 @@ extern "C" void ivl_design_roots(ivl_design_t des, ivl_scope_t **scopes,
       *nscopes = des->root_scope_list.size();
 }
 
+static void design_scopes_preorder(ivl_design_t des, ivl_scope_t scope)
+{
+      des->all_scope_list.push_back(scope);
+      for (size_t idx = 0 ; idx < scope->child.size() ; idx += 1)
+	    design_scopes_preorder(des, scope->child[idx]);
+}
+
+extern "C" void ivl_design_scopes(ivl_design_t des, ivl_scope_t **scopes,
+				  unsigned int *nscopes)
+{
+      assert(des);
+      assert(nscopes && scopes);
+      if (des->all_scope_list.size() == 0) {
+	    ivl_scope_t*roots;
+	    unsigned nroots;
+	    ivl_design_roots(des, &roots, &nroots);
+	    for (unsigned idx = 0 ; idx < nroots ; idx += 1)
+		  design_scopes_preorder(des, roots[idx]);
+      }
+
+      *scopes = des->all_scope_list.empty()? 0 : &des->all_scope_list[0];
+      *nscopes = des->all_scope_list.size();
+}
+
 extern "C" int ivl_design_time_precision(ivl_design_t des)
 {
       assert(des);
@@ -1793,6 +1817,34 @@ extern "C" ivl_nexus_ptr_t ivl_nexus_ptr(ivl_nexus_t net, unsigned idx)
       return & net->ptrs_[idx];
 }
 
+extern "C" void ivl_nexus_ptr_array(ivl_nexus_t net, ivl_nexus_ptr_t **ptrs,
+				    unsigned *nptrs, unsigned *ndrivers)
+{
+      assert(net);
+      assert(ptrs && nptrs);
+      if (net->ptr_array_ == 0) {
+	    size_t cnt = net->ptrs_.size();
+	    net->ptr_array_ = new ivl_nexus_ptr_t[cnt];
+	    size_t fill = 0;
+	    for (size_t idx = 0 ; idx < cnt ; idx += 1) {
+		  ivl_nexus_ptr_t cur = &net->ptrs_[idx];
+		  if (cur->drive0 != IVL_DR_HiZ || cur->drive1 != IVL_DR_HiZ)
+			net->ptr_array_[fill++] = cur;
+	    }
+	    net->ptr_drivers_ = fill;
+	    for (size_t idx = 0 ; idx < cnt ; idx += 1) {
+		  ivl_nexus_ptr_t cur = &net->ptrs_[idx];
+		  if (cur->drive0 == IVL_DR_HiZ && cur->drive1 == IVL_DR_HiZ)
+			net->ptr_array_[fill++] = cur;
+	    }
+	    assert(fill == cnt);
+      }
+
+      *ptrs = net->ptr_array_;
+      *nptrs = net->ptrs_.size();
+      if (ndrivers) *ndrivers = net->ptr_drivers_;
+}
+
 extern "C" ivl_drive_t ivl_nexus_ptr_drive0(ivl_nexus_ptr_t net)
 {
       assert(net);
@@ -2355,6 +2407,15 @@ extern "C" ivl_signal_t ivl_scope_sig(ivl_scope_t net, unsigned idx)
       return net->sigs_[idx];
 }
 
+extern "C" void ivl_scope_sig_array(ivl_scope_t net, ivl_signal_t **sigs,
+				    unsigned *nsigs)
+{
+      assert(net);
+      assert(sigs && nsigs);
+      *sigs = net->sigs_.empty()? 0 : &net->sigs_[0];
+      *nsigs = net->sigs_.size();
+}
+
 extern "C" unsigned ivl_scope_switches(ivl_scope_t net)
 {
       assert(net);
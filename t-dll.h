@@ -619,11 +619,15 @@ struct ivl_nexus_ptr_s {
  * NOTE: ONLY allocate ivl_nexus_s objects with the included "new" operator.
  */
 struct ivl_nexus_s {
-      ivl_nexus_s() : ptrs_(1), nexus_(0), name_(0), private_data(0) { }
+      ivl_nexus_s() : ptrs_(1), nexus_(0), name_(0), private_data(0),
+		      ptr_array_(0), ptr_drivers_(0) { }
       std::vector<ivl_nexus_ptr_s>ptrs_;
       const Nexus*nexus_;
       const char*name_;
       void*private_data;
+	// This is used to implement the ivl_nexus_ptr_array function.
+      ivl_nexus_ptr_t*ptr_array_;
+      unsigned ptr_drivers_;
 
       void* operator new (size_t s);
       void  operator delete(void*obj, size_t s); // Not implemented
@@ -54,12 +54,9 @@ static void draw_enum2_value(ivl_enumtype_t enumtype, unsigned idx)
 static void draw_enum4_value(ivl_enumtype_t enumtype, unsigned idx)
 {
       const char*bits = ivl_enum_bits(enumtype, idx);
-      const char*bit;
 
       fprintf(vvp_out, "%u'b", ivl_enum_width(enumtype));
-
-      for (bit = bits+strlen(bits) ; bit > bits ; bit -= 1)
-	    fputc(bit[-1], vvp_out);
+      draw_vec4_bits(bits, strlen(bits));
 
 }
 
@@ -0,0 +1,509 @@
+/*
+ * Copyright (c) 2026 the Icarus Verilog contributors
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "vvp_priv.h"
+# include  <assert.h>
+# include  <stdlib.h>
+# include  <string.h>
+
+/*
+ * LOGIC CONES
+ * Continuous assignments of bit expressions elaborate into chains of
+ * small gates joined by compiler generated (local) nets. Each gate
+ * becomes a separate vvp functor with its own propagation step, even
+ * though nothing can observe the nets between them. This pass finds
+ * zero-delay, fanout-free cones of such gates and draws each cone as
+ * a single .functor LUT with a truth table of its inputs.
+ *
+ * A gate is absorbed into the gate it drives only if:
+ *
+ *   - both are 1-bit AND/OR/XOR/NAND/NOR/XNOR/NOT/BUF gates with no
+ *     delay and strong drive,
+ *
+ *   - the net between them carries only local signals (so nothing
+ *     is VPI visible or dumped), is not forced, and is not watched by
+ *     an event, and
+ *
+ *   - the gate it drives is the only receiver of the net.
+ *
+ * The number of distinct inputs to a cone is limited to lut_inputs,
+ * which is at most 4 because that is the number of ports of a vvp
+ * functor. The -plut_inputs=N flag sets this limit, and 0 disables
+ * the pass.
+ */
+
+unsigned lut_inputs = 4;
+
+# define LUT_MAX_INPUTS 4
+
+static struct vvp_nexus_data*nexus_data(ivl_nexus_t nex)
+{
+      struct vvp_nexus_data*nex_data = (struct vvp_nexus_data*)
+	    ivl_nexus_get_private(nex);
+      if (nex_data == 0) {
+	    nex_data = calloc(1, sizeof(struct vvp_nexus_data));
+	    ivl_nexus_set_private(nex, nex_data);
+      }
+      return nex_data;
+}
+
+static int nexus_flag_test(ivl_nexus_t nex, int flag)
+{
+      struct vvp_nexus_data*nex_data = (struct vvp_nexus_data*)
+	    ivl_nexus_get_private(nex);
+      return nex_data && (nex_data->flags & flag);
+}
+
+/*
+ * Return true if this is a gate that can be part of a cone.
+ */
+static int lut_gate_ok(ivl_net_logic_t lptr)
+{
+      unsigned pdx;
+
+      switch (ivl_logic_type(lptr)) {
+	  case IVL_LO_AND:
+	  case IVL_LO_NAND:
+	  case IVL_LO_OR:
+	  case IVL_LO_NOR:
+	  case IVL_LO_XOR:
+	  case IVL_LO_XNOR:
+	    if (ivl_logic_pins(lptr) < 3)
+		  return 0;
+	    break;
+	  case IVL_LO_BUF:
+	  case IVL_LO_NOT:
+	    if (ivl_logic_pins(lptr) != 2)
+		  return 0;
+	    break;
+	  default:
+	    return 0;
+      }
+
+      if (ivl_logic_width(lptr) != 1)
+	    return 0;
+      if (ivl_logic_pins(lptr) - 1 > LUT_MAX_INPUTS)
+	    return 0;
+      if (ivl_logic_delay(lptr, 0) != 0)
+	    return 0;
+      if (ivl_logic_drive0(lptr) != IVL_DR_STRONG)
+	    return 0;
+      if (ivl_logic_drive1(lptr) != IVL_DR_STRONG)
+	    return 0;
+      if (ivl_scope_is_auto(ivl_logic_scope(lptr)))
+	    return 0;
+
+      for (pdx = 0 ; pdx < ivl_logic_pins(lptr) ; pdx += 1) {
+	    if (ivl_logic_pin(lptr, pdx) == 0)
+		  return 0;
+      }
+
+      return 1;
+}
+
+/*
+ * If the nexus is the output of a gate that can be absorbed into the
+ * gate that it drives, return the driving gate. The receiver argument
+ * is the gate that would absorb it.
+ */
+static ivl_net_logic_t absorbable_driver(ivl_nexus_t nex,
+					 ivl_net_logic_t receiver)
+{
+      ivl_net_logic_t driver = 0;
+      unsigned idx;
+
+      if (nexus_flag_test(nex, VVP_NEXUS_DATA_PINNED))
+	    return 0;
+
+      for (idx = 0 ; idx < ivl_nexus_ptrs(nex) ; idx += 1) {
+	    ivl_nexus_ptr_t ptr = ivl_nexus_ptr(nex, idx);
+	    ivl_signal_t sig = ivl_nexus_ptr_sig(ptr);
+	    ivl_net_logic_t log = ivl_nexus_ptr_log(ptr);
+
+	    if (sig) {
+		  if (! ivl_signal_local(sig))
+			return 0;
+		  if (ivl_signal_forced_net(sig))
+			return 0;
+		  continue;
+	    }
+
+	    if (log == 0)
+		  return 0;
+
+	    if (log == receiver) {
+		  if (ivl_nexus_ptr_pin(ptr) == 0)
+			return 0;
+		  continue;
+	    }
+
+	    if (driver || ivl_nexus_ptr_pin(ptr) != 0)
+		  return 0;
+
+	    driver = log;
+      }
+
+      if (driver == 0 || ! lut_gate_ok(driver))
+	    return 0;
+
+      return driver;
+}
+
+/*
+ * Return the gate that drives an absorbed nexus.
+ */
+static ivl_net_logic_t absorbed_driver(ivl_nexus_t nex)
+{
+      unsigned idx;
+      for (idx = 0 ; idx < ivl_nexus_ptrs(nex) ; idx += 1) {
+	    ivl_nexus_ptr_t ptr = ivl_nexus_ptr(nex, idx);
+	    ivl_net_logic_t log = ivl_nexus_ptr_log(ptr);
+	    if (log && ivl_nexus_ptr_pin(ptr) == 0)
+		  return log;
+      }
+      assert(0);
+      return 0;
+}
+
+static unsigned leaf_index(ivl_nexus_t*leaves, unsigned nleaves,
+			   ivl_nexus_t nex)
+{
+      unsigned idx;
+      for (idx = 0 ; idx < nleaves ; idx += 1) {
+	    if (leaves[idx] == nex)
+		  return idx;
+      }
+      return nleaves;
+}
+
+/*
+ * A work list of the gates that are, or may yet become, cone roots.
+ */
+static ivl_net_logic_t*root_list = 0;
+static unsigned root_count = 0;
+static unsigned root_alloc = 0;
+
+static void push_root(ivl_net_logic_t lptr)
+{
+      if (root_count == root_alloc) {
+	    root_alloc = root_alloc? 2*root_alloc : 256;
+	    root_list = realloc(root_list, root_alloc*sizeof(ivl_net_logic_t));
+      }
+      root_list[root_count++] = lptr;
+}
+
+/*
+ * Grow the cone under this root, marking the nets that it absorbs.
+ * Gates that would make the cone too wide are left to be the roots
+ * of their own cones.
+ */
+static void grow_cone(ivl_net_logic_t root)
+{
+      ivl_nexus_t leaves[LUT_MAX_INPUTS + 1];
+      ivl_net_logic_t owners[LUT_MAX_INPUTS + 1];
+      unsigned nleaves = 0;
+      unsigned pdx, idx;
+
+      for (pdx = 1 ; pdx < ivl_logic_pins(root) ; pdx += 1) {
+	    ivl_nexus_t nex = ivl_logic_pin(root, pdx);
+	    if (leaf_index(leaves, nleaves, nex) < nleaves)
+		  continue;
+	    leaves[nleaves] = nex;
+	    owners[nleaves] = root;
+	    nleaves += 1;
+      }
+
+      idx = 0;
+      while (idx < nleaves) {
+	    ivl_net_logic_t drv = absorbable_driver(leaves[idx], owners[idx]);
+	    ivl_nexus_t add[LUT_MAX_INPUTS];
+	    unsigned nadd = 0;
+
+	    if (drv == 0) {
+		  idx += 1;
+		  continue;
+	    }
+
+	    for (pdx = 1 ; pdx < ivl_logic_pins(drv) ; pdx += 1) {
+		  ivl_nexus_t nex = ivl_logic_pin(drv, pdx);
+		  if (leaf_index(leaves, nleaves, nex) < nleaves)
+			continue;
+		  if (leaf_index(add, nadd, nex) < nadd)
+			continue;
+		  add[nadd++] = nex;
+	    }
+
+	    if (nleaves - 1 + nadd > lut_inputs) {
+		  push_root(drv);
+		  idx += 1;
+		  continue;
+	    }
+
+	      /* Absorb the driver. Its inputs replace the absorbed
+		 net in the leaf list, and are examined in turn. */
+	    nexus_data(leaves[idx])->flags |= VVP_NEXUS_DATA_LUT;
+	    nleaves -= 1;
+	    for (pdx = idx ; pdx < nleaves ; pdx += 1) {
+		  leaves[pdx] = leaves[pdx+1];
+		  owners[pdx] = owners[pdx+1];
+	    }
+	    for (pdx = 0 ; pdx < nadd ; pdx += 1) {
+		  leaves[nleaves] = add[pdx];
+		  owners[nleaves] = drv;
+		  nleaves += 1;
+	    }
+      }
+}
+
+static void pin_event_nexus(ivl_event_t evt)
+{
+      unsigned idx;
+      for (idx = 0 ; idx < ivl_event_nany(evt) ; idx += 1)
+	    nexus_data(ivl_event_any(evt, idx))->flags |= VVP_NEXUS_DATA_PINNED;
+      for (idx = 0 ; idx < ivl_event_nneg(evt) ; idx += 1)
+	    nexus_data(ivl_event_neg(evt, idx))->flags |= VVP_NEXUS_DATA_PINNED;
+      for (idx = 0 ; idx < ivl_event_npos(evt) ; idx += 1)
+	    nexus_data(ivl_event_pos(evt, idx))->flags |= VVP_NEXUS_DATA_PINNED;
+      for (idx = 0 ; idx < ivl_event_nedg(evt) ; idx += 1)
+	    nexus_data(ivl_event_edg(evt, idx))->flags |= VVP_NEXUS_DATA_PINNED;
+}
+
+static int pin_scope_events(ivl_scope_t scope, void*cd)
+{
+      unsigned idx;
+      for (idx = 0 ; idx < ivl_scope_events(scope) ; idx += 1)
+	    pin_event_nexus(ivl_scope_event(scope, idx));
+
+      return ivl_scope_children(scope, pin_scope_events, cd);
+}
+
+/*
+ * The initial roots are the gates that cannot be absorbed into the
+ * gate that they drive.
+ */
+static int find_scope_roots(ivl_scope_t scope, void*cd)
+{
+      unsigned idx;
+      for (idx = 0 ; idx < ivl_scope_logs(scope) ; idx += 1) {
+	    ivl_net_logic_t lptr = ivl_scope_log(scope, idx);
+	    ivl_nexus_t out;
+	    unsigned pdx;
+	    ivl_net_logic_t receiver = 0;
+
+	    if (! lut_gate_ok(lptr))
+		  continue;
+
+	      /* Find the only gate that receives the output. If there
+		 is not exactly one, this is a root. */
+	    out = ivl_logic_pin(lptr, 0);
+	    for (pdx = 0 ; pdx < ivl_nexus_ptrs(out) ; pdx += 1) {
+		  ivl_nexus_ptr_t ptr = ivl_nexus_ptr(out, pdx);
+		  ivl_net_logic_t log = ivl_nexus_ptr_log(ptr);
+		  if (log == 0 || log == lptr)
+			continue;
+		  receiver = log;
+		  break;
+	    }
+
+	    if (receiver == 0 || ! lut_gate_ok(receiver)
+		|| absorbable_driver(out, receiver) != lptr)
+		  push_root(lptr);
+      }
+
+      return ivl_scope_children(scope, find_scope_roots, cd);
+}
+
+void collapse_logic_cones(ivl_design_t des)
+{
+      ivl_scope_t*roots;
+      unsigned nroots, idx;
+
+      if (lut_inputs < 2)
+	    return;
+
+      ivl_design_roots(des, &roots, &nroots);
+
+      for (idx = 0 ; idx < nroots ; idx += 1)
+	    pin_scope_events(roots[idx], 0);
+      for (idx = 0 ; idx < nroots ; idx += 1)
+	    find_scope_roots(roots[idx], 0);
+
+	/* Growing a cone may push more roots onto the list. */
+      for (idx = 0 ; idx < root_count ; idx += 1)
+	    grow_cone(root_list[idx]);
+
+      free(root_list);
+      root_list = 0;
+      root_count = 0;
+      root_alloc = 0;
+}
+
+/*
+ * Collect the leaves of the cone under a gate, in the order that
+ * they are first reached by a depth first walk of the input pins.
+ */
+static void collect_leaves(ivl_net_logic_t lptr, ivl_nexus_t*leaves,
+			   unsigned*nleaves)
+{
+      unsigned pdx;
+      for (pdx = 1 ; pdx < ivl_logic_pins(lptr) ; pdx += 1) {
+	    ivl_nexus_t nex = ivl_logic_pin(lptr, pdx);
+	    if (nexus_flag_test(nex, VVP_NEXUS_DATA_LUT)) {
+		  collect_leaves(absorbed_driver(nex), leaves, nleaves);
+		  continue;
+	    }
+	    if (leaf_index(leaves, *nleaves, nex) < *nleaves)
+		  continue;
+	    assert(*nleaves < LUT_MAX_INPUTS);
+	    leaves[(*nleaves)++] = nex;
+      }
+}
+
+/*
+ * Evaluate the cone under a gate with the leaves set to the given
+ * values. Values are 0, 1 or 2 for x. The gates of a cone never drive
+ * z, and a z input behaves like an x, so three values are enough.
+ */
+static int eval_cone(ivl_net_logic_t lptr, ivl_nexus_t*leaves,
+		     unsigned nleaves, const int*vals)
+{
+      unsigned pdx;
+      int res = -1;
+      int invert = 0;
+
+      for (pdx = 1 ; pdx < ivl_logic_pins(lptr) ; pdx += 1) {
+	    ivl_nexus_t nex = ivl_logic_pin(lptr, pdx);
+	    int val;
+	    if (nexus_flag_test(nex, VVP_NEXUS_DATA_LUT))
+		  val = eval_cone(absorbed_driver(nex), leaves, nleaves, vals);
+	    else
+		  val = vals[leaf_index(leaves, nleaves, nex)];
+
+	    if (res < 0) {
+		  res = val;
+		  continue;
+	    }
+
+	    switch (ivl_logic_type(lptr)) {
+		case IVL_LO_AND:
+		case IVL_LO_NAND:
+		  if (res == 0 || val == 0)
+			res = 0;
+		  else if (res == 2 || val == 2)
+			res = 2;
+		  break;
+		case IVL_LO_OR:
+		case IVL_LO_NOR:
+		  if (res == 1 || val == 1)
+			res = 1;
+		  else if (res == 2 || val == 2)
+			res = 2;
+		  break;
+		case IVL_LO_XOR:
+		case IVL_LO_XNOR:
+		  if (res == 2 || val == 2)
+			res = 2;
+		  else
+			res ^= val;
+		  break;
+		default:
+		  assert(0);
+		  break;
+	    }
+      }
+
+      switch (ivl_logic_type(lptr)) {
+	  case IVL_LO_NAND:
+	  case IVL_LO_NOR:
+	  case IVL_LO_XNOR:
+	  case IVL_LO_NOT:
+	    invert = 1;
+	    break;
+	  default:
+	    break;
+      }
+
+      if (invert && res != 2)
+	    res = !res;
+
+      return res;
+}
+
+/*
+ * Draw the gate as a LUT if it is the root of a cone that absorbed
+ * other gates, and return true. If it is a gate absorbed into a cone,
+ * draw nothing and return true. Otherwise return false and let the
+ * caller draw the gate normally.
+ */
+int draw_logic_lut(ivl_net_logic_t lptr)
+{
+      ivl_nexus_t leaves[LUT_MAX_INPUTS];
+      const char*input_strings[LUT_MAX_INPUTS];
+      int vals[LUT_MAX_INPUTS];
+      unsigned nleaves = 0;
+      unsigned ntable, idx, pdx;
+      char*table;
+      int absorbed = 0;
+
+      if (nexus_flag_test(ivl_logic_pin(lptr, 0), VVP_NEXUS_DATA_LUT)) {
+	    fprintf(vvp_out, "; Gate L_%p is absorbed into a logic cone\n",
+		    lptr);
+	    return 1;
+      }
+
+      if (! lut_gate_ok(lptr))
+	    return 0;
+
+      for (pdx = 1 ; pdx < ivl_logic_pins(lptr) ; pdx += 1) {
+	    if (nexus_flag_test(ivl_logic_pin(lptr, pdx), VVP_NEXUS_DATA_LUT))
+		  absorbed = 1;
+      }
+      if (! absorbed)
+	    return 0;
+
+      collect_leaves(lptr, leaves, &nleaves);
+      for (idx = 0 ; idx < nleaves ; idx += 1)
+	    input_strings[idx] = draw_net_input(leaves[idx]);
+
+	/* The table has an entry for each combination of 0, 1 and x
+	   on the inputs. The first input is the least significant
+	   digit of the (base 3) entry number. */
+      ntable = 1;
+      for (idx = 0 ; idx < nleaves ; idx += 1)
+	    ntable *= 3;
+
+      table = malloc(ntable + 1);
+      for (idx = 0 ; idx < ntable ; idx += 1) {
+	    unsigned tmp = idx;
+	    for (pdx = 0 ; pdx < nleaves ; pdx += 1) {
+		  vals[pdx] = tmp % 3;
+		  tmp /= 3;
+	    }
+	    table[idx] = "01x"[eval_cone(lptr, leaves, nleaves, vals)];
+      }
+      table[ntable] = 0;
+
+      fprintf(vvp_out, "L_%p .functor LUT 1, \"%s\"", lptr, table);
+      for (idx = 0 ; idx < nleaves ; idx += 1)
+	    fprintf(vvp_out, ", %s", input_strings[idx]);
+      fprintf(vvp_out, ";\n");
+
+      free(table);
+      return 1;
+}
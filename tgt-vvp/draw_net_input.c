@@ -599,9 +599,15 @@ static void draw_net_input_x(ivl_nexus_t nex,
       }
 
 
-      for (idx = 0 ;  idx < ivl_nexus_ptrs(nex) ;  idx += 1) {
+	/* The ptr array lists the drivers first, then the
+	   receivers. */
+      ivl_nexus_ptr_t*ptrs;
+      unsigned nptrs, nptr_drivers;
+      ivl_nexus_ptr_array(nex, &ptrs, &nptrs, &nptr_drivers);
+
+      for (idx = 0 ;  idx < nptrs ;  idx += 1) {
 	    ivl_switch_t sw = 0;
-	    ivl_nexus_ptr_t nptr = ivl_nexus_ptr(nex, idx);
+	    ivl_nexus_ptr_t nptr = ptrs[idx];
 
 	      /* If this object is part of an island, then we'll be
 	         making a port. If this nexus is an output from any
@@ -623,8 +629,7 @@ static void draw_net_input_x(ivl_nexus_t nex,
 	    }
 
 	      /* Skip input only pins. */
-	    if ((ivl_nexus_ptr_drive0(nptr) == IVL_DR_HiZ)
-		&& (ivl_nexus_ptr_drive1(nptr) == IVL_DR_HiZ))
+	    if (idx >= nptr_drivers)
 		  continue;
 
 	      /* Mark the strength-aware flag if the driver can
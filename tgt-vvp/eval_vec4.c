@@ -917,9 +917,16 @@ static void draw_property_vec4(ivl_expr_t expr)
 {
       ivl_signal_t sig = ivl_expr_signal(expr);
       unsigned pidx = ivl_expr_property_idx(expr);
+      ivl_type_t sig_type = ivl_signal_net_type(sig);
+      const char*suff = "";
+
+	/* A 4-state property can be pushed directly. */
+      if (ivl_type_base(sig_type) == IVL_VT_CLASS
+	  && ivl_type_base(ivl_type_prop_type(sig_type, pidx)) == IVL_VT_LOGIC)
+	    suff = "4";
 
       fprintf(vvp_out, "    %%load/obj v%p_0;\n", sig);
-      fprintf(vvp_out, "    %%prop/v %u;\n", pidx);
+      fprintf(vvp_out, "    %%prop/v%s %u;\n", suff, pidx);
       fprintf(vvp_out, "    %%pop/obj 1, 0;\n");
 }
 
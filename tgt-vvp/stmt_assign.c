@@ -471,8 +471,11 @@ static void store_vec4_to_lval(ivl_statement_t net)
 
 		  ivl_type_t sub_type = draw_lval_expr(nest);
 		  assert(ivl_type_base(sub_type) == IVL_VT_CLASS);
-		  fprintf(vvp_out, "    %%store/prop/v %d, %u;\n",
-			  ivl_lval_property_idx(lval), lwid);
+		  int prop_idx = ivl_lval_property_idx(lval);
+		  ivl_type_t prop_type = ivl_type_prop_type(sub_type, prop_idx);
+		  fprintf(vvp_out, "    %%store/prop/v%s %d, %u;\n",
+			  ivl_type_base(prop_type)==IVL_VT_LOGIC? "4" : "",
+			  prop_idx, lwid);
 		  fprintf(vvp_out, "    %%pop/obj 1, 0;\n");
 
 	    } else {
@@ -1231,7 +1234,7 @@ static int show_stmt_assign_sig_cobject(ivl_statement_t net)
 		  draw_eval_vec4(rval);
 
 		  fprintf(vvp_out, "    %%load/obj v%p_0;\n", sig);
-		  fprintf(vvp_out, "    %%store/prop/v %d, %u; Store in logic property %s\n",
+		  fprintf(vvp_out, "    %%store/prop/v4 %d, %u; Store in logic property %s\n",
 			  prop_idx, lwid, ivl_type_prop_name(sig_type, prop_idx));
 		  fprintf(vvp_out, "    %%pop/obj 1, 0;\n");
 
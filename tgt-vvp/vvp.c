@@ -25,6 +25,9 @@
 # include  <stdlib.h>
 # include  <sys/types.h>
 # include  <sys/stat.h>
+#ifdef HAVE_STDIO_EXT_H
+# include  <stdio_ext.h>
+#endif
 
 static const char*version_string =
 "Icarus Verilog VVP Code Generator " VERSION " (" VERSION_TAG ")\n\n"
@@ -49,6 +52,7 @@ int vvp_errors = 0;
 unsigned show_file_line = 0;
 
 int debug_draw = 0;
+int debug_opt = 0;
 
 /* This needs to match the actual flag count in the VVP thread. */
 # define FLAGS_COUNT 512
@@ -131,6 +135,7 @@ static void process_debug_string(const char*debug_string)
 {
       const char*cp = debug_string;
       debug_draw = 0;
+      debug_opt = 0;
 
       while (*cp) {
 	    const char*tail = strchr(cp, ',');
@@ -141,6 +146,9 @@ static void process_debug_string(const char*debug_string)
 	    if (len == 4 && strncmp(cp,"draw", 4)==0) {
 		  debug_draw = 1;
 	    }
+	    if (len == 3 && strncmp(cp,"opt", 3)==0) {
+		  debug_opt = 1;
+	    }
 
 	    while (*tail == ',')
 		  tail += 1;
@@ -165,6 +173,12 @@ int target_design(ivl_design_t des)
 
       const char*debug_flags = ivl_design_flag(des, "debug_flags");
       process_debug_string(debug_flags);
+	/* Use -plut_inputs to set the largest number of inputs to a
+	 * collapsed logic cone (e.g. -plut_inputs=0 to disable). */
+      const char*lut_flag = ivl_design_flag(des, "lut_inputs");
+	/* Use -popt_level to select the thread code peephole passes
+	 * (e.g. -popt_level=2). The default is no optimization. */
+      const char*opt_flag = ivl_design_flag(des, "opt_level");
 
       assert(path);
 
@@ -194,6 +208,32 @@ int target_design(ivl_design_t des)
             show_file_line = fl_value > 0;
       }
 
+        /* Check to see if the logic cone size is limited. */
+      if (strcmp(lut_flag, "") != 0) {
+            char *eptr;
+            long lut_value = strtol(lut_flag, &eptr, 0);
+            if (lut_flag == eptr || *eptr != 0 || lut_value < 0) {
+                  fprintf(stderr, "vvp.tgt error: Invalid logic cone input "
+                                  "limit: %s\n", lut_flag);
+                  return 1;
+            }
+            if (lut_value > 4) lut_value = 4;
+            lut_inputs = lut_value;
+      }
+
+        /* Check to see if the thread code is to be optimized. */
+      if (strcmp(opt_flag, "") != 0) {
+            char *eptr;
+            long opt_value = strtol(opt_flag, &eptr, 0);
+            if (opt_flag == eptr || *eptr != 0 || opt_value < 0) {
+                  fprintf(stderr, "vvp.tgt error: Invalid optimization "
+                                  "level: %s\n", opt_flag);
+                  return 1;
+            }
+            if (opt_value > 2) opt_value = 2;
+            opt_level = opt_value;
+      }
+
 #ifdef HAVE_FOPEN64
       vvp_out = fopen64(path, "w");
 #else
@@ -204,6 +244,15 @@ int target_design(ivl_design_t des)
 	    return -1;
       }
 
+	/* The output is written by a very large number of small
+	   fprintf calls, so give it a large buffer, and (where the C
+	   library allows it) skip the stream locking on each call,
+	   since this is the only thread that writes the file. */
+      setvbuf(vvp_out, 0, _IOFBF, 1024*1024);
+#if defined(HAVE_STDIO_EXT_H) && defined(FSETLOCKING_BYCALLER)
+      __fsetlocking(vvp_out, FSETLOCKING_BYCALLER);
+#endif
+
       vvp_errors = 0;
 
       draw_execute_header(des);
@@ -222,6 +271,9 @@ int target_design(ivl_design_t des)
 
       draw_module_declarations(des);
 
+        /* Find the logic cones before any of the gates are drawn. */
+      collapse_logic_cones(des);
+
         /* This causes all structural records to be drawn. */
       ivl_design_roots(des, &roots, &nroots);
       for (i = 0; i < nroots; i++)
@@ -242,6 +294,7 @@ int target_design(ivl_design_t des)
 
       fclose(vvp_out);
       EOC_cleanup_drivers();
+      peephole_report();
 
       return rc + vvp_errors;
 }
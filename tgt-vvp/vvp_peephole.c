@@ -0,0 +1,778 @@
+/*
+ * Copyright (c) 2026 the Icarus Verilog contributors
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "vvp_priv.h"
+# include  <assert.h>
+# include  <stdlib.h>
+# include  <string.h>
+# include  <ctype.h>
+
+/*
+ * PEEPHOLE OPTIMIZATION
+ * The statement code generators emit thread code one statement at a
+ * time, so the generated code has the usual seams: jumps to jumps,
+ * jumps to the very next instruction, unreachable code after an
+ * unconditional jump, and constants that are pushed and then
+ * immediately resized. This pass collects the code of one thread (a
+ * process, task or function definition) in a temporary file, cleans
+ * it up, and copies the result to the real output.
+ *
+ * The pass works on the text of the generated code. A line that
+ * starts in column 0 is a label, a line that starts with white space
+ * and a % is an instruction, and a line that starts with white space
+ * and a ; is a comment. Anything else (directives, continued lines)
+ * is a barrier that is never moved or removed. Labels are never
+ * removed either, since a %fork or %jmp from anywhere may name them.
+ *
+ * The -popt_level=N flag selects the passes:
+ *
+ *   1 - jump threading, removal of jumps to the next instruction and
+ *       removal of unreachable code,
+ *
+ *   2 - as 1, folding of %pushi/vec4 followed by %pad/u or %pad/s
+ *       into a single %pushi/vec4 of the final width, removal of
+ *       values that are pushed and then popped unused, and removal of
+ *       %ix/load and %flag_set/imm instructions that set a register
+ *       to the value it is already known to hold.
+ *
+ * The default is 0, which writes the code directly to the output.
+ */
+
+unsigned opt_level = 0;
+
+static unsigned long count_insn_in = 0;
+static unsigned long count_insn_out = 0;
+
+enum line_kind_e {
+      LINE_INSN,     /* "    %op ...;" */
+      LINE_COMMENT,  /* "    ; ..." */
+      LINE_LABEL,    /* "label ;" possibly followed by a comment */
+      LINE_LABEL_OP, /* "label %op ...;" */
+      LINE_OTHER     /* directives, continued lines, etc. */
+};
+
+struct peep_line {
+      char*text;
+      enum line_kind_e kind;
+      unsigned char deleted;
+	/* The text was allocated by a rewrite (otherwise it points
+	   into the load buffer). */
+      unsigned char allocated;
+	/* Label lines: the label name. */
+      char*label;
+};
+
+struct peep_label {
+      const char*name;
+      unsigned line;
+};
+
+static FILE*real_out = 0;
+static FILE*peep_file = 0;
+static unsigned peep_depth = 0;
+
+static struct peep_line*lines = 0;
+static unsigned nlines = 0;
+static struct peep_label*labels = 0;
+static unsigned nlabels = 0;
+
+static int compare_labels(const void*a, const void*b)
+{
+      const struct peep_label*la = (const struct peep_label*)a;
+      const struct peep_label*lb = (const struct peep_label*)b;
+      return strcmp(la->name, lb->name);
+}
+
+static int find_label(const char*name)
+{
+      struct peep_label key;
+      struct peep_label*cur;
+      key.name = name;
+      key.line = 0;
+      cur = bsearch(&key, labels, nlabels, sizeof(struct peep_label),
+		    compare_labels);
+      return cur ? (int)cur->line : -1;
+}
+
+static void classify_line(struct peep_line*cur)
+{
+      char*cp = cur->text;
+      cur->deleted = 0;
+      cur->allocated = 0;
+      cur->label = 0;
+
+      if (isalpha((unsigned char)cp[0]) || cp[0] == '_') {
+	    size_t len = strcspn(cp, " \t;");
+	    const char*tail = cp + len;
+	    while (*tail == ' ' || *tail == '\t')
+		  tail += 1;
+	    if (*tail == ';' || *tail == 0) {
+		  cur->kind = LINE_LABEL;
+	    } else if (*tail == '%') {
+		  cur->kind = LINE_LABEL_OP;
+	    } else {
+		  cur->kind = LINE_OTHER;
+		  return;
+	    }
+	    cur->label = malloc(len+1);
+	    memcpy(cur->label, cp, len);
+	    cur->label[len] = 0;
+	    return;
+      }
+
+      while (*cp == ' ' || *cp == '\t')
+	    cp += 1;
+
+      if (cp == cur->text)
+	    cur->kind = LINE_OTHER;
+      else if (*cp == '%')
+	    cur->kind = LINE_INSN;
+      else if (*cp == ';')
+	    cur->kind = LINE_COMMENT;
+      else
+	    cur->kind = LINE_OTHER;
+}
+
+/*
+ * Read the collected code back into the lines array, splitting it at
+ * the newlines in place.
+ */
+static char*load_lines(void)
+{
+      long size;
+      char*buf;
+      char*cp;
+      unsigned cap = 0;
+      unsigned idx;
+
+      fflush(peep_file);
+      size = ftell(peep_file);
+      rewind(peep_file);
+
+      buf = malloc(size+1);
+      if (size > 0 && fread(buf, 1, size, peep_file) != (size_t)size) {
+	    free(buf);
+	    return 0;
+      }
+      buf[size] = 0;
+
+      nlines = 0;
+      cp = buf;
+      while (*cp) {
+	    char*eol = strchr(cp, '\n');
+	    if (nlines >= cap) {
+		  cap = cap ? 2*cap : 256;
+		  lines = realloc(lines, cap*sizeof(struct peep_line));
+	    }
+	    if (eol) *eol = 0;
+	    lines[nlines].text = cp;
+	    classify_line(lines+nlines);
+	    nlines += 1;
+	    if (eol == 0)
+		  break;
+	    cp = eol + 1;
+      }
+
+      nlabels = 0;
+      for (idx = 0 ; idx < nlines ; idx += 1) {
+	    if (lines[idx].label)
+		  nlabels += 1;
+      }
+      labels = malloc(nlabels*sizeof(struct peep_label) + 1);
+      nlabels = 0;
+      for (idx = 0 ; idx < nlines ; idx += 1) {
+	    if (lines[idx].label == 0)
+		  continue;
+	    labels[nlabels].name = lines[idx].label;
+	    labels[nlabels].line = idx;
+	    nlabels += 1;
+      }
+      qsort(labels, nlabels, sizeof(struct peep_label), compare_labels);
+
+      return buf;
+}
+
+/*
+ * Break a %jmp instruction into its opcode, target and the text that
+ * follows the target (", <flag>;" or ";"). Return false if this is
+ * not a jump, or if it is not in the expected form.
+ */
+struct peep_jump {
+      char opcode[16];
+      char target[64];
+      const char*tail;
+};
+
+static int parse_jump(const struct peep_line*cur, struct peep_jump*jmp)
+{
+      const char*cp;
+      size_t len;
+
+      if (cur->kind != LINE_INSN || cur->deleted)
+	    return 0;
+
+      cp = cur->text + strspn(cur->text, " \t");
+      if (strncmp(cp, "%jmp", 4) != 0 || (cp[4] != ' ' && cp[4] != '/'))
+	    return 0;
+
+      len = strcspn(cp, " ");
+      if (len >= sizeof jmp->opcode || cp[len] != ' ')
+	    return 0;
+      memcpy(jmp->opcode, cp, len);
+      jmp->opcode[len] = 0;
+      cp += len + 1;
+
+      len = strcspn(cp, ",;");
+      if (len == 0 || len >= sizeof jmp->target)
+	    return 0;
+      memcpy(jmp->target, cp, len);
+      jmp->target[len] = 0;
+      jmp->tail = cp + len;
+
+	/* Only take jumps with nothing after the terminating ;. */
+      cp = strchr(jmp->tail, ';');
+      if (cp == 0 || cp[1] != 0)
+	    return 0;
+
+      return 1;
+}
+
+static int is_insn(const struct peep_line*cur, const char*text)
+{
+      const char*cp;
+      if (cur->kind != LINE_INSN || cur->deleted)
+	    return 0;
+      cp = cur->text + strspn(cur->text, " \t");
+      return strcmp(cp, text) == 0;
+}
+
+static void replace_text(struct peep_line*cur, char*text)
+{
+      if (cur->allocated)
+	    free(cur->text);
+      cur->text = text;
+      cur->allocated = 1;
+}
+
+/*
+ * Return the first line at or after idx that may execute, skipping
+ * deleted lines, comments and plain labels. Return nlines if there
+ * is none.
+ */
+static unsigned first_code_line(unsigned idx)
+{
+      while (idx < nlines) {
+	    const struct peep_line*cur = lines + idx;
+	    if (!cur->deleted && cur->kind != LINE_COMMENT
+		&& cur->kind != LINE_LABEL)
+		  break;
+	    idx += 1;
+      }
+      return idx;
+}
+
+/*
+ * Replace jumps to unconditional jumps with jumps to the final
+ * target, and unconditional jumps to %end with %end.
+ */
+static int thread_jumps(void)
+{
+      int changes = 0;
+      unsigned idx;
+
+      for (idx = 0 ; idx < nlines ; idx += 1) {
+	    struct peep_jump jmp, next;
+	    char target[64];
+	    unsigned hops = 0;
+	    unsigned code = nlines;
+	    int lab;
+
+	    if (!parse_jump(lines+idx, &jmp))
+		  continue;
+
+	    strcpy(target, jmp.target);
+	    while (hops < 16) {
+		  lab = find_label(target);
+		  if (lab < 0 || lines[lab].kind != LINE_LABEL)
+			break;
+		  code = first_code_line(lab+1);
+		  if (code >= nlines)
+			break;
+		  if (!parse_jump(lines+code, &next))
+			break;
+		  if (strcmp(next.opcode, "%jmp") != 0)
+			break;
+		  strcpy(target, next.target);
+		  hops += 1;
+	    }
+
+	    if (strcmp(jmp.opcode, "%jmp") == 0 && code < nlines
+		&& is_insn(lines+code, "%end;")) {
+		  replace_text(lines+idx, strdup("    %end;"));
+		  changes += 1;
+		  continue;
+	    }
+
+	    if (hops > 0 && strcmp(target, jmp.target) != 0) {
+		  size_t len = strlen(jmp.opcode) + strlen(target)
+			+ strlen(jmp.tail) + 6;
+		  char*text = malloc(len);
+		  snprintf(text, len, "    %s %s%s", jmp.opcode, target,
+			   jmp.tail);
+		  replace_text(lines+idx, text);
+		  changes += 1;
+	    }
+      }
+
+      return changes;
+}
+
+/*
+ * Remove jumps (conditional or not) to a label that follows the jump
+ * with nothing but labels and comments in between.
+ */
+static int remove_jumps_to_next(void)
+{
+      int changes = 0;
+      unsigned idx;
+
+      for (idx = 0 ; idx < nlines ; idx += 1) {
+	    struct peep_jump jmp;
+	    unsigned cur;
+
+	    if (!parse_jump(lines+idx, &jmp))
+		  continue;
+
+	    for (cur = idx+1 ; cur < nlines ; cur += 1) {
+		  if (lines[cur].deleted || lines[cur].kind == LINE_COMMENT)
+			continue;
+		  if (lines[cur].kind != LINE_LABEL &&
+		      lines[cur].kind != LINE_LABEL_OP)
+			break;
+		  if (strcmp(lines[cur].label, jmp.target) == 0) {
+			lines[idx].deleted = 1;
+			changes += 1;
+			break;
+		  }
+		  if (lines[cur].kind == LINE_LABEL_OP)
+			break;
+	    }
+      }
+
+      return changes;
+}
+
+/*
+ * Instructions that follow an unconditional %jmp or an %end can only
+ * be reached through a label, so remove the instructions up to the
+ * next label. Stop without removing anything if the run ends with
+ * something that is not understood.
+ */
+static int remove_unreachable(void)
+{
+      int changes = 0;
+      unsigned idx;
+
+      for (idx = 0 ; idx < nlines ; idx += 1) {
+	    struct peep_jump jmp;
+	    unsigned cur;
+
+	    if (!is_insn(lines+idx, "%end;")) {
+		  if (!parse_jump(lines+idx, &jmp))
+			continue;
+		  if (strcmp(jmp.opcode, "%jmp") != 0)
+			continue;
+	    }
+
+	    for (cur = idx+1 ; cur < nlines ; cur += 1) {
+		  if (lines[cur].deleted || lines[cur].kind == LINE_COMMENT)
+			continue;
+		  if (lines[cur].kind != LINE_INSN)
+			break;
+	    }
+
+	    if (cur < nlines && lines[cur].kind == LINE_OTHER) {
+		  const char*cp = lines[cur].text;
+		  cp += strspn(cp, " \t");
+		  if (*cp != '.')
+			continue;
+	    }
+
+	    for (cur = idx+1 ; cur < nlines ; cur += 1) {
+		  if (lines[cur].deleted || lines[cur].kind == LINE_COMMENT)
+			continue;
+		  if (lines[cur].kind != LINE_INSN)
+			break;
+		  lines[cur].deleted = 1;
+		  changes += 1;
+	    }
+      }
+
+      return changes;
+}
+
+/*
+ * Fold a %pushi/vec4 that is immediately resized by a %pad/u (or a
+ * %pad/s that does not need to extend a set sign bit) into a single
+ * %pushi/vec4 of the final width. The immediate values only carry
+ * the low 32 bits, and the bits above that are 0.
+ */
+static int fold_pushi_pad(void)
+{
+      int changes = 0;
+      unsigned idx;
+
+      for (idx = 0 ; idx < nlines ; idx += 1) {
+	    unsigned long vala, valb;
+	    unsigned wid, pad_wid, keep;
+	    unsigned long mask;
+	    int pos = 0;
+	    int signed_flag;
+	    unsigned nxt;
+	    const char*cp;
+	    char*text;
+
+	    if (lines[idx].kind != LINE_INSN || lines[idx].deleted)
+		  continue;
+
+	    cp = lines[idx].text + strspn(lines[idx].text, " \t");
+	    if (sscanf(cp, "%%pushi/vec4 %lu, %lu, %u;%n",
+		       &vala, &valb, &wid, &pos) != 3 || cp[pos] != 0)
+		  continue;
+
+	    for (nxt = idx+1 ; nxt < nlines ; nxt += 1) {
+		  if (!lines[nxt].deleted)
+			break;
+	    }
+	    if (nxt >= nlines || lines[nxt].kind != LINE_INSN)
+		  continue;
+
+	    cp = lines[nxt].text + strspn(lines[nxt].text, " \t");
+	    pos = 0;
+	    if (sscanf(cp, "%%pad/u %u;%n", &pad_wid, &pos) == 1 && cp[pos] == 0)
+		  signed_flag = 0;
+	    else if (sscanf(cp, "%%pad/s %u;%n", &pad_wid, &pos) == 1 && cp[pos] == 0)
+		  signed_flag = 1;
+	    else
+		  continue;
+
+	    if (wid == 0 || pad_wid == 0)
+		  continue;
+
+	      /* Sign extension of a set (or x/z) sign bit cannot be
+		 expressed with the 32 bit immediate values. */
+	    if (signed_flag && pad_wid > wid && wid <= 32) {
+		  if (((vala | valb) >> (wid-1)) & 1)
+			continue;
+	    }
+
+	    keep = wid < pad_wid ? wid : pad_wid;
+	    mask = keep >= 32 ? 0xffffffffUL : ((1UL << keep) - 1UL);
+	    vala &= mask;
+	    valb &= mask;
+
+	    text = malloc(80);
+	    snprintf(text, 80, "    %%pushi/vec4 %lu, %lu, %u;",
+		     vala, valb, pad_wid);
+	    replace_text(lines+idx, text);
+	    lines[nxt].deleted = 1;
+	    changes += 1;
+      }
+
+      return changes;
+}
+
+/*
+ * Return the next line after idx that is not deleted or a comment,
+ * or nlines if there is none.
+ */
+static unsigned next_line(unsigned idx)
+{
+      for (idx += 1 ; idx < nlines ; idx += 1) {
+	    if (!lines[idx].deleted && lines[idx].kind != LINE_COMMENT)
+		  break;
+      }
+      return idx;
+}
+
+/*
+ * Remove a value that is pushed and then popped before anything uses
+ * it. The push must only read, so that nothing else changes when it
+ * is removed. The pop count is reduced by one, and the pop is removed
+ * when it reaches zero.
+ */
+static const char*const pure_push_vec4[] = {
+      "%pushi/vec4 ", "%load/vec4 ", "%dup/vec4;", 0
+};
+static const char*const pure_push_real[] = {
+      "%pushi/real ", "%load/real ", "%dup/real;", 0
+};
+
+static int match_prefix(const char*text, const char*const*list)
+{
+      unsigned idx;
+      for (idx = 0 ; list[idx] ; idx += 1) {
+	    if (strncmp(text, list[idx], strlen(list[idx])) == 0)
+		  return 1;
+      }
+      return 0;
+}
+
+static int remove_dead_pushes(void)
+{
+      int changes = 0;
+      unsigned idx;
+
+      for (idx = 0 ; idx < nlines ; idx += 1) {
+	    const char*pop_op;
+	    const char*cp;
+	    unsigned nxt, count;
+	    int pos = 0;
+	    char*text;
+
+	    if (lines[idx].kind != LINE_INSN || lines[idx].deleted)
+		  continue;
+
+	    cp = lines[idx].text + strspn(lines[idx].text, " \t");
+	    if (match_prefix(cp, pure_push_vec4))
+		  pop_op = "%pop/vec4";
+	    else if (match_prefix(cp, pure_push_real))
+		  pop_op = "%pop/real";
+	    else
+		  continue;
+
+	    nxt = next_line(idx);
+	    if (nxt >= nlines || lines[nxt].kind != LINE_INSN)
+		  continue;
+
+	    cp = lines[nxt].text + strspn(lines[nxt].text, " \t");
+	    if (strncmp(cp, pop_op, 9) != 0
+		|| sscanf(cp+9, " %u;%n", &count, &pos) != 1 || pos == 0
+		|| count == 0)
+		  continue;
+
+	    lines[idx].deleted = 1;
+	    if (count == 1) {
+		  lines[nxt].deleted = 1;
+	    } else {
+		  size_t len = strlen(cp+9+pos) + 40;
+		  text = malloc(len);
+		  snprintf(text, len, "    %s %u;%s", pop_op, count-1,
+			   cp+9+pos);
+		  replace_text(lines+nxt, text);
+	    }
+	    changes += 1;
+      }
+
+      return changes;
+}
+
+/*
+ * Track the values that %ix/load and %flag_set/imm put in the index
+ * registers and flags of a straight run of code, and remove such an
+ * instruction if the register already holds that value. The known
+ * values are forgotten at every label and at every instruction that
+ * is not known to leave the index registers and flags alone.
+ */
+#define PEEP_KNOWN_IX 16
+#define PEEP_KNOWN_FLAGS 256
+
+static const char*const keeps_registers[] = {
+      "%pushi/vec4 ", "%pushi/real ", "%pushi/str ",
+      "%load/vec4 ", "%load/vec4a ", "%load/real ", "%load/str ",
+      "%dup/vec4;", "%dup/real;",
+      "%pop/vec4 ", "%pop/real ", "%pop/str ",
+      "%pad/u ", "%pad/s ", "%concat/vec4;", "%concati/vec4 ",
+      "%store/vec4 ", "%store/vec4a ", "%store/real ", "%store/reala ",
+      "%store/str ", "%assign/vec4 ",
+      0
+};
+
+/* Return the length of the operands, up to and including the ;. */
+static size_t operand_len(const char*cp)
+{
+      const char*end = strchr(cp, ';');
+      return end ? (size_t)(end - cp) + 1 : 0;
+}
+
+static int remove_redundant_sets(void)
+{
+      const char*known_ix[PEEP_KNOWN_IX];
+      const char*known_flag[PEEP_KNOWN_FLAGS];
+      int changes = 0;
+      unsigned idx;
+
+      memset(known_ix, 0, sizeof known_ix);
+      memset(known_flag, 0, sizeof known_flag);
+
+      for (idx = 0 ; idx < nlines ; idx += 1) {
+	    const char**slot = 0;
+	    unsigned reg;
+	    int pos = 0;
+	    const char*cp;
+
+	    if (lines[idx].deleted || lines[idx].kind == LINE_COMMENT)
+		  continue;
+
+	    if (lines[idx].kind != LINE_INSN) {
+		  memset(known_ix, 0, sizeof known_ix);
+		  memset(known_flag, 0, sizeof known_flag);
+		  continue;
+	    }
+
+	    cp = lines[idx].text + strspn(lines[idx].text, " \t");
+	    if (sscanf(cp, "%%ix/load %u,%n", &reg, &pos) == 1 && pos > 0) {
+		  if (reg < PEEP_KNOWN_IX)
+			slot = known_ix + reg;
+	    } else if (sscanf(cp, "%%flag_set/imm %u,%n", &reg, &pos) == 1
+		       && pos > 0) {
+		  if (reg < PEEP_KNOWN_FLAGS)
+			slot = known_flag + reg;
+	    } else {
+		  if (!match_prefix(cp, keeps_registers)) {
+			memset(known_ix, 0, sizeof known_ix);
+			memset(known_flag, 0, sizeof known_flag);
+		  }
+		  continue;
+	    }
+
+	    if (slot == 0 || operand_len(cp) == 0) {
+		  memset(known_ix, 0, sizeof known_ix);
+		  memset(known_flag, 0, sizeof known_flag);
+		  continue;
+	    }
+
+	    if (*slot && operand_len(*slot) == operand_len(cp)
+		&& strncmp(*slot, cp, operand_len(cp)) == 0) {
+		  lines[idx].deleted = 1;
+		  changes += 1;
+		  continue;
+	    }
+
+	    *slot = cp;
+      }
+
+      return changes;
+}
+
+static unsigned long count_insns(void)
+{
+      unsigned long count = 0;
+      unsigned idx;
+      for (idx = 0 ; idx < nlines ; idx += 1) {
+	    if (lines[idx].deleted)
+		  continue;
+	    if (lines[idx].kind == LINE_INSN || lines[idx].kind == LINE_LABEL_OP)
+		  count += 1;
+      }
+      return count;
+}
+
+void peephole_begin(void)
+{
+	/* Nested threads are optimized along with the outer one. */
+      peep_depth += 1;
+      if (opt_level == 0 || peep_depth > 1)
+	    return;
+
+      assert(real_out == 0);
+      if (peep_file == 0)
+	    peep_file = tmpfile();
+      if (peep_file == 0)
+	    return;
+
+      real_out = vvp_out;
+      vvp_out = peep_file;
+}
+
+void peephole_end(void)
+{
+      char*buf;
+      unsigned idx;
+      unsigned pass;
+
+      assert(peep_depth > 0);
+      peep_depth -= 1;
+      if (real_out == 0 || peep_depth > 0)
+	    return;
+
+      vvp_out = real_out;
+      real_out = 0;
+
+      buf = load_lines();
+      if (buf == 0) {
+	    fprintf(stderr, "vvp.tgt error: Unable to read back "
+		    "thread code for optimization.\n");
+	    vvp_errors += 1;
+	    rewind(peep_file);
+	    return;
+      }
+
+      count_insn_in += count_insns();
+
+      for (pass = 0 ; pass < 8 ; pass += 1) {
+	    int changes = 0;
+	    changes += thread_jumps();
+	    changes += remove_jumps_to_next();
+	    changes += remove_unreachable();
+	    if (opt_level >= 2) {
+		  changes += fold_pushi_pad();
+		  changes += remove_dead_pushes();
+		  changes += remove_redundant_sets();
+	    }
+	    if (changes == 0)
+		  break;
+      }
+
+      count_insn_out += count_insns();
+
+      for (idx = 0 ; idx < nlines ; idx += 1) {
+	    struct peep_line*cur = lines + idx;
+	    if (!cur->deleted) {
+		  fputs(cur->text, vvp_out);
+		  fputc('\n', vvp_out);
+	    }
+	    if (cur->allocated)
+		  free(cur->text);
+	    free(cur->label);
+      }
+
+      free(labels);
+      labels = 0;
+      nlabels = 0;
+      nlines = 0;
+      free(buf);
+      rewind(peep_file);
+}
+
+void peephole_report(void)
+{
+      if (peep_file) {
+	    fclose(peep_file);
+	    peep_file = 0;
+      }
+      free(lines);
+      lines = 0;
+
+      if (opt_level == 0 || !debug_opt)
+	    return;
+
+      fprintf(stderr, "vvp.tgt: peephole: %lu of %lu thread instructions "
+	      "removed\n", count_insn_in - count_insn_out, count_insn_in);
+}
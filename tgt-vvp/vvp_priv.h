@@ -24,6 +24,7 @@
 # include  <stdio.h>
 
 extern int debug_draw;
+extern int debug_opt;
 
 /*
  * The target_design entry opens the output file that receives the
@@ -66,6 +67,12 @@ extern const char *vvp_mangle_name(const char *);
 
 extern char* draw_Cr_to_string(double value);
 
+/*
+ * Write the nbits bits of a constant (least significant first, as
+ * ivl_expr_bits returns them) to the output, most significant first.
+ */
+extern void draw_vec4_bits(const char*bits, unsigned nbits);
+
 /*
  * This generates a string from a signal that uniquely identifies
  * that signal with letters that can be used in a label.
@@ -94,6 +101,33 @@ extern int draw_func_definition(ivl_scope_t scope);
 
 extern int draw_scope(ivl_scope_t scope, ivl_scope_t parent);
 
+/*
+ * draw_lut.c symbols.
+ *
+ * collapse_logic_cones scans the design for fanout-free cones of
+ * simple gates before anything is drawn. draw_logic_lut then draws
+ * the root of each cone as a single LUT functor. It returns true if
+ * it handled the gate (including gates absorbed into a cone), or
+ * false if the gate must be drawn normally. The lut_inputs limit is
+ * set by the -plut_inputs flag.
+ */
+extern unsigned lut_inputs;
+extern void collapse_logic_cones(ivl_design_t des);
+extern int draw_logic_lut(ivl_net_logic_t lptr);
+
+/*
+ * vvp_peephole.c symbols.
+ *
+ * The code that is drawn between peephole_begin and peephole_end is
+ * collected and optimized before it is written to vvp_out. This is
+ * only done if opt_level (set by the -popt_level flag) is not 0, and
+ * peephole_report prints the totals if the "opt" debug flag is set.
+ */
+extern unsigned opt_level;
+extern void peephole_begin(void);
+extern void peephole_end(void);
+extern void peephole_report(void);
+
 extern void draw_lpm_mux(ivl_lpm_t net);
 extern void draw_lpm_substitute(ivl_lpm_t net);
 
@@ -157,6 +191,10 @@ struct vvp_nexus_data {
       unsigned net_word;
 };
 #define VVP_NEXUS_DATA_STR 0x0001
+  /* The nexus is inside a logic cone (see draw_lut.c). */
+#define VVP_NEXUS_DATA_LUT 0x0002
+  /* The nexus must not be absorbed into a logic cone. */
+#define VVP_NEXUS_DATA_PINNED 0x0004
 
 
 /*
@@ -2417,6 +2417,7 @@ int draw_process(ivl_process_t net, void*x)
       }
 
       local_count = 0;
+      peephole_begin();
       fprintf(vvp_out, "    .scope S_%p;\n", scope);
 
 	/* Generate the entry label. Just give the thread a number so
@@ -2468,6 +2469,7 @@ int draw_process(ivl_process_t net, void*x)
 	    break;
       }
 
+      peephole_end();
       thread_count += 1;
       return rc;
 }
@@ -2477,12 +2479,14 @@ int draw_task_definition(ivl_scope_t scope)
       int rc = 0;
       ivl_statement_t def = ivl_scope_def(scope);
 
+      peephole_begin();
       fprintf(vvp_out, "TD_%s ;\n", vvp_mangle_id(ivl_scope_name(scope)));
 
       assert(def);
       rc += show_statement(def, scope);
 
       fprintf(vvp_out, "    %%end;\n");
+      peephole_end();
 
       thread_count += 1;
       return rc;
@@ -2493,12 +2497,14 @@ int draw_func_definition(ivl_scope_t scope)
       int rc = 0;
       ivl_statement_t def = ivl_scope_def(scope);
 
+      peephole_begin();
       fprintf(vvp_out, "TD_%s ;\n", vvp_mangle_id(ivl_scope_name(scope)));
 
       assert(def);
       rc += show_statement(def, scope);
 
       fprintf(vvp_out, "    %%end;\n");
+      peephole_end();
 
       thread_count += 1;
       return rc;
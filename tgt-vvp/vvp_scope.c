@@ -413,6 +413,26 @@ char* draw_Cr_to_string(double value)
       return strdup(tmp);
 }
 
+/*
+ * Write the bits of a constant, most significant bit first. The bits
+ * of an expression are stored least significant bit first, so reverse
+ * them a block at a time and write each block with one fwrite instead
+ * of printing the bits one by one.
+ */
+void draw_vec4_bits(const char*bits, unsigned nbits)
+{
+      char buf[256];
+
+      while (nbits > 0) {
+	    unsigned cnt = nbits < sizeof buf? nbits : sizeof buf;
+	    unsigned idx;
+	    for (idx = 0 ;  idx < cnt ;  idx += 1)
+		  buf[idx] = bits[nbits-idx-1];
+	    fwrite(buf, 1, cnt, vvp_out);
+	    nbits -= cnt;
+      }
+}
+
 const char*draw_input_from_net(ivl_nexus_t nex)
 {
       static char result[32];
@@ -627,8 +647,21 @@ static void draw_net_in_scope(ivl_signal_t sig)
 
 	      /* Connect the pin of the signal to something. */
 	    ivl_nexus_t nex = ivl_signal_nex(sig, iword);
-	    const char*driver = draw_net_input(nex);
+	    const char*driver;
 
+	    nex_data = (struct vvp_nexus_data*)ivl_nexus_get_private(nex);
+
+	      /* The driver of a net inside a logic cone is not drawn,
+		 and only local signals can be connected to it. */
+	    if (nex_data && (nex_data->flags & VVP_NEXUS_DATA_LUT)) {
+		  assert(ivl_signal_local(sig) && word_count == 1);
+		  fprintf(vvp_out, "; Elide local net v%p_%u absorbed into "
+			  "a logic cone, name=%s\n",
+			  sig, iword, ivl_signal_basename(sig));
+		  continue;
+	    }
+
+	    driver = draw_net_input(nex);
 	    nex_data = (struct vvp_nexus_data*)ivl_nexus_get_private(nex);
 	    assert(nex_data);
 
@@ -960,6 +993,10 @@ static void draw_logic_in_scope(ivl_net_logic_t lptr)
       unsigned ninp;
       const char **input_strings;
 
+	/* Gates that are part of a logic cone are drawn as a LUT. */
+      if (draw_logic_lut(lptr))
+	    return;
+
       switch (ivl_logic_type(lptr)) {
 
           case IVL_LO_UDP:
@@ -1129,7 +1166,7 @@ static void draw_logic_in_scope(ivl_net_logic_t lptr)
 			unsigned wdx;
 			fprintf(vvp_out, ", C4<");
 			for (wdx = 0 ; wdx < vector_width ;  wdx += 1)
-			      fprintf(vvp_out, "%c", identity_val);
+			      fputc(identity_val, vvp_out);
 			fprintf(vvp_out, ">");
 		  }
 
@@ -1866,11 +1903,9 @@ static void draw_lpm_ff(ivl_lpm_t net)
 	    if (val) {
 		  unsigned nbits = ivl_expr_width(val);
 		  const char*bits = ivl_expr_bits(val);
-		  unsigned bb;
 		  assert(nbits == width);
 		  fprintf(vvp_out, ", C4<");
-		  for (bb = 0 ;  bb < nbits;  bb += 1)
-			fprintf(vvp_out, "%c", bits[nbits-bb-1]);
+		  draw_vec4_bits(bits, nbits);
 		  fprintf(vvp_out, ">");
 	    }
       }
@@ -2439,12 +2474,7 @@ int draw_scope(ivl_scope_t net, ivl_scope_t parent)
 			  ivl_file_table_index(ivl_parameter_file(par)),
 			  ivl_parameter_lineno(par),
 			  ivl_expr_signed(pex)? "+":"");
-		  { const char*bits = ivl_expr_bits(pex);
-		    unsigned nbits = ivl_expr_width(pex);
-		    unsigned bb;
-		    for (bb = 0 ;  bb < nbits;  bb += 1)
-			  fprintf(vvp_out, "%c", bits[nbits-bb-1]);
-		  }
+		  draw_vec4_bits(ivl_expr_bits(pex), ivl_expr_width(pex));
 		  fprintf(vvp_out, ">;\n");
 		  break;
 		case IVL_EX_REALNUM:
@@ -2492,8 +2522,11 @@ int draw_scope(ivl_scope_t net, ivl_scope_t parent)
 	/* Scan the signals (reg and net) and draw the appropriate
 	   statements to make the signal function. */
 
-      for (idx = 0 ;  idx < ivl_scope_sigs(net) ;  idx += 1) {
-	    ivl_signal_t sig = ivl_scope_sig(net, idx);
+      ivl_signal_t*sigs;
+      unsigned nsigs;
+      ivl_scope_sig_array(net, &sigs, &nsigs);
+      for (idx = 0 ;  idx < nsigs ;  idx += 1) {
+	    ivl_signal_t sig = sigs[idx];
 
 	    switch (ivl_signal_type(sig)) {
 		case IVL_SIT_REG:
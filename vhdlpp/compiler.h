@@ -27,6 +27,10 @@ const int GN_KEYWORD_2008  = 0x0001;
 // TRUE if processing is supposed to dump progress to stderr.
 extern bool verbose_flag;
 
+// TRUE if library packages are also saved and loaded as precompiled
+// binary images.
+extern bool precompiled_packages_flag;
+
 extern bool debug_elaboration;
 extern std::ofstream debug_log_file;
 
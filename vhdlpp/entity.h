@@ -30,6 +30,7 @@
 typedef enum { PORT_NONE=0, PORT_IN, PORT_OUT, PORT_INOUT } port_mode_t;
 
 class Architecture;
+class BinaryWriter;
 class Expression;
 
 class InterfacePort : public LineInfo {
@@ -87,6 +88,7 @@ class ComponentBase : public LineInfo {
 
 
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
 
     public:
       void dump_generics(std::ostream&out, int indent =0) const;
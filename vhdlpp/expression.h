@@ -31,6 +31,7 @@
 # include  <vector>
 # include  <cassert>
 
+class BinaryWriter;
 class ExpRange;
 class ScopeBase;
 class SubprogramHeader;
@@ -115,6 +116,11 @@ class Expression : public LineInfo {
 	// for writing parsed types to library files.
       virtual void write_to_stream(std::ostream&fd) const =0;
 
+	// This virtual method writes the expression to a precompiled
+	// library image. Expressions that have no binary form mark
+	// the image unsupported.
+      virtual void write_to_binary(BinaryWriter&out) const;
+
 	// The emit virtual method is called by architecture emit to
 	// output the generated code for the expression. The derived
 	// class fills in the details of what exactly happened.
@@ -274,6 +280,7 @@ class ExpAggregate : public Expression {
 	    ExpRange*range_expressions(void);
 
 	    void write_to_stream(std::ostream&fd);
+	    void write_to_binary(BinaryWriter&out) const;
 	    void dump(std::ostream&out, int indent) const;
 
 	  private:
@@ -314,6 +321,7 @@ class ExpAggregate : public Expression {
 
 	    inline Expression* extract_expression() { return val_; }
 	    void write_to_stream(std::ostream&fd) const;
+	    void write_to_binary(BinaryWriter&out) const;
 
 	    void dump(std::ostream&out, int indent) const;
 
@@ -333,6 +341,7 @@ class ExpAggregate : public Expression {
       const VType*fit_type(Entity*ent, ScopeBase*scope, const VTypeArray*atype) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       void dump(std::ostream&out, int indent = 0) const;
       void visit(ExprVisitor& func);
@@ -367,6 +376,7 @@ class ExpArithmetic : public ExpBinary {
 
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       virtual bool evaluate(Entity*ent, ScopeBase*scope, int64_t&val) const;
       void dump(std::ostream&out, int indent = 0) const;
@@ -415,6 +425,7 @@ class ExpObjAttribute : public ExpAttribute {
       const VType*probe_type(Entity*ent, ScopeBase*scope) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
 	// Some attributes can be evaluated at compile time
       bool evaluate(Entity*ent, ScopeBase*scope, int64_t&val) const;
       void dump(std::ostream&out, int indent = 0) const;
@@ -437,6 +448,7 @@ class ExpTypeAttribute : public ExpAttribute {
       const VType*probe_type(Entity*ent, ScopeBase*scope) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
 	// Some attributes can be evaluated at compile time
       bool evaluate(ScopeBase*scope, int64_t&val) const;
       bool evaluate(Entity*ent, ScopeBase*scope, int64_t&val) const;
@@ -459,6 +471,7 @@ class ExpBitstring : public Expression {
       const VType*fit_type(Entity*ent, ScopeBase*scope, const VTypeArray*atype) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       void dump(std::ostream&out, int indent = 0) const;
 
@@ -479,6 +492,7 @@ class ExpCharacter : public Expression {
       const VType*fit_type(Entity*ent, ScopeBase*scope, const VTypeArray*atype) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       bool is_primary(void) const;
       void dump(std::ostream&out, int indent = 0) const;
@@ -507,6 +521,7 @@ class ExpConcat : public Expression {
       const VType*fit_type(Entity*ent, ScopeBase*scope, const VTypeArray*atype) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       bool is_primary(void) const;
       void dump(std::ostream&out, int indent = 0) const;
@@ -626,6 +641,7 @@ class ExpFunc : public Expression {
       const VType*probe_type(Entity*ent, ScopeBase*scope) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       void dump(std::ostream&out, int indent = 0) const;
       void visit(ExprVisitor& func); // NOTE: does not handle expressions in subprogram body
@@ -651,6 +667,7 @@ class ExpInteger : public Expression {
       const VType*probe_type(Entity*ent, ScopeBase*scope) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       int emit_package(std::ostream&out) const;
       bool is_primary(void) const { return true; }
@@ -674,6 +691,7 @@ class ExpReal : public Expression {
       const VType*probe_type(Entity*ent, ScopeBase*scope) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       int emit_package(std::ostream&out) const;
       bool is_primary(void) const;
@@ -701,6 +719,7 @@ class ExpLogical : public ExpBinary {
 
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       void dump(std::ostream&out, int indent = 0) const;
 
@@ -729,6 +748,7 @@ class ExpName : public Expression {
       const VType* fit_type(Entity*ent, ScopeBase*scope, const VTypeArray*host) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit_indices(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       bool is_primary(void) const;
@@ -819,6 +839,7 @@ class ExpRelation : public ExpBinary {
       const VType* probe_type(Entity*ent, ScopeBase*scope) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       void dump(std::ostream&out, int indent = 0) const;
 
@@ -856,6 +877,8 @@ class ExpScopedName : public Expression {
         void write_to_stream(std::ostream&fd) const
         { name_->write_to_stream(fd); }
 
+        void write_to_binary(BinaryWriter&out) const;
+
         int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const {
             out << scope_name_ << ".";
             return name_->emit(out, ent, scope);
@@ -897,6 +920,7 @@ class ExpShift : public ExpBinary {
 
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       bool evaluate(Entity*ent, ScopeBase*scope, int64_t&val) const;
       void dump(std::ostream&out, int indent = 0) const;
@@ -917,6 +941,7 @@ class ExpString : public Expression {
       const VType*fit_type(Entity*ent, ScopeBase*scope, const VTypeArray*atype) const;
       int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       bool is_primary(void) const;
       void dump(std::ostream&out, int indent = 0) const;
@@ -942,6 +967,7 @@ class ExpUAbs : public ExpUnary {
       Expression*clone() const { return new ExpUAbs(peek_operand()->clone()); }
 
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       void dump(std::ostream&out, int indent = 0) const;
 };
@@ -955,6 +981,7 @@ class ExpUNot : public ExpUnary {
       Expression*clone() const { return new ExpUNot(peek_operand()->clone()); }
 
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       void dump(std::ostream&out, int indent = 0) const;
 };
@@ -968,6 +995,7 @@ class ExpUMinus : public ExpUnary {
       Expression*clone() const { return new ExpUMinus(peek_operand()->clone()); }
 
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       void dump(std::ostream&out, int indent = 0) const;
 };
@@ -987,6 +1015,7 @@ class ExpCast : public Expression {
             return base_->elaborate_expr(ent, scope, type_);
       }
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
       void dump(std::ostream&out, int indent = 0) const;
       void visit(ExprVisitor& func);
@@ -1028,6 +1057,7 @@ class ExpTime : public Expression {
 
         int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
         void write_to_stream(std::ostream&) const;
+        void write_to_binary(BinaryWriter&out) const;
         int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
         //bool evaluate(Entity*ent, ScopeBase*scope, int64_t&val) const;
         void dump(std::ostream&out, int indent = 0) const;
@@ -1063,6 +1093,7 @@ class ExpRange : public Expression {
 
         int elaborate_expr(Entity*ent, ScopeBase*scope, const VType*ltype);
         void write_to_stream(std::ostream&) const;
+        void write_to_binary(BinaryWriter&out) const;
         int emit(std::ostream&out, Entity*ent, ScopeBase*scope) const;
         void dump(std::ostream&out, int indent = 0) const;
     private:
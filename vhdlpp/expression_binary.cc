@@ -0,0 +1,512 @@
+/*
+ * Copyright (c) 2026 the Icarus Verilog contributors
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "library_binary.h"
+# include  "expression.h"
+# include  <typeinfo>
+
+using namespace std;
+
+/*
+ * Every expression record starts with its tag and its file/line, and
+ * the rest of the record is the arguments to its constructor.
+ */
+
+void BinaryWriter::write_expr(const Expression*expr)
+{
+      if (expr == 0)
+	    write_uint(BE_NULL);
+      else
+	    expr->write_to_binary(*this);
+}
+
+void BinaryWriter::write_expr_list(const list<Expression*>*items)
+{
+      if (items == 0) {
+	    write_uint(0);
+	    return;
+      }
+
+      write_uint(items->size() + 1);
+      for (list<Expression*>::const_iterator cur = items->begin()
+		 ; cur != items->end() ; ++cur) {
+	    write_expr(*cur);
+      }
+}
+
+void Expression::write_to_binary(BinaryWriter&out) const
+{
+      out.unsupported(typeid(*this).name());
+}
+
+void ExpAggregate::choice_t::write_to_binary(BinaryWriter&out) const
+{
+      out.write_expr(expr_.get());
+      out.write_expr(range_.get());
+}
+
+void ExpAggregate::element_t::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(fields_.size());
+      for (size_t idx = 0 ; idx < fields_.size() ; idx += 1)
+	    fields_[idx]->write_to_binary(out);
+      out.write_expr(val_);
+}
+
+void ExpAggregate::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_AGGREGATE);
+      out.write_line(*this);
+
+      if (! elements_.empty() || aggregate_.empty()) {
+	    out.write_uint(elements_.size());
+	    for (size_t idx = 0 ; idx < elements_.size() ; idx += 1)
+		  elements_[idx]->write_to_binary(out);
+	    return;
+      }
+
+	// Elaboration replaces the parsed elements with the aggregate_
+	// map, which has one entry per choice. Choices that share an
+	// expression are marked as aliases of the choice before them,
+	// so collect them back into a single element.
+      size_t count = 0;
+      for (size_t idx = 0 ; idx < aggregate_.size() ; idx += 1) {
+	    if (! aggregate_[idx].alias_flag)
+		  count += 1;
+      }
+
+      out.write_uint(count);
+      for (size_t idx = 0 ; idx < aggregate_.size() ; ) {
+	    size_t end = idx + 1;
+	    while (end < aggregate_.size() && aggregate_[end].alias_flag)
+		  end += 1;
+
+	    if (aggregate_[idx].choice == 0) {
+		  out.write_uint(0);
+	    } else {
+		  out.write_uint(end - idx);
+		  for (size_t cdx = idx ; cdx < end ; cdx += 1)
+			aggregate_[cdx].choice->write_to_binary(out);
+	    }
+	    out.write_expr(aggregate_[idx].expr);
+	    idx = end;
+      }
+}
+
+void ExpArithmetic::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_ARITHMETIC);
+      out.write_line(*this);
+      out.write_uint(fun_);
+      out.write_expr(peek_operand1());
+      out.write_expr(peek_operand2());
+}
+
+void ExpObjAttribute::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_OBJ_ATTRIBUTE);
+      out.write_line(*this);
+      out.write_expr(base_);
+      out.write_string(name_);
+      out.write_expr_list(args_);
+}
+
+void ExpTypeAttribute::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_TYPE_ATTRIBUTE);
+      out.write_line(*this);
+      out.write_type(base_);
+      out.write_string(name_);
+      out.write_expr_list(args_);
+}
+
+void ExpBitstring::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_BITSTRING);
+      out.write_line(*this);
+	// The constructor stores the bits LSB first.
+      out.write_text(string(value_.rbegin(), value_.rend()));
+}
+
+void ExpCharacter::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_CHARACTER);
+      out.write_line(*this);
+      out.write_uint((unsigned char)value_);
+}
+
+void ExpConcat::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_CONCAT);
+      out.write_line(*this);
+      out.write_expr(operand1_);
+      out.write_expr(operand2_);
+}
+
+void ExpFunc::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_FUNC);
+      out.write_line(*this);
+      out.write_string(name_);
+      out.write_uint(argv_.size());
+      for (size_t idx = 0 ; idx < argv_.size() ; idx += 1)
+	    out.write_expr(argv_[idx]);
+}
+
+void ExpInteger::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_INTEGER);
+      out.write_line(*this);
+      out.write_int(value_);
+}
+
+void ExpReal::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_REAL);
+      out.write_line(*this);
+      out.write_real(value_);
+}
+
+void ExpLogical::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_LOGICAL);
+      out.write_line(*this);
+      out.write_uint(fun_);
+      out.write_expr(peek_operand1());
+      out.write_expr(peek_operand2());
+}
+
+void ExpName::write_to_binary(BinaryWriter&out) const
+{
+      if (dynamic_cast<const ExpNameALL*>(this)) {
+	    out.write_uint(BE_NAME_ALL);
+	    out.write_line(*this);
+	    return;
+      }
+
+      out.write_uint(BE_NAME);
+      out.write_line(*this);
+      out.write_expr(prefix_.get());
+      out.write_string(name_);
+      out.write_expr_list(indices_);
+}
+
+void ExpRelation::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_RELATION);
+      out.write_line(*this);
+      out.write_uint(fun_);
+      out.write_expr(peek_operand1());
+      out.write_expr(peek_operand2());
+}
+
+void ExpScopedName::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_SCOPED_NAME);
+      out.write_line(*this);
+      out.write_string(scope_name_);
+      out.write_expr(name_);
+}
+
+void ExpShift::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_SHIFT);
+      out.write_line(*this);
+      out.write_uint(shift_);
+      out.write_expr(peek_operand1());
+      out.write_expr(peek_operand2());
+}
+
+void ExpString::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_STRING);
+      out.write_line(*this);
+      out.write_text(value_);
+}
+
+void ExpUAbs::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_UABS);
+      out.write_line(*this);
+      out.write_expr(peek_operand());
+}
+
+void ExpUNot::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_UNOT);
+      out.write_line(*this);
+      out.write_expr(peek_operand());
+}
+
+void ExpUMinus::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_UMINUS);
+      out.write_line(*this);
+      out.write_expr(peek_operand());
+}
+
+void ExpCast::write_to_binary(BinaryWriter&out) const
+{
+	// Casts are only introduced by elaboration, which will add
+	// them again when the loaded package is elaborated. This
+	// matches what write_to_stream does.
+      base_->write_to_binary(out);
+}
+
+void ExpTime::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_TIME);
+      out.write_line(*this);
+      out.write_uint(amount_);
+      out.write_uint(unit_);
+}
+
+void ExpRange::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BE_RANGE);
+      out.write_line(*this);
+      out.write_bool(range_expr_);
+      if (range_expr_) {
+	    out.write_expr(range_base_);
+	    out.write_bool(range_reverse_);
+      } else {
+	    out.write_expr(left_);
+	    out.write_expr(right_);
+	    out.write_uint(direction_);
+      }
+}
+
+list<Expression*>* BinaryReader::read_expr_list()
+{
+      uint64_t count = read_count();
+      if (count == 0)
+	    return 0;
+
+      list<Expression*>*res = new list<Expression*>;
+      for (count -= 1 ; count > 0 && !failed_ ; count -= 1)
+	    res->push_back(read_expr());
+
+      return res;
+}
+
+/*
+ * Read an ExpName (or nil) where the constructor of the enclosing
+ * expression requires one.
+ */
+static ExpName* read_name(BinaryReader&in)
+{
+      Expression*tmp = in.read_expr();
+      ExpName*res = dynamic_cast<ExpName*>(tmp);
+      if (tmp && !res)
+	    in.fail("expected a name expression");
+      return res;
+}
+
+static bool binary_operands(BinaryReader&in, uint64_t&fun, uint64_t max_fun,
+			    Expression*&op1, Expression*&op2)
+{
+      fun = in.read_uint();
+      op1 = in.read_expr();
+      op2 = in.read_expr();
+      if (fun > max_fun || op1 == 0 || op2 == 0) {
+	    in.fail("bad binary expression");
+	    return false;
+      }
+      return true;
+}
+
+Expression* BinaryReader::read_expr()
+{
+      uint64_t tag = read_uint();
+      if (failed_ || tag == BE_NULL)
+	    return 0;
+
+      LineInfo line;
+      read_line(line);
+
+      Expression*res = 0;
+      uint64_t fun;
+      Expression*op1, *op2;
+
+      switch (tag) {
+	  case BE_AGGREGATE: {
+		list<ExpAggregate::element_t*>*elements = new list<ExpAggregate::element_t*>;
+		for (uint64_t cnt = read_count() ; cnt > 0 && !failed_ ; cnt -= 1) {
+		      list<ExpAggregate::choice_t*> fields;
+		      for (uint64_t fdx = read_count() ; fdx > 0 && !failed_ ; fdx -= 1) {
+			    Expression*expr = read_expr();
+			    ExpRange*range = dynamic_cast<ExpRange*>(read_expr());
+			    if (expr)
+				  fields.push_back(new ExpAggregate::choice_t(expr));
+			    else if (range)
+				  fields.push_back(new ExpAggregate::choice_t(range));
+			    else
+				  fields.push_back(new ExpAggregate::choice_t());
+		      }
+		      Expression*val = read_expr();
+		      elements->push_back(new ExpAggregate::element_t(&fields, val));
+		}
+		res = new ExpAggregate(elements);
+		break;
+	  }
+
+	  case BE_ARITHMETIC:
+	    if (binary_operands(*this, fun, ExpArithmetic::xCONCAT, op1, op2))
+		  res = new ExpArithmetic((ExpArithmetic::fun_t)fun, op1, op2);
+	    break;
+
+	  case BE_OBJ_ATTRIBUTE: {
+		ExpName*base = read_name(*this);
+		perm_string name = read_string();
+		list<Expression*>*args = read_expr_list();
+		res = new ExpObjAttribute(base, name, args);
+		break;
+	  }
+
+	  case BE_TYPE_ATTRIBUTE: {
+		const VType*base = read_type();
+		perm_string name = read_string();
+		list<Expression*>*args = read_expr_list();
+		res = new ExpTypeAttribute(base, name, args);
+		break;
+	  }
+
+	  case BE_BITSTRING:
+	    res = new ExpBitstring(read_text().c_str());
+	    break;
+
+	  case BE_CHARACTER:
+	    res = new ExpCharacter((char)read_uint());
+	    break;
+
+	  case BE_CONCAT:
+	    op1 = read_expr();
+	    op2 = read_expr();
+	    res = new ExpConcat(op1, op2);
+	    break;
+
+	  case BE_FUNC: {
+		perm_string name = read_string();
+		list<Expression*> args;
+		for (uint64_t cnt = read_count() ; cnt > 0 && !failed_ ; cnt -= 1)
+		      args.push_back(read_expr());
+		res = args.empty()
+		      ? new ExpFunc(name)
+		      : new ExpFunc(name, &args);
+		break;
+	  }
+
+	  case BE_INTEGER:
+	    res = new ExpInteger(read_int());
+	    break;
+
+	  case BE_REAL:
+	    res = new ExpReal(read_real());
+	    break;
+
+	  case BE_LOGICAL:
+	    if (binary_operands(*this, fun, ExpLogical::XNOR, op1, op2))
+		  res = new ExpLogical((ExpLogical::fun_t)fun, op1, op2);
+	    break;
+
+	  case BE_NAME: {
+		ExpName*prefix = read_name(*this);
+		perm_string name = read_string();
+		list<Expression*>*indices = read_expr_list();
+		res = new ExpName(prefix, name, indices);
+		break;
+	  }
+
+	  case BE_NAME_ALL:
+	    res = new ExpNameALL;
+	    break;
+
+	  case BE_RELATION:
+	    if (binary_operands(*this, fun, ExpRelation::GE, op1, op2))
+		  res = new ExpRelation((ExpRelation::fun_t)fun, op1, op2);
+	    break;
+
+	  case BE_SCOPED_NAME: {
+		perm_string scope = read_string();
+		ExpName*name = read_name(*this);
+		if (name == 0)
+		      fail("scoped name without a name");
+		else
+		      res = new ExpScopedName(scope, name);
+		break;
+	  }
+
+	  case BE_SHIFT:
+	    if (binary_operands(*this, fun, ExpShift::ROR, op1, op2))
+		  res = new ExpShift((ExpShift::shift_t)fun, op1, op2);
+	    break;
+
+	  case BE_STRING:
+	    res = new ExpString(read_text().c_str());
+	    break;
+
+	  case BE_UABS:
+	    res = new ExpUAbs(read_expr());
+	    break;
+
+	  case BE_UNOT:
+	    res = new ExpUNot(read_expr());
+	    break;
+
+	  case BE_UMINUS:
+	    res = new ExpUMinus(read_expr());
+	    break;
+
+	  case BE_TIME: {
+		uint64_t amount = read_uint();
+		uint64_t unit = read_uint();
+		if (unit > ExpTime::S)
+		      fail("bad time unit");
+		else
+		      res = new ExpTime(amount, (ExpTime::timeunit_t)unit);
+		break;
+	  }
+
+	  case BE_RANGE:
+	    if (read_bool()) {
+		  ExpName*base = read_name(*this);
+		  bool reverse = read_bool();
+		  res = new ExpRange(base, reverse);
+	    } else {
+		  op1 = read_expr();
+		  op2 = read_expr();
+		  uint64_t dir = read_uint();
+		  if (dir > ExpRange::AUTO)
+			fail("bad range direction");
+		  else
+			res = new ExpRange(op1, op2, (ExpRange::range_dir_t)dir);
+	    }
+	    break;
+
+	  default:
+	    fail("bad expression record");
+	    break;
+      }
+
+      if (failed_)
+	    return 0;
+
+      res->set_line(line);
+      return res;
+}
@@ -24,8 +24,10 @@
 # include  "parse_misc.h"
 # include  "compiler.h"
 # include  "package.h"
+# include  "library_binary.h"
 # include  "std_types.h"
 # include  "std_funcs.h"
+# include  <cstdio>
 # include  <fstream>
 # include  <list>
 # include  <map>
@@ -110,6 +112,30 @@ static string make_library_package_path(perm_string lib_name, perm_string name)
       return path;
 }
 
+/*
+ * The precompiled image of a package is kept next to its text.
+ */
+static string make_binary_package_path(const string&path)
+{
+      return path + "b";
+}
+
+/*
+ * Load the package from its precompiled image if there is a usable
+ * one, or by parsing the text otherwise. The return code is that of
+ * parse_source_file.
+ */
+static int load_library_package(const string&path, perm_string library)
+{
+      if (precompiled_packages_flag) {
+	    string bin_path = make_binary_package_path(path);
+	    if (library_binary_load(bin_path.c_str(), path.c_str(), library))
+		  return 0;
+      }
+
+      return parse_source_file(path.c_str(), library);
+}
+
 static void import_ieee(void);
 static void import_ieee_use(const YYLTYPE&loc, ActiveScope*res, perm_string package, perm_string name);
 static void import_std_use(const YYLTYPE&loc, ActiveScope*res, perm_string package, perm_string name);
@@ -258,7 +284,7 @@ void library_use(const YYLTYPE&loc, ActiveScope*res,
 	// parsed, then see if it exists unparsed.
       if (use_library=="work" && pack == 0) {
 	    string path = make_work_package_path(use_package.str());
-	    parse_source_file(path.c_str(), use_library);
+	    load_library_package(path, use_library);
 	    pack = lib.packages[use_package];
       } else if (use_library != "ieee" && pack == 0) {
 	    string path = make_library_package_path(use_library, use_package);
@@ -266,7 +292,7 @@ void library_use(const YYLTYPE&loc, ActiveScope*res,
 		  errormsg(loc, "Unable to find library %s\n", use_library.str());
 		  return;
 	    }
-	    int rc = parse_source_file(path.c_str(), use_library);
+	    int rc = load_library_package(path, use_library);
 	    if (rc < 0)
 		  errormsg(loc, "Unable to open library file %s\n", path.c_str());
 	    else if (rc > 0)
@@ -442,6 +468,13 @@ static int emit_packages(perm_string, const map<perm_string,Package*>&packages)
 	    string path = make_work_package_path((*cur)->name());
 	    ofstream file (path.c_str(), ios_base::out);
 	    (*cur)->write_to_stream(file);
+	    file.close();
+
+	    string bin_path = make_binary_package_path(path);
+	    if (precompiled_packages_flag)
+		  library_binary_save(*cur, bin_path.c_str(), path.c_str());
+	    else
+		  remove(bin_path.c_str());
       }
 
       return errors;
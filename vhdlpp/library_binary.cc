@@ -0,0 +1,597 @@
+/*
+ * Copyright (c) 2026 the Icarus Verilog contributors
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "version_base.h"
+# include  "version_tag.h"
+# include  "library_binary.h"
+# include  "compiler.h"
+# include  "package.h"
+# include  "parse_misc.h"
+# include  "std_types.h"
+# include  "subprogram.h"
+# include  "vsignal.h"
+# include  <fstream>
+# include  <sstream>
+# include  <cstdio>
+# include  <cstring>
+
+using namespace std;
+
+static const char binary_magic[] = "Icarus Verilog VHDL package";
+static const char binary_version[] = VERSION " (" VERSION_TAG ")";
+
+BinaryWriter::BinaryWriter(ostream&fd)
+: fd_(fd), unsupported_(0)
+{
+}
+
+void BinaryWriter::write_uint(uint64_t val)
+{
+      while (val >= 0x80) {
+	    fd_.put((char)(0x80 | (val & 0x7f)));
+	    val >>= 7;
+      }
+      fd_.put((char)val);
+}
+
+void BinaryWriter::write_int(int64_t val)
+{
+	// Zig-zag encoding keeps small negative numbers small.
+      uint64_t tmp = (uint64_t)val << 1;
+      if (val < 0)
+	    tmp = ~tmp;
+      write_uint(tmp);
+}
+
+void BinaryWriter::write_real(double val)
+{
+      uint64_t tmp;
+      memcpy(&tmp, &val, sizeof tmp);
+      write_uint(tmp);
+}
+
+void BinaryWriter::write_text(const string&val)
+{
+      write_uint(val.size());
+      fd_.write(val.data(), val.size());
+}
+
+/*
+ * A string is written as 0 for a nil string, 1 followed by the text
+ * for the first occurrence of a string, or 2+N for the Nth distinct
+ * string.
+ */
+void BinaryWriter::write_string(perm_string val)
+{
+      if (val.nil()) {
+	    write_uint(0);
+	    return;
+      }
+
+      map<const char*,uint64_t>::const_iterator cur = strings_.find(val.str());
+      if (cur != strings_.end()) {
+	    write_uint(cur->second + 2);
+	    return;
+      }
+
+      uint64_t id = strings_.size();
+      strings_[val.str()] = id;
+      write_uint(1);
+      write_text(val.str());
+}
+
+void BinaryWriter::write_line(const LineInfo&li)
+{
+      write_string(li.get_file());
+      write_uint(li.get_lineno());
+}
+
+void BinaryWriter::unsupported(const char*what)
+{
+      if (unsupported_ == 0)
+	    unsupported_ = what;
+}
+
+BinaryReader::BinaryReader(const string&data)
+: data_(data), pos_(0), failed_(0)
+{
+}
+
+void BinaryReader::fail(const char*why)
+{
+      if (failed_ == 0)
+	    failed_ = why;
+}
+
+uint64_t BinaryReader::read_uint()
+{
+      uint64_t res = 0;
+      for (unsigned shift = 0 ; !failed_ ; shift += 7) {
+	    if (pos_ >= data_.size() || shift > 63) {
+		  fail("truncated image");
+		  break;
+	    }
+	    unsigned char byte = data_[pos_++];
+	    res |= (uint64_t)(byte & 0x7f) << shift;
+	    if ((byte & 0x80) == 0)
+		  return res;
+      }
+      return 0;
+}
+
+uint64_t BinaryReader::read_count()
+{
+      uint64_t res = read_uint();
+	// Every item takes at least one byte.
+      if (res > data_.size() - pos_ + 1) {
+	    fail("bad item count");
+	    return 0;
+      }
+      return res;
+}
+
+int64_t BinaryReader::read_int()
+{
+      uint64_t tmp = read_uint();
+      if (tmp & 1)
+	    tmp = ~tmp;
+      return (int64_t)(tmp >> 1) | (int64_t)(tmp & ((uint64_t)1 << 63));
+}
+
+double BinaryReader::read_real()
+{
+      uint64_t tmp = read_uint();
+      double res;
+      memcpy(&res, &tmp, sizeof res);
+      return res;
+}
+
+string BinaryReader::read_text()
+{
+      uint64_t size = read_uint();
+      if (failed_)
+	    return string();
+      if (size > data_.size() - pos_) {
+	    fail("truncated image");
+	    return string();
+      }
+
+      string res = data_.substr(pos_, size);
+      pos_ += size;
+      return res;
+}
+
+perm_string BinaryReader::read_string()
+{
+      uint64_t id = read_uint();
+      if (failed_ || id == 0)
+	    return perm_string();
+
+      if (id == 1) {
+	    string text = read_text();
+	    perm_string res = text.empty()
+		  ? empty_perm_string
+		  : lex_strings.make(text);
+	    strings_.push_back(res);
+	    return res;
+      }
+
+      if (id - 2 >= strings_.size()) {
+	    fail("bad string reference");
+	    return perm_string();
+      }
+      return strings_[id - 2];
+}
+
+void BinaryReader::read_line(LineInfo&li)
+{
+      perm_string file = read_string();
+      unsigned lineno = read_uint();
+      if (! file.nil())
+	    li.set_file(file);
+      li.set_lineno(lineno);
+}
+
+static void write_port(BinaryWriter&out, const InterfacePort*port)
+{
+      out.write_line(*port);
+      out.write_uint(port->mode);
+      out.write_string(port->name);
+      out.write_type(port->type);
+      out.write_expr(port->expr);
+}
+
+static InterfacePort* read_port(BinaryReader&in)
+{
+      LineInfo line;
+      in.read_line(line);
+      uint64_t mode = in.read_uint();
+      perm_string name = in.read_string();
+      const VType*type = in.read_type();
+      Expression*expr = in.read_expr();
+      if (mode > PORT_INOUT) {
+	    in.fail("bad port mode");
+	    return 0;
+      }
+
+      InterfacePort*res = new InterfacePort((port_mode_t)mode, name, type, expr);
+      res->set_line(line);
+      return res;
+}
+
+static list<InterfacePort*>* read_ports(BinaryReader&in)
+{
+      list<InterfacePort*>*res = new list<InterfacePort*>;
+      for (uint64_t cnt = in.read_count() ; cnt > 0 && !in.failed() ; cnt -= 1)
+	    res->push_back(read_port(in));
+      return res;
+}
+
+void ComponentBase::write_to_binary(BinaryWriter&out) const
+{
+      out.write_line(*this);
+      out.write_string(name_);
+      out.write_uint(parms_.size());
+      for (size_t idx = 0 ; idx < parms_.size() ; idx += 1)
+	    write_port(out, parms_[idx]);
+      out.write_uint(ports_.size());
+      for (size_t idx = 0 ; idx < ports_.size() ; idx += 1)
+	    write_port(out, ports_[idx]);
+}
+
+static ComponentBase* read_component(BinaryReader&in)
+{
+      LineInfo line;
+      in.read_line(line);
+      perm_string name = in.read_string();
+      list<InterfacePort*>*parms = read_ports(in);
+      list<InterfacePort*>*ports = read_ports(in);
+
+      ComponentBase*res = new ComponentBase(name);
+      res->set_line(line);
+      res->set_interface(parms, ports);
+      delete parms;
+      delete ports;
+      return res;
+}
+
+void Variable::write_to_binary(BinaryWriter&out) const
+{
+      out.write_line(*this);
+      out.write_string(peek_name());
+      out.write_type(peek_type());
+      out.write_expr(peek_init_expr());
+}
+
+void SubprogramBody::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(new_variables_.size());
+      for (map<perm_string,Variable*>::const_iterator cur = new_variables_.begin()
+		 ; cur != new_variables_.end() ; ++cur) {
+	    cur->second->write_to_binary(out);
+      }
+
+      if (statements_) {
+	    out.write_bool(true);
+	    out.write_stmt_list(*statements_);
+      } else {
+	    out.write_bool(false);
+      }
+}
+
+void SubprogramHeader::write_to_binary(BinaryWriter&out) const
+{
+	// Subprograms from the standard libraries are created by the
+	// compiler itself, and are never part of a library package.
+      if (is_std()) {
+	    out.unsupported("standard subprogram");
+	    return;
+      }
+
+      out.write_line(*this);
+      out.write_string(name_);
+      if (ports_) {
+	    out.write_uint(ports_->size() + 1);
+	    for (list<InterfacePort*>::const_iterator cur = ports_->begin()
+		       ; cur != ports_->end() ; ++cur) {
+		  write_port(out, *cur);
+	    }
+      } else {
+	    out.write_uint(0);
+      }
+      out.write_type(return_type_);
+
+      out.write_bool(body_ != 0);
+      if (body_)
+	    body_->write_to_binary(out);
+}
+
+static SubprogramHeader* read_subprogram(BinaryReader&in)
+{
+      LineInfo line;
+      in.read_line(line);
+      perm_string name = in.read_string();
+
+      list<InterfacePort*>*ports = 0;
+      uint64_t count = in.read_count();
+      if (count > 0) {
+	    ports = new list<InterfacePort*>;
+	    for (count -= 1 ; count > 0 && !in.failed() ; count -= 1)
+		  ports->push_back(read_port(in));
+      }
+      const VType*return_type = in.read_type();
+
+      SubprogramHeader*res = new SubprogramHeader(name, ports, return_type);
+      res->set_line(line);
+
+      if (! in.read_bool())
+	    return res;
+
+	// The parser collects the variables of the body in the active
+	// scope and transfers them into the body. Do the same here.
+      ActiveScope vars;
+      for (count = in.read_count() ; count > 0 && !in.failed() ; count -= 1) {
+	    LineInfo var_line;
+	    in.read_line(var_line);
+	    perm_string var_name = in.read_string();
+	    const VType*var_type = in.read_type();
+	    Expression*var_init = in.read_expr();
+	    Variable*var = new Variable(var_name, var_type, var_init);
+	    var->set_line(var_line);
+	    vars.bind_name(var_name, var);
+      }
+
+      SubprogramBody*body = new SubprogramBody();
+      body->transfer_from(vars, ScopeBase::VARIABLES);
+      if (in.read_bool()) {
+	    list<SequentialStmt*>*stmts = new list<SequentialStmt*>;
+	    in.read_stmt_list(*stmts);
+	    body->set_statements(stmts);
+      }
+      res->set_body(body);
+      return res;
+}
+
+/*
+ * This writes the same declarations that Package::write_to_stream
+ * writes. Like there, the types that the package uses from other
+ * packages are written along with the types that it declares, so the
+ * loaded package declares them all.
+ */
+void Package::write_to_binary(BinaryWriter&out) const
+{
+      out.write_string(name_);
+      out.write_line(*this);
+
+      list<pair<perm_string,const VType*> > types;
+      for (map<perm_string,const VType*>::const_iterator cur = use_types_.begin()
+		 ; cur != use_types_.end() ; ++cur) {
+	    if (! is_global_type(cur->first))
+		  types.push_back(*cur);
+      }
+      types.insert(types.end(), cur_types_.begin(), cur_types_.end());
+
+      out.write_uint(types.size());
+      for (list<pair<perm_string,const VType*> >::const_iterator cur = types.begin()
+		 ; cur != types.end() ; ++cur) {
+	    out.write_string(cur->first);
+	    out.write_type(cur->second);
+      }
+
+      size_t count = 0;
+      for (map<perm_string,struct const_t*>::const_iterator cur = cur_constants_.begin()
+		 ; cur != cur_constants_.end() ; ++cur) {
+	    if (cur->second && cur->second->typ)
+		  count += 1;
+      }
+
+      out.write_uint(count);
+      for (map<perm_string,struct const_t*>::const_iterator cur = cur_constants_.begin()
+		 ; cur != cur_constants_.end() ; ++cur) {
+	    if (cur->second==0 || cur->second->typ==0)
+		  continue;
+	    out.write_string(cur->first);
+	    out.write_type(cur->second->typ);
+	    out.write_expr(cur->second->val);
+      }
+
+      count = 0;
+      for (map<perm_string,SubHeaderList>::const_iterator cur = cur_subprograms_.begin()
+		 ; cur != cur_subprograms_.end() ; ++cur) {
+	    count += cur->second.size();
+      }
+
+      out.write_uint(count);
+      for (map<perm_string,SubHeaderList>::const_iterator cur = cur_subprograms_.begin()
+		 ; cur != cur_subprograms_.end() ; ++cur) {
+	    for (SubHeaderList::const_iterator it = cur->second.begin()
+		       ; it != cur->second.end() ; ++it) {
+		  (*it)->write_to_binary(out);
+	    }
+      }
+
+      out.write_uint(old_components_.size() + new_components_.size());
+      for (map<perm_string,ComponentBase*>::const_iterator cur = old_components_.begin()
+		 ; cur != old_components_.end() ; ++cur) {
+	    cur->second->write_to_binary(out);
+      }
+      for (map<perm_string,ComponentBase*>::const_iterator cur = new_components_.begin()
+		 ; cur != new_components_.end() ; ++cur) {
+	    cur->second->write_to_binary(out);
+      }
+}
+
+/*
+ * The image records the size and a hash (64 bit FNV-1a) of the text it
+ * was written next to. File times are no good for this, as they may
+ * have a resolution of a second or more and the text is usually
+ * written in the same second as the image.
+ */
+static bool source_digest(const char*path, uint64_t&size, uint64_t&hash)
+{
+      ifstream file (path, ios_base::in|ios_base::binary);
+      if (! file.is_open())
+	    return false;
+
+      char buf[4096];
+      size = 0;
+      hash = 0xcbf29ce484222325ULL;
+      while (file.read(buf, sizeof buf) || file.gcount() > 0) {
+	    size_t cnt = file.gcount();
+	    for (size_t idx = 0 ; idx < cnt ; idx += 1) {
+		  hash ^= (unsigned char)buf[idx];
+		  hash *= 0x100000001b3ULL;
+	    }
+	    size += cnt;
+      }
+
+      return ! file.bad();
+}
+
+bool library_binary_save(const Package*pack, const char*path,
+			 const char*source_path)
+{
+      uint64_t src_size, src_hash;
+      if (! source_digest(source_path, src_size, src_hash)) {
+	    remove(path);
+	    return false;
+      }
+
+      ostringstream buf;
+      BinaryWriter out (buf);
+
+      out.write_text(binary_magic);
+      out.write_uint(LIBRARY_BINARY_FORMAT);
+      out.write_text(binary_version);
+      out.write_uint(src_size);
+      out.write_uint(src_hash);
+      pack->write_to_binary(out);
+
+	// Never leave an image behind that does not match the text,
+	// or a stale image from an earlier run would be loaded.
+      if (out.unsupported()) {
+	    if (verbose_flag)
+		  cerr << "Not writing precompiled package " << path
+		       << ": unsupported " << out.unsupported() << endl;
+	    remove(path);
+	    return false;
+      }
+
+      ofstream file (path, ios_base::out|ios_base::binary);
+      string data = buf.str();
+      file.write(data.data(), data.size());
+      file.close();
+      if (file.fail()) {
+	    remove(path);
+	    return false;
+      }
+
+      return true;
+}
+
+Package* library_binary_load(const char*path, const char*source_path,
+			     perm_string library_name)
+{
+      ifstream file (path, ios_base::in|ios_base::binary);
+      if (! file.is_open())
+	    return 0;
+
+      ostringstream buf;
+      buf << file.rdbuf();
+      string data = buf.str();
+      BinaryReader in (data);
+
+      if (in.read_text() != binary_magic
+	  || in.read_uint() != LIBRARY_BINARY_FORMAT
+	  || in.read_text() != binary_version) {
+	    if (verbose_flag)
+		  cerr << "Precompiled package " << path
+		       << " is from another compiler version" << endl;
+	    return 0;
+      }
+
+	// If the text is not the text the image was written from,
+	// then the text wins.
+      uint64_t img_size = in.read_uint();
+      uint64_t img_hash = in.read_uint();
+      uint64_t src_size, src_hash;
+      if (! source_digest(source_path, src_size, src_hash)
+	  || src_size != img_size || src_hash != img_hash) {
+	    if (verbose_flag)
+		  cerr << "Precompiled package " << path
+		       << " does not match " << source_path << endl;
+	    return 0;
+      }
+
+      perm_string name = in.read_string();
+      LineInfo line;
+      in.read_line(line);
+
+	// Collect the declarations the way the parser does when it
+	// parses the package text.
+      ActiveScope scope;
+
+      for (uint64_t cnt = in.read_count() ; cnt > 0 && !in.failed() ; cnt -= 1) {
+	    perm_string type_name = in.read_string();
+	    const VType*type = in.read_type();
+	    scope.bind_name(type_name, type);
+      }
+
+      for (uint64_t cnt = in.read_count() ; cnt > 0 && !in.failed() ; cnt -= 1) {
+	    perm_string const_name = in.read_string();
+	    const VType*type = in.read_type();
+	    Expression*val = in.read_expr();
+	    scope.bind_name(const_name, type, val);
+      }
+
+      for (uint64_t cnt = in.read_count() ; cnt > 0 && !in.failed() ; cnt -= 1) {
+	    SubprogramHeader*subp = read_subprogram(in);
+	    if (subp)
+		  scope.bind_subprogram(subp->name(), subp);
+      }
+
+      for (uint64_t cnt = in.read_count() ; cnt > 0 && !in.failed() ; cnt -= 1) {
+	    ComponentBase*comp = read_component(in);
+	    scope.bind_name(comp->get_name(), comp);
+      }
+
+      if (! in.failed() && ! in.at_end())
+	    in.fail("trailing data");
+
+      if (in.failed() || name.nil()) {
+	    if (verbose_flag)
+		  cerr << "Precompiled package " << path << " is unusable: "
+		       << (in.failed()? in.failed() : "no name") << endl;
+	    return 0;
+      }
+
+      for (list<const VTypeEnum*>::const_iterator cur = in.enums().begin()
+		 ; cur != in.enums().end() ; ++cur) {
+	    scope.use_enum(*cur);
+      }
+
+      Package*pack = new Package(name, scope);
+      pack->set_line(line);
+      library_save_package(library_name, pack);
+
+      if (verbose_flag)
+	    cerr << "Loaded precompiled package " << path << endl;
+
+      return pack;
+}
@@ -0,0 +1,180 @@
+#ifndef IVL_library_binary_H
+#define IVL_library_binary_H
+/*
+ * Copyright (c) 2026 the Icarus Verilog contributors
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "StringHeap.h"
+# include  <iostream>
+# include  <list>
+# include  <map>
+# include  <string>
+# include  <vector>
+# include  <inttypes.h>
+
+class ActiveScope;
+class Expression;
+class LineInfo;
+class Package;
+class SequentialStmt;
+class VType;
+class VTypeEnum;
+
+/*
+ * Packages that are saved to a library are written as VHDL text
+ * (<name>.pkg) that the parser can read back in. Next to that file a
+ * precompiled image of the same package (<name>.pkgb) is written, and
+ * library_use() loads that instead of running the lexor and parser
+ * over the text again.
+ *
+ * The image is the structure of the package as the parser would have
+ * built it: types, constants, subprograms (with bodies) and
+ * components. It is loaded by calling the same constructors the
+ * parser calls, and the loaded package is elaborated like any other.
+ * The image starts with a header that records the format version, the
+ * compiler version and the size and hash of the text it was written
+ * with. An image that does not match this compiler and the current
+ * text exactly is ignored in favor of the text.
+ *
+ * Within the image, numbers are written as variable length integers,
+ * each distinct string is written once and then referred to by index,
+ * and each VType object is written once and then referred to by index
+ * so that shared types remain shared after loading.
+ */
+
+  // Bump this whenever the layout of any record changes.
+const unsigned LIBRARY_BINARY_FORMAT = 2;
+
+enum binary_type_tag_t {
+      BT_NULL = 0, BT_REF, BT_GLOBAL, BT_PRIMITIVE, BT_ARRAY,
+      BT_RANGE_CONST, BT_RANGE_EXPR, BT_ENUM, BT_RECORD, BT_DEF,
+      BT_SUBTYPE_DEF
+};
+
+enum binary_expr_tag_t {
+      BE_NULL = 0, BE_AGGREGATE, BE_ARITHMETIC, BE_OBJ_ATTRIBUTE,
+      BE_TYPE_ATTRIBUTE, BE_BITSTRING, BE_CHARACTER, BE_CONCAT, BE_FUNC,
+      BE_INTEGER, BE_REAL, BE_LOGICAL, BE_NAME, BE_NAME_ALL, BE_RELATION,
+      BE_SCOPED_NAME, BE_SHIFT, BE_STRING, BE_UABS, BE_UNOT, BE_UMINUS,
+      BE_TIME, BE_RANGE
+};
+
+enum binary_stmt_tag_t {
+      BS_NULL = 0, BS_IF, BS_RETURN, BS_SIGNAL_ASSIGN, BS_CASE,
+      BS_PROCEDURE_CALL, BS_VARIABLE_ASSIGN, BS_WHILE, BS_FOR, BS_LOOP,
+      BS_REPORT, BS_ASSERT, BS_WAIT_FOR, BS_WAIT
+};
+
+class BinaryWriter {
+
+    public:
+      explicit BinaryWriter(std::ostream&fd);
+
+      void write_uint(uint64_t val);
+      void write_int(int64_t val);
+      void write_bool(bool val) { write_uint(val? 1 : 0); }
+      void write_real(double val);
+      void write_text(const std::string&val);
+      void write_string(perm_string val);
+      void write_line(const LineInfo&li);
+
+	// These handle nil pointers, so the matching read_* method
+	// may return nil.
+      void write_type(const VType*type);
+      void write_expr(const Expression*expr);
+      void write_stmt(const SequentialStmt*stmt);
+
+      void write_expr_list(const std::list<Expression*>*items);
+      void write_stmt_list(const std::list<SequentialStmt*>&items);
+
+	// Objects that have no binary form call this. The image is
+	// then incomplete and must not be saved.
+      void unsupported(const char*what);
+      const char*unsupported() const { return unsupported_; }
+
+    private:
+      std::ostream&fd_;
+      std::map<const char*,uint64_t> strings_;
+      std::map<const VType*,uint64_t> types_;
+      const char*unsupported_;
+};
+
+class BinaryReader {
+
+    public:
+	// The reader works on the entire image in memory.
+      explicit BinaryReader(const std::string&data);
+
+      uint64_t read_uint();
+	// Read the count of items that follow. This fails if the
+	// count is larger than the rest of the image could hold.
+      uint64_t read_count();
+      int64_t read_int();
+      bool read_bool() { return read_uint() != 0; }
+      double read_real();
+      std::string read_text();
+      perm_string read_string();
+      void read_line(LineInfo&li);
+
+      const VType*read_type();
+      Expression*read_expr();
+      SequentialStmt*read_stmt();
+
+      std::list<Expression*>*read_expr_list();
+      void read_stmt_list(std::list<SequentialStmt*>&items);
+
+	// Enumeration types that were created while reading. The
+	// package scope needs to know about them.
+      const std::list<const VTypeEnum*>&enums() const { return enums_; }
+
+	// A read error or a malformed record makes the reader fail,
+	// after which every read returns a null value.
+      void fail(const char*why);
+      const char*failed() const { return failed_; }
+
+      bool at_end() const { return pos_ == data_.size(); }
+
+    private:
+      const std::string&data_;
+      size_t pos_;
+      std::vector<perm_string> strings_;
+      std::vector<const VType*> types_;
+      std::list<const VTypeEnum*> enums_;
+      const char*failed_;
+};
+
+/*
+ * Write the binary image of the package to the path, or remove the
+ * file at the path if the package cannot be written. The source_path
+ * is the text of the package, which must already be written. Return
+ * true if the image was written.
+ */
+extern bool library_binary_save(const Package*pack, const char*path,
+				const char*source_path);
+
+/*
+ * Load the package image at the path and save it in the named
+ * library. Return the package, or nil if the image is missing, stale
+ * (not written from the current source_path text), from another
+ * compiler version or otherwise unusable. The caller falls back to
+ * the text file then.
+ */
+extern Package*library_binary_load(const char*path, const char*source_path,
+				   perm_string library_name);
+
+#endif /* IVL_library_binary_H */
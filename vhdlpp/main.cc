@@ -47,6 +47,10 @@ using namespace std;
  *        Enable debugging of elaborated entities by writing the
  *        elaboration results to the file named <path>.
  *
+ *     precompiled-packages | no-precompiled-packages
+ *        Enable (disable) saving and loading the precompiled binary
+ *        images of library packages. This is enabled by default.
+ *
  **  -v
  *     Verbose operation. Display verbose non-debug information.
  *
@@ -102,6 +106,7 @@ const char NOTICE[] =
 
 
 bool verbose_flag = false;
+bool precompiled_packages_flag = true;
   // Where to dump design entities
 const char*dump_design_entities_path = 0;
 const char*dump_libraries_path = 0;
@@ -127,6 +132,10 @@ static void process_debug_token(const char*word)
 	    debug_log_path = strdup(word+4);
       } else if (strcmp(word, "elaboration") == 0) {
 	    debug_elaboration = true;
+      } else if (strcmp(word, "precompiled-packages") == 0) {
+	    precompiled_packages_flag = true;
+      } else if (strcmp(word, "no-precompiled-packages") == 0) {
+	    precompiled_packages_flag = false;
       }
 }
 
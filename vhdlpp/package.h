@@ -24,6 +24,8 @@
 # include  "LineInfo.h"
 # include  <iostream>
 
+class BinaryWriter;
+
 class Package : public Scope, public LineInfo {
 
     public:
@@ -38,6 +40,9 @@ class Package : public Scope, public LineInfo {
 
 	// This method writes a package header to a library file.
       void write_to_stream(std::ostream&fd) const;
+	// This method writes the package to a precompiled library
+	// image. See library_binary.h.
+      void write_to_binary(BinaryWriter&out) const;
 
       int emit_package(std::ostream&fd) const;
       int elaborate();
@@ -24,6 +24,7 @@
 # include "parse_types.h"
 # include  <set>
 
+class BinaryWriter;
 class ScopeBase;
 class Entity;
 class Expression;
@@ -45,6 +46,10 @@ class SequentialStmt  : public LineInfo {
       virtual int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       virtual void dump(std::ostream&out, int indent) const;
       virtual void write_to_stream(std::ostream&fd);
+	// Write the statement to a precompiled library image.
+	// Statements that have no binary form mark the image
+	// unsupported.
+      virtual void write_to_binary(BinaryWriter&out) const;
 
       // Recursively visits a tree of sequential statements.
       virtual void visit(SeqStmtVisitor& func) { func(this); }
@@ -68,6 +73,7 @@ class LoopStatement : public SequentialStmt {
       int elaborate_substatements(Entity*ent, ScopeBase*scope);
       int emit_substatements(std::ostream&out, Entity*ent, ScopeBase*scope);
       void write_to_stream_substatements(std::ostream&fd);
+      void write_to_binary_substatements(BinaryWriter&out) const;
 
     private:
       perm_string name_;
@@ -88,6 +94,7 @@ class IfSequential  : public SequentialStmt {
 
 	    void condition_write_to_stream(std::ostream&fd);
 	    void statement_write_to_stream(std::ostream&fd);
+	    void write_to_binary(BinaryWriter&out) const;
 
 	    void dump(std::ostream&out, int indent) const;
 	    void visit(SeqStmtVisitor& func);
@@ -110,6 +117,7 @@ class IfSequential  : public SequentialStmt {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
       void dump(std::ostream&out, int indent) const;
       void visit(SeqStmtVisitor& func);
 
@@ -138,6 +146,7 @@ class ReturnStmt  : public SequentialStmt {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
       void dump(std::ostream&out, int indent) const;
 
       const Expression*peek_expr() const { return val_; };
@@ -156,6 +165,7 @@ class SignalSeqAssignment  : public SequentialStmt {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
       void dump(std::ostream&out, int indent) const;
 
     private:
@@ -174,6 +184,7 @@ class CaseSeqStmt : public SequentialStmt {
 	    int elaborate(Entity*ent, ScopeBase*scope);
 	    int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
             void write_to_stream(std::ostream&fd);
+            void write_to_binary(BinaryWriter&out) const;
 	    void visit(SeqStmtVisitor& func);
 
         private:
@@ -193,6 +204,7 @@ class CaseSeqStmt : public SequentialStmt {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
       void visit(SeqStmtVisitor& func);
 
     private:
@@ -210,6 +222,7 @@ class ProcedureCall : public SequentialStmt {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       void dump(std::ostream&out, int indent) const;
+      void write_to_binary(BinaryWriter&out) const;
 
     private:
       perm_string name_;
@@ -226,6 +239,7 @@ class VariableSeqAssignment  : public SequentialStmt {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
       void dump(std::ostream&out, int indent) const;
 
     private:
@@ -242,6 +256,7 @@ class WhileLoopStatement : public LoopStatement {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
       void dump(std::ostream&out, int indent) const;
 
     private:
@@ -257,6 +272,7 @@ class ForLoopStatement : public LoopStatement {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
       void dump(std::ostream&out, int indent) const;
 
     private:
@@ -276,6 +292,7 @@ class BasicLoopStatement : public LoopStatement {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
       void dump(std::ostream&out, int indent) const;
 };
 
@@ -290,6 +307,7 @@ class ReportStmt : public SequentialStmt {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
 
       inline Expression*message() const { return msg_; }
       inline severity_t severity() const { return severity_; }
@@ -310,6 +328,7 @@ class AssertStmt : public ReportStmt {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
 
     private:
       Expression*cond_;
@@ -326,6 +345,7 @@ class WaitForStmt : public SequentialStmt {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
 
     private:
       Expression*delay_;
@@ -340,6 +360,7 @@ class WaitStmt : public SequentialStmt {
       int elaborate(Entity*ent, ScopeBase*scope);
       int emit(std::ostream&out, Entity*entity, ScopeBase*scope);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
 
       inline wait_type_t type() const { return type_; }
 
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2026 the Icarus Verilog contributors
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "library_binary.h"
+# include  "sequential.h"
+# include  "expression.h"
+# include  <typeinfo>
+
+using namespace std;
+
+void BinaryWriter::write_stmt(const SequentialStmt*stmt)
+{
+      if (stmt == 0)
+	    write_uint(BS_NULL);
+      else
+	    stmt->write_to_binary(*this);
+}
+
+void BinaryWriter::write_stmt_list(const list<SequentialStmt*>&items)
+{
+      write_uint(items.size());
+      for (list<SequentialStmt*>::const_iterator cur = items.begin()
+		 ; cur != items.end() ; ++cur) {
+	    write_stmt(*cur);
+      }
+}
+
+void SequentialStmt::write_to_binary(BinaryWriter&out) const
+{
+      out.unsupported(typeid(*this).name());
+}
+
+void LoopStatement::write_to_binary_substatements(BinaryWriter&out) const
+{
+      out.write_string(name_);
+      out.write_stmt_list(stmts_);
+}
+
+void IfSequential::Elsif::write_to_binary(BinaryWriter&out) const
+{
+      out.write_line(*this);
+      out.write_expr(cond_);
+      out.write_stmt_list(if_);
+}
+
+void IfSequential::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_IF);
+      out.write_line(*this);
+      out.write_expr(cond_);
+      out.write_stmt_list(if_);
+      out.write_uint(elsif_.size());
+      for (list<Elsif*>::const_iterator cur = elsif_.begin()
+		 ; cur != elsif_.end() ; ++cur) {
+	    (*cur)->write_to_binary(out);
+      }
+      out.write_stmt_list(else_);
+}
+
+void ReturnStmt::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_RETURN);
+      out.write_line(*this);
+      out.write_expr(val_);
+}
+
+void SignalSeqAssignment::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_SIGNAL_ASSIGN);
+      out.write_line(*this);
+      out.write_expr(lval_);
+      out.write_expr_list(&waveform_);
+}
+
+void CaseSeqStmt::CaseStmtAlternative::write_to_binary(BinaryWriter&out) const
+{
+      out.write_line(*this);
+      out.write_expr_list(exp_);
+      out.write_stmt_list(stmts_);
+}
+
+void CaseSeqStmt::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_CASE);
+      out.write_line(*this);
+      out.write_expr(cond_);
+      out.write_uint(alt_.size());
+      for (list<CaseStmtAlternative*>::const_iterator cur = alt_.begin()
+		 ; cur != alt_.end() ; ++cur) {
+	    (*cur)->write_to_binary(out);
+      }
+}
+
+void ProcedureCall::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_PROCEDURE_CALL);
+      out.write_line(*this);
+      out.write_string(name_);
+      if (param_list_ == 0) {
+	    out.write_uint(0);
+	    return;
+      }
+
+      out.write_uint(param_list_->size() + 1);
+      for (list<named_expr_t*>::const_iterator cur = param_list_->begin()
+		 ; cur != param_list_->end() ; ++cur) {
+	    out.write_string((*cur)->name());
+	    out.write_expr((*cur)->expr());
+      }
+}
+
+void VariableSeqAssignment::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_VARIABLE_ASSIGN);
+      out.write_line(*this);
+      out.write_expr(lval_);
+      out.write_expr(rval_);
+}
+
+void WhileLoopStatement::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_WHILE);
+      out.write_line(*this);
+      out.write_expr(cond_);
+      write_to_binary_substatements(out);
+}
+
+void ForLoopStatement::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_FOR);
+      out.write_line(*this);
+      out.write_string(it_);
+      out.write_expr(range_);
+      write_to_binary_substatements(out);
+}
+
+void BasicLoopStatement::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_LOOP);
+      out.write_line(*this);
+      write_to_binary_substatements(out);
+}
+
+void ReportStmt::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_REPORT);
+      out.write_line(*this);
+      out.write_expr(msg_);
+      out.write_uint(severity_);
+}
+
+void AssertStmt::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_ASSERT);
+      out.write_line(*this);
+      out.write_expr(cond_);
+      out.write_expr(msg_);
+      out.write_uint(severity_);
+}
+
+void WaitForStmt::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BS_WAIT_FOR);
+      out.write_line(*this);
+      out.write_expr(delay_);
+}
+
+void WaitStmt::write_to_binary(BinaryWriter&out) const
+{
+	// The sensitivity list is worked out by elaboration.
+      out.write_uint(BS_WAIT);
+      out.write_line(*this);
+      out.write_uint(type_);
+      out.write_expr(expr_);
+}
+
+void BinaryReader::read_stmt_list(list<SequentialStmt*>&items)
+{
+      for (uint64_t cnt = read_count() ; cnt > 0 && !failed_ ; cnt -= 1)
+	    items.push_back(read_stmt());
+}
+
+static ReportStmt::severity_t read_severity(BinaryReader&in)
+{
+      uint64_t sev = in.read_uint();
+      if (sev > ReportStmt::FAILURE) {
+	    in.fail("bad severity");
+	    return ReportStmt::UNSPECIFIED;
+      }
+      return (ReportStmt::severity_t)sev;
+}
+
+SequentialStmt* BinaryReader::read_stmt()
+{
+      uint64_t tag = read_uint();
+      if (failed_ || tag == BS_NULL)
+	    return 0;
+
+      LineInfo line;
+      read_line(line);
+
+      SequentialStmt*res = 0;
+
+      switch (tag) {
+	  case BS_IF: {
+		Expression*cond = read_expr();
+		list<SequentialStmt*> if_list;
+		read_stmt_list(if_list);
+		list<IfSequential::Elsif*> elsif_list;
+		for (uint64_t cnt = read_count() ; cnt > 0 && !failed_ ; cnt -= 1) {
+		      LineInfo elsif_line;
+		      read_line(elsif_line);
+		      Expression*elsif_cond = read_expr();
+		      list<SequentialStmt*> elsif_stmts;
+		      read_stmt_list(elsif_stmts);
+		      IfSequential::Elsif*tmp = new IfSequential::Elsif(elsif_cond, &elsif_stmts);
+		      tmp->set_line(elsif_line);
+		      elsif_list.push_back(tmp);
+		}
+		list<SequentialStmt*> else_list;
+		read_stmt_list(else_list);
+		res = new IfSequential(cond, &if_list, &elsif_list, &else_list);
+		break;
+	  }
+
+	  case BS_RETURN:
+	    res = new ReturnStmt(read_expr());
+	    break;
+
+	  case BS_SIGNAL_ASSIGN: {
+		Expression*lval = read_expr();
+		list<Expression*>*wav = read_expr_list();
+		res = new SignalSeqAssignment(lval, wav);
+		delete wav;
+		break;
+	  }
+
+	  case BS_CASE: {
+		Expression*cond = read_expr();
+		list<CaseSeqStmt::CaseStmtAlternative*> alts;
+		for (uint64_t cnt = read_count() ; cnt > 0 && !failed_ ; cnt -= 1) {
+		      LineInfo alt_line;
+		      read_line(alt_line);
+		      list<Expression*>*exp = read_expr_list();
+		      list<SequentialStmt*> stmts;
+		      read_stmt_list(stmts);
+		      CaseSeqStmt::CaseStmtAlternative*tmp
+			    = new CaseSeqStmt::CaseStmtAlternative(exp, &stmts);
+		      tmp->set_line(alt_line);
+		      alts.push_back(tmp);
+		}
+		res = new CaseSeqStmt(cond, &alts);
+		break;
+	  }
+
+	  case BS_PROCEDURE_CALL: {
+		perm_string name = read_string();
+		uint64_t count = read_count();
+		if (count == 0) {
+		      res = new ProcedureCall(name);
+		      break;
+		}
+		list<named_expr_t*>*params = new list<named_expr_t*>;
+		for (count -= 1 ; count > 0 && !failed_ ; count -= 1) {
+		      perm_string pname = read_string();
+		      Expression*pexpr = read_expr();
+		      params->push_back(new named_expr_t(pname, pexpr));
+		}
+		res = new ProcedureCall(name, params);
+		break;
+	  }
+
+	  case BS_VARIABLE_ASSIGN: {
+		Expression*lval = read_expr();
+		Expression*rval = read_expr();
+		res = new VariableSeqAssignment(lval, rval);
+		break;
+	  }
+
+	  case BS_WHILE: {
+		Expression*cond = read_expr();
+		perm_string name = read_string();
+		list<SequentialStmt*> stmts;
+		read_stmt_list(stmts);
+		res = new WhileLoopStatement(name, cond, &stmts);
+		break;
+	  }
+
+	  case BS_FOR: {
+		perm_string it = read_string();
+		ExpRange*range = dynamic_cast<ExpRange*>(read_expr());
+		perm_string name = read_string();
+		list<SequentialStmt*> stmts;
+		read_stmt_list(stmts);
+		if (range == 0)
+		      fail("for loop without a range");
+		else
+		      res = new ForLoopStatement(name, it, range, &stmts);
+		break;
+	  }
+
+	  case BS_LOOP: {
+		perm_string name = read_string();
+		list<SequentialStmt*> stmts;
+		read_stmt_list(stmts);
+		res = new BasicLoopStatement(name, &stmts);
+		break;
+	  }
+
+	  case BS_REPORT: {
+		Expression*msg = read_expr();
+		ReportStmt::severity_t sev = read_severity(*this);
+		res = new ReportStmt(msg, sev);
+		break;
+	  }
+
+	  case BS_ASSERT: {
+		Expression*cond = read_expr();
+		Expression*msg = read_expr();
+		ReportStmt::severity_t sev = read_severity(*this);
+		res = new AssertStmt(cond, msg, sev);
+		break;
+	  }
+
+	  case BS_WAIT_FOR:
+	    res = new WaitForStmt(read_expr());
+	    break;
+
+	  case BS_WAIT: {
+		uint64_t type = read_uint();
+		Expression*expr = read_expr();
+		if (type > WaitStmt::FINAL)
+		      fail("bad wait statement");
+		else
+		      res = new WaitStmt((WaitStmt::wait_type_t)type, expr);
+		break;
+	  }
+
+	  default:
+	    fail("bad statement record");
+	    break;
+      }
+
+      if (failed_)
+	    return 0;
+
+      res->set_line(line);
+      return res;
+}
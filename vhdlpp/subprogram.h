@@ -29,6 +29,7 @@
 # include  <list>
 # include  <cassert>
 
+class BinaryWriter;
 class InterfacePort;
 class SequentialStmt;
 class Package;
@@ -52,6 +53,7 @@ class SubprogramBody : public LineInfo, public ScopeBase {
       int emit_package(std::ostream&fd);
 
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       void dump(std::ostream&fd) const;
 
       const SubprogramHeader*header() const { return header_; }
@@ -130,6 +132,7 @@ class SubprogramHeader : public LineInfo {
       int emit_package(std::ostream&fd) const;
 
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       void dump(std::ostream&fd) const;
 
     protected:
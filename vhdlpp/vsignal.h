@@ -24,6 +24,7 @@
 # include  "vtype.h"
 
 class Architecture;
+class BinaryWriter;
 class ScopeBase;
 class Entity;
 class Expression;
@@ -80,6 +81,7 @@ class Variable : public SigVarBase {
 
       int emit(std::ostream&out, Entity*ent, ScopeBase*scope, bool initialize = true);
       void write_to_stream(std::ostream&fd);
+      void write_to_binary(BinaryWriter&out) const;
 };
 
 inline void SigVarBase::count_ref_sequ()
@@ -30,6 +30,7 @@
 # include  "StringHeap.h"
 
 class Architecture;
+class BinaryWriter;
 class ScopeBase;
 class Entity;
 class Expression;
@@ -76,6 +77,11 @@ class VType {
 	// subtypes.
       virtual void write_typedef_to_stream(std::ostream&fd, perm_string name) const;
 
+	// This virtual method writes the type to a precompiled
+	// library image. Types that have no binary form mark the
+	// image unsupported.
+      virtual void write_to_binary(BinaryWriter&out) const;
+
 	// This virtual method writes a human-readable version of the
 	// type to a given file for debug purposes. (Question: is this
 	// really necessary given the write_to_stream method?)
@@ -168,6 +174,7 @@ class VTypePrimitive : public VType {
 
       bool type_match(const VType*that) const;
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       void show(std::ostream&) const;
       int get_width(ScopeBase*scope) const;
 
@@ -223,6 +230,7 @@ class VTypeArray : public VType {
       bool type_match(const VType*that) const;
       void write_to_stream(std::ostream&fd) const;
       void write_type_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       void show(std::ostream&) const;
       int get_width(ScopeBase*scope) const;
 
@@ -302,6 +310,7 @@ class VTypeRangeConst : public VTypeRange {
       int64_t end() const { return end_; }
 
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
 
     private:
       const int64_t start_, end_;
@@ -318,6 +327,7 @@ class VTypeRangeExpr : public VTypeRange {
 
     public: // Virtual methods
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
 
     private:
       // Boundaries
@@ -336,6 +346,7 @@ class VTypeEnum : public VType {
       VType*clone() const { return new VTypeEnum(*this); }
 
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       void show(std::ostream&) const;
       int get_width(ScopeBase*) const { return 32; }
 
@@ -377,6 +388,7 @@ class VTypeRecord : public VType {
       VType*clone() const { return new VTypeRecord(*this); }
 
       void write_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       void show(std::ostream&) const;
       int get_width(ScopeBase*scope) const;
       int emit_def(std::ostream&out, perm_string name) const;
@@ -412,6 +424,7 @@ class VTypeDef : public VType {
 
       virtual void write_to_stream(std::ostream&fd) const;
       void write_type_to_stream(std::ostream&fd) const;
+      void write_to_binary(BinaryWriter&out) const;
       int get_width(ScopeBase*scope) const { return type_->get_width(scope); }
       int emit_typedef(std::ostream&out, typedef_context_t&ctx) const;
 
@@ -432,6 +445,7 @@ class VSubTypeDef : public VTypeDef {
       explicit VSubTypeDef(perm_string name) : VTypeDef(name) {}
       explicit VSubTypeDef(perm_string name, const VType*is) : VTypeDef(name, is) {}
       void write_typedef_to_stream(std::ostream&fd, perm_string name) const;
+      void write_to_binary(BinaryWriter&out) const;
 };
 
 #endif /* IVL_vtype_H */
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2026 the Icarus Verilog contributors
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "library_binary.h"
+# include  "std_types.h"
+# include  "expression.h"
+# include  <typeinfo>
+
+using namespace std;
+
+/*
+ * The global types are not part of any package, so they are written
+ * by their index in this table. Appending to this table is fine, but
+ * changing the order of existing entries requires a new
+ * LIBRARY_BINARY_FORMAT.
+ */
+static const VType*global_type(size_t idx)
+{
+      switch (idx) {
+	  case 0:  return &primitive_BIT;
+	  case 1:  return &primitive_INTEGER;
+	  case 2:  return &primitive_NATURAL;
+	  case 3:  return &primitive_REAL;
+	  case 4:  return &primitive_STDLOGIC;
+	  case 5:  return &primitive_TIME;
+	  case 6:  return &type_BOOLEAN;
+	  case 7:  return &type_FILE_OPEN_KIND;
+	  case 8:  return &type_FILE_OPEN_STATUS;
+	  case 9:  return &primitive_CHARACTER;
+	  case 10: return &primitive_BIT_VECTOR;
+	  case 11: return &primitive_BOOL_VECTOR;
+	  case 12: return &primitive_STDLOGIC_VECTOR;
+	  case 13: return &primitive_STRING;
+	  case 14: return &primitive_SIGNED;
+	  case 15: return &primitive_UNSIGNED;
+	  case 16: return type_BOOLEAN.peek_definition();
+	  case 17: return type_FILE_OPEN_KIND.peek_definition();
+	  case 18: return type_FILE_OPEN_STATUS.peek_definition();
+	  default: return 0;
+      }
+}
+
+static bool find_global_type(const VType*type, size_t&idx)
+{
+      for (idx = 0 ; const VType*cur = global_type(idx) ; idx += 1) {
+	    if (cur == type)
+		  return true;
+      }
+      return false;
+}
+
+void BinaryWriter::write_type(const VType*type)
+{
+      if (type == 0) {
+	    write_uint(BT_NULL);
+	    return;
+      }
+
+      map<const VType*,uint64_t>::const_iterator cur = types_.find(type);
+      if (cur != types_.end()) {
+	    write_uint(BT_REF);
+	    write_uint(cur->second);
+	    return;
+      }
+
+      size_t idx;
+      if (find_global_type(type, idx)) {
+	    write_uint(BT_GLOBAL);
+	    write_uint(idx);
+	    return;
+      }
+
+	// Number the type before writing its parts. The reader does
+	// the same, and this is what lets a type definition refer
+	// back to itself.
+      uint64_t id = types_.size();
+      types_[type] = id;
+      type->write_to_binary(*this);
+}
+
+void VType::write_to_binary(BinaryWriter&out) const
+{
+      out.unsupported(typeid(*this).name());
+}
+
+void VTypePrimitive::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BT_PRIMITIVE);
+      out.write_uint(type_);
+      out.write_bool(packed_);
+}
+
+void VTypeArray::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BT_ARRAY);
+      out.write_type(etype_);
+      out.write_bool(signed_flag_);
+      out.write_uint(ranges_.size());
+      for (vector<range_t>::const_iterator cur = ranges_.begin()
+		 ; cur != ranges_.end() ; ++cur) {
+	    out.write_expr(cur->msb());
+	    out.write_expr(cur->lsb());
+	    out.write_bool(cur->is_downto());
+      }
+      out.write_type(parent_);
+}
+
+void VTypeRangeConst::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BT_RANGE_CONST);
+      out.write_type(base_);
+      out.write_int(start_);
+      out.write_int(end_);
+}
+
+void VTypeRangeExpr::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BT_RANGE_EXPR);
+      out.write_type(base_);
+      out.write_expr(start_);
+      out.write_expr(end_);
+      out.write_bool(downto_);
+}
+
+void VTypeEnum::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BT_ENUM);
+      out.write_uint(names_.size());
+      for (size_t idx = 0 ; idx < names_.size() ; idx += 1)
+	    out.write_string(names_[idx]);
+}
+
+void VTypeRecord::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BT_RECORD);
+      out.write_uint(elements_.size());
+      for (size_t idx = 0 ; idx < elements_.size() ; idx += 1) {
+	    out.write_string(elements_[idx]->peek_name());
+	    out.write_type(elements_[idx]->peek_type());
+      }
+}
+
+void VTypeDef::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BT_DEF);
+      out.write_string(name_);
+      out.write_type(type_);
+}
+
+void VSubTypeDef::write_to_binary(BinaryWriter&out) const
+{
+      out.write_uint(BT_SUBTYPE_DEF);
+      out.write_string(name_);
+      out.write_type(type_);
+}
+
+const VType* BinaryReader::read_type()
+{
+      uint64_t tag = read_uint();
+      if (failed_)
+	    return 0;
+
+      switch (tag) {
+	  case BT_NULL:
+	    return 0;
+
+	  case BT_REF: {
+		uint64_t id = read_uint();
+		if (id >= types_.size() || types_[id] == 0) {
+		      fail("bad type reference");
+		      return 0;
+		}
+		return types_[id];
+	  }
+
+	  case BT_GLOBAL: {
+		const VType*res = global_type(read_uint());
+		if (res == 0)
+		      fail("bad global type");
+		return res;
+	  }
+
+	  default:
+	    break;
+      }
+
+	// All the remaining records define a new type. Reserve its
+	// number now, to match the numbering of the writer.
+      size_t id = types_.size();
+      types_.push_back(0);
+      VType*res = 0;
+
+      switch (tag) {
+	  case BT_PRIMITIVE: {
+		uint64_t type = read_uint();
+		bool packed = read_bool();
+		if (type > VTypePrimitive::TIME) {
+		      fail("bad primitive type");
+		      return 0;
+		}
+		res = new VTypePrimitive((VTypePrimitive::type_t)type, packed);
+		break;
+	  }
+
+	  case BT_ARRAY: {
+		const VType*etype = read_type();
+		bool signed_flag = read_bool();
+		vector<VTypeArray::range_t> ranges (read_count());
+		for (size_t idx = 0 ; idx < ranges.size() && !failed_ ; idx += 1) {
+		      Expression*msb = read_expr();
+		      Expression*lsb = read_expr();
+		      bool downto = read_bool();
+		      ranges[idx] = VTypeArray::range_t(msb, lsb, downto);
+		}
+		VTypeArray*tmp = new VTypeArray(etype, ranges, signed_flag);
+		tmp->set_parent_type(dynamic_cast<const VTypeArray*>(read_type()));
+		res = tmp;
+		break;
+	  }
+
+	  case BT_RANGE_CONST: {
+		const VType*base = read_type();
+		int64_t start = read_int();
+		int64_t end = read_int();
+		res = new VTypeRangeConst(base, start, end);
+		break;
+	  }
+
+	  case BT_RANGE_EXPR: {
+		const VType*base = read_type();
+		Expression*start = read_expr();
+		Expression*end = read_expr();
+		bool downto = read_bool();
+		res = new VTypeRangeExpr(base, start, end, downto);
+		break;
+	  }
+
+	  case BT_ENUM: {
+		list<perm_string> names;
+		for (uint64_t cnt = read_count() ; cnt > 0 && !failed_ ; cnt -= 1)
+		      names.push_back(read_string());
+		VTypeEnum*tmp = new VTypeEnum(&names);
+		enums_.push_back(tmp);
+		res = tmp;
+		break;
+	  }
+
+	  case BT_RECORD: {
+		list<VTypeRecord::element_t*>*elements = new list<VTypeRecord::element_t*>;
+		for (uint64_t cnt = read_count() ; cnt > 0 && !failed_ ; cnt -= 1) {
+		      perm_string name = read_string();
+		      const VType*type = read_type();
+		      elements->push_back(new VTypeRecord::element_t(name, type));
+		}
+		res = new VTypeRecord(elements);
+		break;
+	  }
+
+	  case BT_DEF:
+	  case BT_SUBTYPE_DEF: {
+		perm_string name = read_string();
+		VTypeDef*tmp = tag == BT_DEF
+		      ? new VTypeDef(name)
+		      : new VSubTypeDef(name);
+		  // The definition may refer back to this type.
+		types_[id] = tmp;
+		if (const VType*type = read_type())
+		      tmp->set_definition(type);
+		res = tmp;
+		break;
+	  }
+
+	  default:
+	    fail("bad type record");
+	    return 0;
+      }
+
+      types_[id] = res;
+      return res;
+}
@@ -91,6 +91,8 @@ struct strobe_cb_info {
       vpiHandle*items;
       unsigned nitems;
       unsigned fd_mcd;
+	/* What is known about the items before the call, or nil. */
+      struct display_item*ditems;
 };
 
 /*
@@ -932,59 +934,346 @@ static unsigned int get_format(char **rtn, char *fmt,
   return size - 1;
 }
 
-static unsigned int get_numeric(char **rtn, const struct strobe_cb_info *info,
-                                vpiHandle item)
+/*
+ * The output of get_display() is collected in this buffer. It is
+ * reused by every call, so once it has grown to fit the longest line
+ * displaying a line does not allocate anything.
+ */
+static char*display_buf = 0;
+static size_t display_buf_size = 0;
+static size_t display_buf_len = 0;
+
+static char*display_reserve(size_t cnt)
+{
+      if (display_buf_len + cnt + 1 > display_buf_size) {
+	    display_buf_size = 2 * (display_buf_len + cnt + 1);
+	    if (display_buf_size < 256) display_buf_size = 256;
+	    display_buf = realloc(display_buf, display_buf_size);
+      }
+      return display_buf + display_buf_len;
+}
+
+static void display_append(const char*text, size_t cnt)
+{
+      memcpy(display_reserve(cnt), text, cnt);
+      display_buf_len += cnt;
+}
+
+static void display_append_padded(const char*text, int width)
+{
+      size_t len = strlen(text);
+      if ((size_t)width < len) width = len;
+      display_buf_len += sprintf(display_reserve(width), "%*s", width, text);
+}
+
+/*
+ * A constant format string is compiled once into a list of these
+ * operations. An operation is either literal text, or a format code
+ * with its modifiers that is processed by get_format_char() (or the
+ * fast path in format_fast()) when the line is displayed.
+ */
+struct format_op {
+      const char*text;
+      unsigned len;
+      int ljust, plus, ld_zero, width, prec;
+      char fmt;
+};
+
+/*
+ * This is what is known about each argument of a display task before
+ * the task is called. The type of an argument does not change, so it
+ * is looked up once. Format strings that are constant are compiled.
+ */
+struct display_item {
+      PLI_INT32 type;
+      PLI_INT32 const_type;
+	/* The decimal display width, or -1 if it must be calculated
+	   for each call. */
+      int dec_size;
+	/* The compiled format string, if the argument is one. */
+      char*fmt;
+      struct format_op*ops;
+      unsigned nops;
+	/* The name of a system function argument. */
+      char*func_name;
+};
+
+static struct format_op*compile_format(char*fmt, unsigned*nops)
+{
+      struct format_op*ops = 0;
+      unsigned cnt_ops = 0;
+      char*cp = fmt;
+
+      while (*cp) {
+	    size_t cnt = strcspn(cp, "%");
+	    struct format_op*op;
+
+	    ops = realloc(ops, (cnt_ops+1)*sizeof(struct format_op));
+	    op = ops + cnt_ops;
+	    cnt_ops += 1;
+	    memset(op, 0, sizeof(struct format_op));
+	    op->width = -1;
+	    op->prec = -1;
+
+	    if (cnt > 0) {
+		  op->text = cp;
+		  op->len = cnt;
+		  cp += cnt;
+		  continue;
+	    }
+
+	      /* This parses the format code exactly like get_format(). */
+	    cp += 1;
+	    while ((*cp == '-') || (*cp == '+')) {
+		  if (*cp == '-') op->ljust = 1;
+		  else op->plus = 1;
+		  cp += 1;
+	    }
+	    if (*cp == '0') {
+		  op->ld_zero = 1;
+		  cp += 1;
+	    }
+	    if (isdigit((int)*cp)) op->width = strtoul(cp, &cp, 10);
+	    if (*cp == '.') {
+		  cp += 1;
+		  op->prec = strtoul(cp, &cp, 10);
+	    }
+
+	      /* A plain %% is just text. */
+	    if (*cp == '%' && cp[-1] == '%') {
+		  op->text = cp;
+		  op->len = 1;
+		  cp += 1;
+		  continue;
+	    }
+
+	    op->fmt = *cp;
+	    if (*cp) cp += 1;
+      }
+
+      *nops = cnt_ops;
+      return ops;
+}
+
+static struct display_item*compile_display_items(const struct strobe_cb_info*info)
+{
+      struct display_item*ditems;
+      unsigned idx;
+
+      if (info->nitems == 0) return 0;
+
+      ditems = calloc(info->nitems, sizeof(struct display_item));
+      for (idx = 0 ; idx < info->nitems ; idx += 1) {
+	    vpiHandle item = info->items[idx];
+	    struct display_item*cur = ditems + idx;
+
+	    cur->type = vpi_get(vpiType, item);
+	    cur->dec_size = -1;
+
+	    switch (cur->type) {
+		case vpiConstant:
+		case vpiParameter:
+		  cur->const_type = vpi_get(vpiConstType, item);
+		    /* A string calculated by the thread is different
+		       on each call, so only a true constant string
+		       can be compiled. */
+		  if (cur->const_type == vpiStringConst &&
+		      vpi_get(_vpiFromThr, item) == _vpiNoThr) {
+			s_vpi_value value;
+			value.format = vpiStringVal;
+			vpi_get_value(item, &value);
+			cur->fmt = strdup(value.value.str);
+			cur->ops = compile_format(cur->fmt, &cur->nops);
+		  }
+		  if (cur->const_type != vpiStringConst)
+			cur->dec_size = vpi_get_dec_size(item);
+		  break;
+
+		case vpiNet:
+		case vpiReg:
+		case vpiBitVar:
+		case vpiByteVar:
+		case vpiShortIntVar:
+		case vpiIntVar:
+		case vpiLongIntVar:
+		case vpiIntegerVar:
+		case vpiMemoryWord:
+		case vpiPartSelect:
+		  cur->dec_size = vpi_get_dec_size(item);
+		  break;
+
+		case vpiSysFuncCall:
+		  cur->func_name = strdup(vpi_get_str(vpiName, item));
+		  break;
+
+		default:
+		  break;
+	    }
+      }
+
+      return ditems;
+}
+
+static void free_display_items(struct display_item*ditems, unsigned nitems)
+{
+      unsigned idx;
+      if (ditems == 0) return;
+      for (idx = 0 ; idx < nitems ; idx += 1) {
+	    free(ditems[idx].fmt);
+	    free(ditems[idx].ops);
+	    free(ditems[idx].func_name);
+      }
+      free(ditems);
+}
+
+static int display_dec_size(const struct strobe_cb_info *info, unsigned idx)
+{
+      int size = info->ditems[idx].dec_size;
+      if (size < 0) size = vpi_get_dec_size(info->items[idx]);
+      return size;
+}
+
+/*
+ * Most format codes in real testbenches are a plain %d, %h, %b or %o
+ * (or one with a single leading zero to strip the leading zeros). For
+ * these the value string is copied directly into the output. Return
+ * false if the format code needs the general processing.
+ */
+static int format_fast(const struct format_op*op,
+                       const struct strobe_cb_info *info, unsigned int *idx)
+{
+      s_vpi_value value;
+
+      if (op->ljust || op->plus || op->width != -1 || op->prec != -1)
+	    return 0;
+      if (*idx+1 >= info->nitems)
+	    return 0;
+
+      switch (op->fmt) {
+	  case 'b':
+	  case 'B':
+	    value.format = vpiBinStrVal;
+	    break;
+	  case 'o':
+	  case 'O':
+	    value.format = vpiOctStrVal;
+	    break;
+	  case 'h':
+	  case 'H':
+	  case 'x':
+	  case 'X':
+	    value.format = vpiHexStrVal;
+	    break;
+	  case 'd':
+	  case 'D':
+	    if (op->ld_zero) return 0;
+	    value.format = vpiDecStrVal;
+	    break;
+	  default:
+	    return 0;
+      }
+
+      vpi_get_value(info->items[*idx+1], &value);
+	/* Let the general code report the error. */
+      if (value.format == vpiSuppressVal)
+	    return 0;
+
+      *idx += 1;
+      if (op->fmt == 'd' || op->fmt == 'D') {
+	    display_append_padded(value.value.str, display_dec_size(info, *idx));
+      } else {
+	    char*cp = value.value.str;
+	    if (op->ld_zero) while (*cp == '0' && *(cp+1) != '\0') cp++;
+	    display_append(cp, strlen(cp));
+      }
+      return 1;
+}
+
+static void run_format(const struct format_op*ops, unsigned nops,
+                       const struct strobe_cb_info *info, unsigned int *idx)
+{
+      unsigned cur;
+      for (cur = 0 ; cur < nops ; cur += 1) {
+	    const struct format_op*op = ops + cur;
+	    char*result;
+	    unsigned int cnt;
+
+	    if (op->text) {
+		  display_append(op->text, op->len);
+		  continue;
+	    }
+
+	    if (format_fast(op, info, idx))
+		  continue;
+
+	    cnt = get_format_char(&result, op->ljust, op->plus, op->ld_zero,
+	                          op->width, op->prec, op->fmt, info, idx);
+	    display_append(result, cnt);
+	    free(result);
+      }
+}
+
+static void get_numeric(const struct strobe_cb_info *info, unsigned idx)
 {
-  int size, min;
   s_vpi_value val;
 
   val.format = info->default_format;
-  vpi_get_value(item, &val);
+  vpi_get_value(info->items[idx], &val);
 
   switch(info->default_format){
     case vpiDecStrVal:
-      size = vpi_get_dec_size(item);
 	/* -1 can be represented as a one bit signed value. This returns
-	 * a size of 1 which is too small for the -1 string value so make
-	 * the string width the minimum display width. */
-      min = strlen(val.value.str);
-      if (size < min) size = min;
-      *rtn = malloc((size+1)*sizeof(char));
-      sprintf(*rtn, "%*s", size, val.value.str);
+	 * a size of 1 which is too small for the -1 string value so the
+	 * string width is the minimum display width. */
+      display_append_padded(val.value.str, display_dec_size(info, idx));
       break;
     default:
-      *rtn = strdup(val.value.str);
+      display_append(val.value.str, strlen(val.value.str));
   }
-
-  return strlen(*rtn);
 }
 
 /* In many places we can't use the normal str functions since %u and %z
- * can insert NULL characters into the stream. */
+ * can insert NULL characters into the stream. The returned string is
+ * in a buffer that is reused by the next call, so must not be freed. */
 static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
 {
-  char *result, *fmt, *rtn, *func_name;
-  const char *cresult;
+  char *result, *fmt;
   s_vpi_value value;
-  unsigned int idx, size, width;
+  unsigned int idx, width;
   char buf[256];
+  struct strobe_cb_info tmp_info;
+
+  /* Display tasks that do not keep their arguments compiled get them
+   * compiled for this one call. */
+  if (info->ditems == 0 && info->nitems > 0) {
+    char *rtn;
+    tmp_info = *info;
+    tmp_info.ditems = compile_display_items(info);
+    rtn = get_display(rtnsz, &tmp_info);
+    free_display_items(tmp_info.ditems, tmp_info.nitems);
+    return rtn;
+  }
 
-  rtn = strdup("");
-  size = 1;
+  display_buf_len = 0;
   for  (idx = 0; idx < info->nitems; idx += 1) {
     vpiHandle item = info->items[idx];
+    const struct display_item *ditem = info->ditems + idx;
 
-    switch (vpi_get(vpiType, item)) {
+    switch (ditem->type) {
 
       case vpiConstant:
       case vpiParameter:
-        if (vpi_get(vpiConstType, item) == vpiStringConst) {
+        if (ditem->ops) {
+          run_format(ditem->ops, ditem->nops, info, &idx);
+        } else if (ditem->const_type == vpiStringConst) {
           value.format = vpiStringVal;
           vpi_get_value(item, &value);
           fmt = strdup(value.value.str);
           width = get_format(&result, fmt, info, &idx);
           free(fmt);
-        } else if (vpi_get(vpiConstType, item) == vpiRealConst) {
+          display_append(result, width);
+          free(result);
+        } else if (ditem->const_type == vpiRealConst) {
           value.format = vpiRealVal;
           vpi_get_value(item, &value);
 #if !defined(__GNUC__)
@@ -999,14 +1288,10 @@ static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
 #else
           sprintf(buf, compatible_flag ? "%g" : "%#g", value.value.real);
 #endif
-          result = strdup(buf);
-          width = strlen(result);
+          display_append(buf, strlen(buf));
         } else {
-          width = get_numeric(&result, info, item);
+          get_numeric(info, idx);
         }
-        rtn = realloc(rtn, (size+width)*sizeof(char));
-        memcpy(rtn+size-1, result, width);
-        free(result);
         break;
 
       case vpiNet:
@@ -1019,10 +1304,7 @@ static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
       case vpiIntegerVar:
       case vpiMemoryWord:
       case vpiPartSelect:
-        width = get_numeric(&result, info, item);
-        rtn = realloc(rtn, (size+width)*sizeof(char));
-        memcpy(rtn+size-1, result, width);
-        free(result);
+        get_numeric(info, idx);
         break;
 
       /* It appears that this is not currently used! A time variable is
@@ -1033,10 +1315,7 @@ static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
         vpi_get_value(item, &value);
         get_time(buf, value.value.str, timeformat_info.prec,
                  vpi_get(vpiTimeUnit, info->scope));
-        width = strlen(buf);
-        if (width  < timeformat_info.width) width = timeformat_info.width;
-        rtn = realloc(rtn, (size+width)*sizeof(char));
-        sprintf(rtn+size-1, "%*s", width, buf);
+        display_append_padded(buf, timeformat_info.width);
         break;
 
       /* Realtime variables are also processed here. */
@@ -1055,9 +1334,7 @@ static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
 #else
         sprintf(buf, compatible_flag ? "%g" : "%#g", value.value.real);
 #endif
-        width = strlen(buf);
-        rtn = realloc(rtn, (size+width)*sizeof(char));
-        memcpy(rtn+size-1, buf, width);
+        display_append(buf, strlen(buf));
         break;
 
        /* Process string variables like string constants: interpret
@@ -1068,38 +1345,27 @@ static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
 	fmt = strdup(value.value.str);
 	width = get_format(&result, fmt, info, &idx);
 	free(fmt);
-        rtn = realloc(rtn, (size+width)*sizeof(char));
-        memcpy(rtn+size-1, result, width);
+        display_append(result, width);
         free(result);
 	break;
 
       case vpiSysFuncCall:
-        func_name = vpi_get_str(vpiName, item);
-        if (strcmp(func_name, "$time") == 0) {
+        if (strcmp(ditem->func_name, "$time") == 0) {
           value.format = vpiDecStrVal;
           vpi_get_value(item, &value);
-          width = strlen(value.value.str);
-          if (width  < 20) width = 20;
-          rtn = realloc(rtn, (size+width)*sizeof(char));
-          sprintf(rtn+size-1, "%*s", width, value.value.str);
+          display_append_padded(value.value.str, 20);
 
-        } else if (strcmp(func_name, "$stime") == 0) {
+        } else if (strcmp(ditem->func_name, "$stime") == 0) {
           value.format = vpiDecStrVal;
           vpi_get_value(item, &value);
-          width = strlen(value.value.str);
-          if (width  < 10) width = 10;
-          rtn = realloc(rtn, (size+width)*sizeof(char));
-          sprintf(rtn+size-1, "%*s", width, value.value.str);
+          display_append_padded(value.value.str, 10);
 
-        } else if (strcmp(func_name, "$simtime") == 0) {
+        } else if (strcmp(ditem->func_name, "$simtime") == 0) {
           value.format = vpiDecStrVal;
           vpi_get_value(item, &value);
-          width = strlen(value.value.str);
-          if (width  < 20) width = 20;
-          rtn = realloc(rtn, (size+width)*sizeof(char));
-          sprintf(rtn+size-1, "%*s", width, value.value.str);
+          display_append_padded(value.value.str, 20);
 
-        } else if (strcmp(func_name, "$realtime") == 0) {
+        } else if (strcmp(ditem->func_name, "$realtime") == 0) {
           /* Use the local scope precision. */
           int use_prec = vpi_get(vpiTimeUnit, info->scope) -
                          vpi_get(vpiTimePrecision, info->scope);
@@ -1107,17 +1373,13 @@ static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
           value.format = vpiRealVal;
           vpi_get_value(item, &value);
           sprintf(buf, "%.*f", use_prec, value.value.real);
-          width = strlen(buf);
-          rtn = realloc(rtn, (size+width)*sizeof(char));
-          sprintf(rtn+size-1, "%*s", width, buf);
+          display_append(buf, strlen(buf));
 
         } else {
           vpi_printf("WARNING: %s:%d: %s does not support %s as an argument!\n",
-                     info->filename, info->lineno, info->name, func_name);
-          strcpy(buf, "<?>");
-          width = strlen(buf);
-          rtn = realloc(rtn, (size+width)*sizeof(char));
-          memcpy(rtn+size-1, buf, width);
+                     info->filename, info->lineno, info->name,
+                     ditem->func_name);
+          display_append("<?>", 3);
         }
         break;
 
@@ -1125,17 +1387,13 @@ static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
         vpi_printf("WARNING: %s:%d: unknown argument type (%s) given to %s!\n",
                    info->filename, info->lineno, vpi_get_str(vpiType, item),
                    info->name);
-        cresult = "<?>";
-        width = strlen(cresult);
-        rtn = realloc(rtn, (size+width)*sizeof(char));
-        memcpy(rtn+size-1, cresult, width);
+        display_append("<?>", 3);
         break;
     }
-    size += width;
   }
-  rtn[size-1] = '\0';
-  *rtnsz = size - 1;
-  return rtn;
+  display_reserve(0)[0] = '\0';
+  *rtnsz = display_buf_len;
+  return display_buf;
 }
 
 #ifdef BR916_STOPGAP_FIX
@@ -1276,27 +1534,63 @@ static PLI_INT32 sys_display_compiletf(ICARUS_VPI_CONST PLI_BYTE8*name)
       return sys_common_compiletf(name, 0, 0);
 }
 
+/*
+ * The arguments of a display task are the same handles on every call,
+ * so they are collected and compiled on the first call and kept with
+ * the call handle. For the $f tasks the file descriptor argument is
+ * kept separately from the display items.
+ */
+struct display_program {
+      vpiHandle fd;
+      struct strobe_cb_info info;
+};
+
+static struct display_program*get_display_program(vpiHandle callh,
+                                                  const char*name)
+{
+      struct display_program*prog;
+      vpiHandle argv;
+
+      prog = (struct display_program*)vpi_get_userdata(callh);
+      if (prog) return prog;
+
+      prog = calloc(1, sizeof(struct display_program));
+      argv = vpi_iterate(vpiArgument, callh);
+      if (name[1] == 'f' && argv) prog->fd = vpi_scan(argv);
+
+	/* We could use vpi_get_str(vpiName, callh) to get the task name,
+	 * but name is already defined. */
+      prog->info.name = name;
+      prog->info.filename = strdup(vpi_get_str(vpiFile, callh));
+      prog->info.lineno = (int)vpi_get(vpiLineNo, callh);
+      prog->info.default_format = get_default_format(name);
+      prog->info.scope = vpi_handle(vpiScope, callh);
+      assert(prog->info.scope);
+      array_from_iterator(&prog->info, argv);
+      prog->info.ditems = compile_display_items(&prog->info);
+
+      vpi_put_userdata(callh, prog);
+      return prog;
+}
+
 /* This implements the $sformatf, $display/$fdisplay
  * and the $write/$fwrite based tasks. */
 static PLI_INT32 sys_display_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
 {
-      vpiHandle callh, argv, scope;
-      struct strobe_cb_info info;
+      vpiHandle callh;
+      struct display_program*prog;
       char* result;
       unsigned int size;
       PLI_UINT32 fd_mcd;
       s_vpi_value val;
 
       callh = vpi_handle(vpiSysTfCall, 0);
-      argv = vpi_iterate(vpiArgument, callh);
+      prog = get_display_program(callh, name);
 
 	/* Get the file/MC descriptor and verify it is valid. */
       if (name[1] == 'f') {
-	    vpiHandle fd = vpi_scan(argv);
-	    if (get_fd_mcd_from_arg(&fd_mcd, fd, callh, name)) {
-		  vpi_free_object(argv);
+	    if (get_fd_mcd_from_arg(&fd_mcd, prog->fd, callh, name))
 		  return 0;
-	    }
       } else if (strncmp(name, "$sformatf", 9) == 0) {
 	      /* return as a string */
 	    fd_mcd = 0;
@@ -1305,25 +1599,15 @@ static PLI_INT32 sys_display_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
 	    fd_mcd = 1;
       }
 
-      scope = vpi_handle(vpiScope, callh);
-      assert(scope);
-	/* We could use vpi_get_str(vpiName, callh) to get the task name,
-	 * but name is already defined. */
-      info.name = name;
-      info.filename = strdup(vpi_get_str(vpiFile, callh));
-      info.lineno = (int)vpi_get(vpiLineNo, callh);
-      info.default_format = get_default_format(name);
-      info.scope = scope;
-      array_from_iterator(&info, argv);
-
 	/* Because %u and %z may put embedded NULL characters into the
 	 * returned string strlen() may not match the real size! */
-      result = get_display(&size, &info);
+      result = get_display(&size, &prog->info);
 
       if (fd_mcd > 0) {
-	     my_mcd_rawwrite(fd_mcd, result, size);
+	      /* The result buffer always has room for the newline. */
 	     if ((strncmp(name,"$display",8) == 0) ||
-	         (strncmp(name,"$fdisplay",9) == 0)) my_mcd_rawwrite(fd_mcd, "\n", 1);
+	         (strncmp(name,"$fdisplay",9) == 0)) result[size++] = '\n';
+	     my_mcd_rawwrite(fd_mcd, result, size);
       } else {
 	       /* Return as a string ($sformatf) */
 	     val.format = vpiStringVal;
@@ -1331,9 +1615,6 @@ static PLI_INT32 sys_display_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
 	     vpi_put_value(callh, &val, 0, vpiNoDelay);
       }
 
-      free(result);
-      free(info.filename);
-      free(info.items);
       return 0;
 }
 
@@ -1357,13 +1638,11 @@ static PLI_INT32 strobe_cb(p_cb_data cb)
 	      /* Because %u and %z may put embedded NULL characters into the
 	       * returned string strlen() may not match the real size! */
 	    result = get_display(&size, info);
+	    result[size++] = '\n';
 	    my_mcd_rawwrite(info->fd_mcd, result, size);
-	    my_mcd_rawwrite(info->fd_mcd, "\n", 1);
-	    free(result);
       }
 
-      free(info->filename);
-      free(info->items);
+	/* The rest of the information belongs to the display program. */
       free(info);
       return 0;
 }
@@ -1378,40 +1657,30 @@ static PLI_INT32 sys_strobe_compiletf(ICARUS_VPI_CONST PLI_BYTE8 *name)
 /* This implements both the $strobe and $fstrobe based tasks. */
 static PLI_INT32 sys_strobe_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 {
-      vpiHandle callh, argv, scope;
+      vpiHandle callh;
       struct t_cb_data cb;
       struct t_vpi_time timerec;
+      struct display_program*prog;
       struct strobe_cb_info*info;
       PLI_UINT32 fd_mcd;
 
       callh = vpi_handle(vpiSysTfCall, 0);
-      argv = vpi_iterate(vpiArgument, callh);
+      prog = get_display_program(callh, name);
 
 	/* Get the file/MC descriptor and verify it is valid. */
       if (name[1] == 'f') {
-	    vpiHandle fd = vpi_scan(argv);
-	    if (get_fd_mcd_from_arg(&fd_mcd, fd, callh, name)) {
-		  vpi_free_object(argv);
+	    if (get_fd_mcd_from_arg(&fd_mcd, prog->fd, callh, name))
                   return 0;
-	    }
 
       } else {
 	    fd_mcd = 1;
       }
 
-      scope = vpi_handle(vpiScope, callh);
-      assert(scope);
-
-      info = calloc(1, sizeof(struct strobe_cb_info));
+	/* Each pending strobe needs its own descriptor, but it shares
+	 * the items with the display program. */
+      info = malloc(sizeof(struct strobe_cb_info));
+      *info = prog->info;
       info->fd_mcd = fd_mcd;
-	/* We could use vpi_get_str(vpiName, callh) to get the task name,
-	 * but name is already defined. */
-      info->name = name;
-      info->filename = strdup(vpi_get_str(vpiFile, callh));
-      info->lineno = (int)vpi_get(vpiLineNo, callh);
-      info->default_format = get_default_format(name);
-      info->scope= scope;
-      array_from_iterator(info, argv);
 
       timerec.type = vpiSimTime;
       timerec.low = 0;
@@ -1436,7 +1705,7 @@ static PLI_INT32 sys_strobe_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
  * though that monitor may be watching many variables).
  */
 
-static struct strobe_cb_info monitor_info = { 0, 0, 0, 0, 0, 0, 0, 0 };
+static struct strobe_cb_info monitor_info = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 static vpiHandle *monitor_callbacks = 0;
 static int monitor_scheduled = 0;
 static int monitor_enabled = 1;
@@ -1451,10 +1720,9 @@ static PLI_INT32 monitor_cb_2(p_cb_data cb)
 	/* Because %u and %z may put embedded NULL characters into the
 	 * returned string strlen() may not match the real size! */
       result = get_display(&size, &monitor_info);
+      result[size++] = '\n';
       my_mcd_rawwrite(monitor_info.fd_mcd, result, size);
-      my_mcd_rawwrite(monitor_info.fd_mcd, "\n", 1);
       monitor_scheduled = 0;
-      free(result);
       return 0;
 }
 
@@ -1528,6 +1796,8 @@ static PLI_INT32 sys_monitor_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 	    monitor_callbacks = 0;
 
 	    free(monitor_info.filename);
+	    free_display_items(monitor_info.ditems, monitor_info.nitems);
+	    monitor_info.ditems = 0;
 	    free(monitor_info.items);
 	    monitor_info.items = 0;
 	    monitor_info.nitems = 0;
@@ -1544,6 +1814,7 @@ static PLI_INT32 sys_monitor_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       monitor_info.default_format = get_default_format(name);
       monitor_info.scope = scope;
       monitor_info.fd_mcd = 1;
+      monitor_info.ditems = compile_display_items(&monitor_info);
 
 	/* Attach callbacks to all the parameters that might change. */
       monitor_callbacks = calloc(monitor_info.nitems, sizeof(vpiHandle));
@@ -1662,6 +1933,7 @@ static PLI_INT32 sys_swrite_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
   info.lineno = (int)vpi_get(vpiLineNo, callh);
   info.default_format = get_default_format(name);
   info.scope = scope;
+  info.ditems = 0;
   array_from_iterator(&info, argv);
 
   /* Because %u and %z may put embedded NULL characters into the returned
@@ -1674,7 +1946,6 @@ static PLI_INT32 sys_swrite_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
                "(see %%u/%%z).\n", info.filename, info.lineno, name);
   }
 
-  free(val.value.str);
   free(info.filename);
   free(info.items);
   return 0;
@@ -1763,6 +2034,7 @@ static PLI_INT32 sys_sformat_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
   info.lineno = (int)vpi_get(vpiLineNo, callh);
   info.default_format = get_default_format(name);
   info.scope = scope;
+  info.ditems = 0;
   array_from_iterator(&info, argv);
   idx = -1;
   size = get_format(&result, fmt, &info, &idx);
@@ -2140,6 +2412,7 @@ static PLI_INT32 sys_severity_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       info.lineno = (int)vpi_get(vpiLineNo, callh);
       info.default_format = vpiDecStrVal;
       info.scope = scope;
+      info.ditems = 0;
       array_from_iterator(&info, argv);
 
       vpi_printf("%s: %s:%d: ", sstr, info.filename, info.lineno);
@@ -2166,7 +2439,6 @@ static PLI_INT32 sys_severity_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       free(--sstr);  /* Get the $ back. */
       free(info.filename);
       free(info.items);
-      free(dstr);
 
       if (strncmp(name,"$fatal",6) == 0) {
 	      /* Set the exit code from vvp as an error code. */
@@ -2185,11 +2457,17 @@ static PLI_INT32 sys_end_of_simulation(p_cb_data cb_data)
       free(monitor_callbacks);
       monitor_callbacks = 0;
       free(monitor_info.filename);
+      free_display_items(monitor_info.ditems, monitor_info.nitems);
+      monitor_info.ditems = 0;
       free(monitor_info.items);
       monitor_info.items = 0;
       monitor_info.nitems = 0;
       monitor_info.name = 0;
 
+      free(display_buf);
+      display_buf = 0;
+      display_buf_size = 0;
+
       free(timeformat_info.suff);
       timeformat_info.suff = 0;
       return 0;
@@ -262,8 +262,10 @@ static PLI_INT32 sys_fflush_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       vpiHandle fd;
       PLI_UINT32 fd_mcd;
 
-	/* If we have no argument then flush all the streams. */
+	/* If we have no argument then flush all the streams. The MCD
+	 * channels may hold output that is not in a stream yet. */
       if (argv == 0) {
+	    vpi_mcd_flush(0x7fffffff);
 	    fflush(NULL);
 	    return 0;
       }
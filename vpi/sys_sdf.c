@@ -19,6 +19,7 @@
 
 # include  "sys_priv.h"
 # include  "sdf_priv.h"
+# include  <stdint.h>
 # include  <stdlib.h>
 # include  <string.h>
 # include  <assert.h>
@@ -37,23 +38,216 @@ static vpiHandle sdf_callh = 0;
   /* The cell in process. */
 static vpiHandle sdf_cur_cell;
 
-static vpiHandle find_scope(vpiHandle scope, const char*name)
+/*
+ * Large SDF files name very many instances and IOPATHs, so the lookups
+ * go through a hash index that is built as the annotation goes and
+ * thrown away at the end of each $sdf_annotate. The index holds:
+ *
+ *   the children of a scope, keyed by (scope, name). They are entered
+ *   all at once the first time a scope is searched, and the scope is
+ *   then marked with an entry that has no name.
+ *
+ *   the modpaths of a cell, keyed by (cell, src, dst). They are entered
+ *   the first time the cell has an IOPATH, in the order vpi_iterate
+ *   returns them, so the delays are still applied in that order. The
+ *   cell is then marked with an entry that has only the dst name
+ *   "modpath".
+ */
+struct sdf_index_entry_s {
+      struct sdf_index_entry_s*next;
+      vpiHandle owner;
+      char*name;
+      char*name2;
+      int edge;
+      vpiHandle obj;
+};
+
+static struct sdf_index_entry_s**sdf_index = 0;
+static unsigned sdf_index_size = 0;
+static unsigned sdf_index_count = 0;
+
+static unsigned sdf_index_hash(vpiHandle owner, const char*name,
+			       const char*name2)
 {
-      vpiHandle idx = vpi_iterate(vpiModule, scope);
-	/* If this scope has no modules then it can't have the one we
-	 * are looking for so just return 0. */
-      if (idx == 0) return 0;
+      uintptr_t hash = (uintptr_t)owner;
+      hash ^= hash >> 7;
+      if (name) for ( ; *name ; name += 1)
+	    hash = hash * 31 + (unsigned char)*name;
+      if (name2) for ( ; *name2 ; name2 += 1)
+	    hash = hash * 37 + (unsigned char)*name2;
+      return (unsigned)(hash % sdf_index_size);
+}
 
-      vpiHandle cur;
-      while ( (cur = vpi_scan(idx)) ) {
+static int sdf_index_match(const struct sdf_index_entry_s*cur, vpiHandle owner,
+			   const char*name, const char*name2)
+{
+      if (cur->owner != owner)
+	    return 0;
+      if ((cur->name == 0) != (name == 0))
+	    return 0;
+      if (name && strcmp(cur->name, name) != 0)
+	    return 0;
+      if ((cur->name2 == 0) != (name2 == 0))
+	    return 0;
+      if (name2 && strcmp(cur->name2, name2) != 0)
+	    return 0;
+      return 1;
+}
 
-	    if ( strcmp(name, vpi_get_str(vpiName,cur)) == 0) {
-		  vpi_free_object(idx);
+static struct sdf_index_entry_s* sdf_index_next(struct sdf_index_entry_s*cur,
+						vpiHandle owner,
+						const char*name,
+						const char*name2)
+{
+      for ( ; cur ; cur = cur->next) {
+	    if (sdf_index_match(cur, owner, name, name2))
 		  return cur;
+      }
+      return 0;
+}
+
+static struct sdf_index_entry_s* sdf_index_find(vpiHandle owner,
+						const char*name,
+						const char*name2)
+{
+      if (sdf_index_size == 0)
+	    return 0;
+
+      return sdf_index_next(sdf_index[sdf_index_hash(owner, name, name2)],
+			    owner, name, name2);
+}
+
+static void sdf_index_grow(void)
+{
+      struct sdf_index_entry_s**old_index = sdf_index;
+      unsigned old_size = sdf_index_size;
+      unsigned idx;
+
+      sdf_index_size = old_size ? old_size * 2 : 1024;
+      sdf_index = calloc(sdf_index_size, sizeof(struct sdf_index_entry_s*));
+
+	/* Move the entries over, keeping the order of each chain. */
+      for (idx = old_size ; idx > 0 ; idx -= 1) {
+	    struct sdf_index_entry_s*cur = old_index[idx-1];
+	    struct sdf_index_entry_s*rev = 0;
+	    while (cur) {
+		  struct sdf_index_entry_s*next = cur->next;
+		  cur->next = rev;
+		  rev = cur;
+		  cur = next;
+	    }
+	    while (rev) {
+		  struct sdf_index_entry_s*next = rev->next;
+		  unsigned hash = sdf_index_hash(rev->owner, rev->name,
+						 rev->name2);
+		  rev->next = sdf_index[hash];
+		  sdf_index[hash] = rev;
+		  rev = next;
 	    }
       }
+      free(old_index);
+}
 
-      return 0;
+/*
+ * Add an entry to the end of its chain, so that entries with the same
+ * key are found in the order they were added.
+ */
+static void sdf_index_add(vpiHandle owner, const char*name, const char*name2,
+			  int edge, vpiHandle obj)
+{
+      struct sdf_index_entry_s*item;
+      struct sdf_index_entry_s**tail;
+
+      if (sdf_index_count >= sdf_index_size)
+	    sdf_index_grow();
+
+      item = malloc(sizeof(struct sdf_index_entry_s));
+      item->next = 0;
+      item->owner = owner;
+      item->name = name ? strdup(name) : 0;
+      item->name2 = name2 ? strdup(name2) : 0;
+      item->edge = edge;
+      item->obj = obj;
+
+      tail = &sdf_index[sdf_index_hash(owner, name, name2)];
+      while (*tail) tail = &(*tail)->next;
+      *tail = item;
+      sdf_index_count += 1;
+}
+
+static void sdf_index_delete(void)
+{
+      unsigned idx;
+      for (idx = 0 ; idx < sdf_index_size ; idx += 1) {
+	    struct sdf_index_entry_s*cur = sdf_index[idx];
+	    while (cur) {
+		  struct sdf_index_entry_s*next = cur->next;
+		  free(cur->name);
+		  free(cur->name2);
+		  free(cur);
+		  cur = next;
+	    }
+      }
+      free(sdf_index);
+      sdf_index = 0;
+      sdf_index_size = 0;
+      sdf_index_count = 0;
+}
+
+static vpiHandle find_scope(vpiHandle scope, const char*name)
+{
+      struct sdf_index_entry_s*item;
+
+      if (sdf_index_find(scope, 0, 0) == 0) {
+	    vpiHandle idx = vpi_iterate(vpiModule, scope);
+	    vpiHandle cur;
+
+	    sdf_index_add(scope, 0, 0, vpiNoEdge, scope);
+	      /* If this scope has no modules then it can't have the one
+	       * we are looking for. */
+	    if (idx) while ( (cur = vpi_scan(idx)) ) {
+		  const char*cur_name = vpi_get_str(vpiName, cur);
+		    /* The first of several scopes with the same name
+		     * is the one that is found. */
+		  if (sdf_index_find(scope, cur_name, 0) == 0)
+			sdf_index_add(scope, cur_name, 0, vpiNoEdge, cur);
+	    }
+      }
+
+      item = sdf_index_find(scope, name, 0);
+      return item ? item->obj : 0;
+}
+
+/*
+ * Enter all the modpaths of the cell in the index. This is only done
+ * for the first IOPATH of a cell.
+ */
+static void index_modpaths(vpiHandle cell)
+{
+      vpiHandle iter, path;
+
+      sdf_index_add(cell, 0, "modpath", vpiNoEdge, cell);
+      iter = vpi_iterate(vpiModPath, cell);
+      if (iter) while ( (path = vpi_scan(iter)) ) {
+	    vpiHandle path_t_in = vpi_handle(vpiModPathIn,path);
+	    vpiHandle path_t_out = vpi_handle(vpiModPathOut,path);
+
+	    vpiHandle path_in = vpi_handle(vpiExpr,path_t_in);
+	    vpiHandle path_out = vpi_handle(vpiExpr,path_t_out);
+	    char*in_name;
+
+	      /* The expressions for the path terms must be signals,
+	         vpiNet or vpiReg. */
+	    assert(vpi_get(vpiType,path_in) == vpiNet);
+	    assert(vpi_get(vpiType,path_out) == vpiNet
+		   || vpi_get(vpiType,path_out) == vpiReg);
+
+	      /* vpi_get_str() results only last until the next call. */
+	    in_name = strdup(vpi_get_str(vpiName,path_in));
+	    sdf_index_add(cell, in_name, vpi_get_str(vpiName,path_out),
+			  vpi_get(vpiEdge,path_t_in), path);
+	    free(in_name);
+      }
 }
 
 /*
@@ -138,46 +332,28 @@ static const char*edge_str(int vpi_edge)
 void sdf_iopath_delays(int vpi_edge, const char*src, const char*dst,
 		       const struct sdf_delval_list_s*delval_list)
 {
-      vpiHandle iter, path;
+      struct sdf_index_entry_s*item;
       int match_count = 0;
 
       if (sdf_cur_cell == 0)
 	    return;
 
-      iter = vpi_iterate(vpiModPath, sdf_cur_cell);
+      if (sdf_index_find(sdf_cur_cell, 0, "modpath") == 0)
+	    index_modpaths(sdf_cur_cell);
 
-	/* Search for the modpath that matches the IOPATH by looking
-	   for the modpath that uses the same ports as the ports that
-	   the parser has found. */
-      if (iter) while ( (path = vpi_scan(iter)) ) {
+	/* Look up the modpaths that use the same ports as the ports
+	   that the parser has found. */
+      for (item = sdf_index_find(sdf_cur_cell, src, dst) ; item
+		 ; item = sdf_index_next(item->next, sdf_cur_cell, src, dst)) {
 	    s_vpi_delay delays;
 	    struct t_vpi_time delay_vals[12];
 	    int idx;
 
-	    vpiHandle path_t_in = vpi_handle(vpiModPathIn,path);
-	    vpiHandle path_t_out = vpi_handle(vpiModPathOut,path);
-
-	    vpiHandle path_in = vpi_handle(vpiExpr,path_t_in);
-	    vpiHandle path_out = vpi_handle(vpiExpr,path_t_out);
-
-	      /* The expressions for the path terms must be signals,
-	         vpiNet or vpiReg. */
-	    assert(vpi_get(vpiType,path_in) == vpiNet);
-	    assert(vpi_get(vpiType,path_out) == vpiNet
-		   || vpi_get(vpiType,path_out) == vpiReg);
-
-	      /* If the src name doesn't match, go on. */
-	    if (strcmp(src,vpi_get_str(vpiName,path_in)) != 0)
-		  continue;
 	      /* The edge type must match too. But note that if this
 	         IOPATH has no edge, then it matches with all edges of
 	         the modpath object. */
 /* --> Is this correct in the context of the 10, 01, etc. edges? */
-	    if (vpi_edge != vpiNoEdge && vpi_get(vpiEdge,path_t_in) != vpi_edge)
-		  continue;
-
-	      /* If the dst name doesn't match, go on. */
-	    if (strcmp(dst,vpi_get_str(vpiName,path_out)) != 0)
+	    if (vpi_edge != vpiNoEdge && item->edge != vpi_edge)
 		  continue;
 
 	      /* Ah, this must be a match! */
@@ -187,7 +363,7 @@ void sdf_iopath_delays(int vpi_edge, const char*src, const char*dst,
 	    delays.mtm_flag = 0;
 	    delays.append_flag = 0;
 	    delays.pulsere_flag = 0;
-	    vpi_get_delays(path, &delays);
+	    vpi_get_delays(item->obj, &delays);
 
 	    for (idx = 0 ; idx < delval_list->count ; idx += 1) {
 		  delay_vals[idx].type = vpiScaledRealTime;
@@ -196,7 +372,7 @@ void sdf_iopath_delays(int vpi_edge, const char*src, const char*dst,
 		  }
 	    }
 
-	    vpi_put_delays(path, &delays);
+	    vpi_put_delays(item->obj, &delays);
 	    match_count += 1;
       }
 
@@ -320,6 +496,7 @@ static PLI_INT32 sys_sdf_annotate_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       sdf_callh = callh;
       sdf_process_file(sdf_fd, fname);
       sdf_callh = 0;
+      sdf_index_delete();
 
       fclose(sdf_fd);
       free(fname);
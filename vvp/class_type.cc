@@ -21,7 +21,6 @@
 # include  "compile.h"
 # include  "vpi_priv.h"
 # include  "config.h"
-# include  <map>
 #ifdef CHECK_WITH_VALGRIND
 # include  "vvp_cleanup.h"
 #endif
@@ -30,239 +29,72 @@
 using namespace std;
 
 /*
- * This class_property_t class is an abstract base class for
- * representing a property of an instance. The definition keeps and
- * array (of pointers) of these in order to define the the class.
+ * Each kind of property has a size and alignment within an instance.
  */
-class class_property_t {
-    public:
-      inline class_property_t() { }
-      virtual ~class_property_t() =0;
-	// How much space does an instance of this property require?
-      virtual size_t instance_size() const =0;
-
-      void set_offset(size_t off) { offset_ = off; }
-
-    public:
-      virtual void construct(char*buf) const;
-      virtual void destruct(char*buf) const;
-
-      virtual void set_vec4(char*buf, const vvp_vector4_t&val);
-      virtual void get_vec4(char*buf, vvp_vector4_t&val);
-
-      virtual void set_real(char*buf, double val);
-      virtual double get_real(char*buf);
-
-      virtual void set_string(char*buf, const std::string&val);
-      virtual string get_string(char*buf);
-
-      virtual void set_object(char*buf, const vvp_object_t&val, uint64_t element);
-      virtual void get_object(char*buf, vvp_object_t&val, uint64_t element);
-
-	// Implement polymorphic shallow copy.
-      virtual void copy(char*buf, char*src) = 0;
-
-    protected:
-      size_t offset_;
-};
-
-class_property_t::~class_property_t()
-{
-}
-
-void class_property_t::construct(char*) const
-{
-}
-
-void class_property_t::destruct(char*) const
-{
-}
-
-void class_property_t::set_vec4(char*, const vvp_vector4_t&)
-{
-      assert(0);
-}
-
-void class_property_t::get_vec4(char*, vvp_vector4_t&)
-{
-      assert(0);
-}
-
-void class_property_t::set_real(char*, double)
-{
-      assert(0);
-}
-
-double class_property_t::get_real(char*)
-{
-      assert(0);
-      return 0.0;
-}
-
-void class_property_t::set_string(char*, const string&)
-{
-      assert(0);
-}
-
-string class_property_t::get_string(char*)
-{
-      assert(0);
-      return "";
+static size_t prop_size(class_type::prop_kind_t kind, size_t array_size)
+{
+      switch (kind) {
+	  case class_type::PK_U8:
+	  case class_type::PK_S8:
+	    return sizeof(uint8_t);
+	  case class_type::PK_U16:
+	  case class_type::PK_S16:
+	    return sizeof(uint16_t);
+	  case class_type::PK_U32:
+	  case class_type::PK_S32:
+	    return sizeof(uint32_t);
+	  case class_type::PK_U64:
+	  case class_type::PK_S64:
+	    return sizeof(uint64_t);
+	  case class_type::PK_REAL:
+	    return sizeof(double);
+	  case class_type::PK_STRING:
+	    return sizeof(string);
+	  case class_type::PK_OBJECT:
+	    return array_size * sizeof(vvp_object_t);
+	  case class_type::PK_BIT:
+	    return sizeof(vvp_vector2_t);
+	  case class_type::PK_LOGIC:
+	    return sizeof(vvp_vector4_t);
+	  default:
+	    assert(0);
+	    return 0;
+      }
 }
 
-void class_property_t::set_object(char*, const vvp_object_t&, uint64_t)
-{
-      assert(0);
+static size_t prop_align(class_type::prop_kind_t kind)
+{
+      switch (kind) {
+	  case class_type::PK_STRING:
+	    return __alignof__(string);
+	  case class_type::PK_OBJECT:
+	    return __alignof__(vvp_object_t);
+	  case class_type::PK_BIT:
+	    return __alignof__(vvp_vector2_t);
+	  case class_type::PK_LOGIC:
+	    return __alignof__(vvp_vector4_t);
+	  default:
+	      // The scalar types are aligned to their size.
+	    return prop_size(kind, 1);
+      }
 }
 
-void class_property_t::get_object(char*, vvp_object_t&, uint64_t)
+template <class T> static inline T*prop_ptr(char*buf, size_t off)
 {
-      assert(0);
+      return reinterpret_cast<T*> (buf+off);
 }
 
-/*
- */
-template <class T> class property_atom : public class_property_t {
-    public:
-      inline explicit property_atom(void) { }
-      ~property_atom() { }
-
-      size_t instance_size() const { return sizeof(T); }
-
-    public:
-      void construct(char*buf) const
-      { T*tmp = reinterpret_cast<T*> (buf+offset_);
-	*tmp = 0;
-      }
-
-      void set_vec4(char*buf, const vvp_vector4_t&val);
-      void get_vec4(char*buf, vvp_vector4_t&val);
-
-      void copy(char*dst, char*src);
-};
-
-class property_bit : public class_property_t {
-    public:
-      explicit inline property_bit(size_t wid): wid_(wid) { }
-      ~property_bit() { }
-
-      size_t instance_size() const { return sizeof(vvp_vector2_t); }
-
-    public:
-      void construct(char*buf) const
-      { new (buf+offset_) vvp_vector2_t (0, wid_); }
-
-      void destruct(char*buf) const
-      { vvp_vector2_t*tmp = reinterpret_cast<vvp_vector2_t*>(buf+offset_);
-	tmp->~vvp_vector2_t();
-      }
-
-      void set_vec4(char*buf, const vvp_vector4_t&val);
-      void get_vec4(char*buf, vvp_vector4_t&val);
-
-      void copy(char*dst, char*src);
-
-    private:
-      size_t wid_;
-};
-
-class property_logic : public class_property_t {
-    public:
-      explicit inline property_logic(size_t wid): wid_(wid) { }
-      ~property_logic() { }
-
-      size_t instance_size() const { return sizeof(vvp_vector4_t); }
-
-    public:
-      void construct(char*buf) const
-      { new (buf+offset_) vvp_vector4_t (0, wid_); }
-
-      void destruct(char*buf) const
-      { vvp_vector4_t*tmp = reinterpret_cast<vvp_vector4_t*>(buf+offset_);
-	tmp->~vvp_vector4_t();
-      }
-
-      void set_vec4(char*buf, const vvp_vector4_t&val);
-      void get_vec4(char*buf, vvp_vector4_t&val);
-
-      void copy(char*dst, char*src);
-
-    private:
-      size_t wid_;
-};
-
-template <class T> class property_real : public class_property_t {
-    public:
-      inline explicit property_real(void) { }
-      ~property_real() { }
-
-      size_t instance_size() const { return sizeof(T); }
-
-    public:
-      void construct(char*buf) const
-      { T*tmp = reinterpret_cast<T*> (buf+offset_);
-	*tmp = 0.0;
-      }
-
-      void set_real(char*buf, double val);
-      double get_real(char*buf);
-
-      void copy(char*dst, char*src);
-};
-
-class property_string : public class_property_t {
-    public:
-      inline explicit property_string(void) { }
-      ~property_string() { }
-
-      size_t instance_size() const { return sizeof(std::string); }
-
-    public:
-      void construct(char*buf) const
-      { /* string*tmp = */ new (buf+offset_) string; }
-
-      void destruct(char*buf) const
-      { string*tmp = reinterpret_cast<string*> (buf+offset_);
-	tmp->~string();
-      }
-
-      void set_string(char*buf, const string&);
-      string get_string(char*buf);
-
-      void copy(char*dst, char*src);
-};
-
-class property_object : public class_property_t {
-    public:
-      inline explicit property_object(uint64_t as): array_size_(as==0? 1 : as) { }
-      ~property_object() { }
-
-      size_t instance_size() const { return array_size_ * sizeof(vvp_object_t); }
-
-    public:
-      void construct(char*buf) const;
-
-      void destruct(char*buf) const;
-
-      void set_object(char*buf, const vvp_object_t&, uint64_t);
-      void get_object(char*buf, vvp_object_t&, uint64_t);
-
-      void copy(char*dst, char*src);
-
-    private:
-      size_t array_size_;
-};
-
-template <class T> void property_atom<T>::set_vec4(char*buf, const vvp_vector4_t&val)
+template <class T> static void atom_set_vec4(char*buf, size_t off,
+					     const vvp_vector4_t&val)
 {
-      T*tmp = reinterpret_cast<T*> (buf+offset_);
-      bool flag = vector4_to_value(val, *tmp, true, false);
+      bool flag = vector4_to_value(val, *prop_ptr<T>(buf,off), true, false);
       assert(flag);
 }
 
-template <class T> void property_atom<T>::get_vec4(char*buf, vvp_vector4_t&val)
+template <class T> static void atom_get_vec4(char*buf, size_t off,
+					     vvp_vector4_t&val)
 {
-      T*src = reinterpret_cast<T*> (buf+offset_);
+      T*src = prop_ptr<T>(buf,off);
       const size_t tmp_cnt = sizeof(T)<sizeof(unsigned long)
 				       ? 1
 				       : sizeof(T) / sizeof(unsigned long);
@@ -276,216 +108,151 @@ template <class T> void property_atom<T>::get_vec4(char*buf, vvp_vector4_t&val)
       val.setarray(0, val.size(), tmp);
 }
 
-template <class T> void property_atom<T>::copy(char*dst, char*src)
-{
-      T*dst_obj = reinterpret_cast<T*> (dst+offset_);
-      T*src_obj = reinterpret_cast<T*> (src+offset_);
-      *dst_obj = *src_obj;
-}
-
-void property_bit::set_vec4(char*buf, const vvp_vector4_t&val)
-{
-      vvp_vector2_t*obj = reinterpret_cast<vvp_vector2_t*> (buf+offset_);
-      *obj = val;
-}
-
-void property_bit::get_vec4(char*buf, vvp_vector4_t&val)
-{
-      vvp_vector2_t*obj = reinterpret_cast<vvp_vector2_t*> (buf+offset_);
-      val = vector2_to_vector4(*obj, obj->size());
-}
-
-void property_bit::copy(char*dst, char*src)
-{
-      vvp_vector2_t*dst_obj = reinterpret_cast<vvp_vector2_t*> (dst+offset_);
-      vvp_vector2_t*src_obj = reinterpret_cast<vvp_vector2_t*> (src+offset_);
-      *dst_obj = *src_obj;
-}
-
-void property_logic::set_vec4(char*buf, const vvp_vector4_t&val)
-{
-      vvp_vector4_t*obj = reinterpret_cast<vvp_vector4_t*> (buf+offset_);
-      *obj = val;
-}
-
-void property_logic::get_vec4(char*buf, vvp_vector4_t&val)
-{
-      vvp_vector4_t*obj = reinterpret_cast<vvp_vector4_t*> (buf+offset_);
-      val = *obj;
-}
-
-void property_logic::copy(char*dst, char*src)
+template <class T> static inline void atom_copy(char*dst, char*src, size_t off)
 {
-      vvp_vector4_t*dst_obj = reinterpret_cast<vvp_vector4_t*> (dst+offset_);
-      vvp_vector4_t*src_obj = reinterpret_cast<vvp_vector4_t*> (src+offset_);
-      *dst_obj = *src_obj;
+      *prop_ptr<T>(dst,off) = *prop_ptr<T>(src,off);
 }
 
-template <class T> void property_real<T>::set_real(char*buf, double val)
-{
-      T*tmp = reinterpret_cast<T*>(buf+offset_);
-      *tmp = val;
-}
-
-template <class T> double property_real<T>::get_real(char*buf)
-{
-      T*tmp = reinterpret_cast<T*>(buf+offset_);
-      return *tmp;
-}
-
-template <class T> void property_real<T>::copy(char*dst, char*src)
-{
-      T*dst_obj = reinterpret_cast<T*> (dst+offset_);
-      T*src_obj = reinterpret_cast<T*> (src+offset_);
-      *dst_obj = *src_obj;
-}
-
-void property_string::set_string(char*buf, const string&val)
-{
-      string*tmp = reinterpret_cast<string*>(buf+offset_);
-      *tmp = val;
-}
-
-string property_string::get_string(char*buf)
-{
-      string*tmp = reinterpret_cast<string*>(buf+offset_);
-      return *tmp;
-}
-
-void property_string::copy(char*dst, char*src)
-{
-      string*dst_obj = reinterpret_cast<string*> (dst+offset_);
-      string*src_obj = reinterpret_cast<string*> (src+offset_);
-      *dst_obj = *src_obj;
-}
-
-void property_object::construct(char*buf) const
-{
-      for (size_t idx = 0 ; idx < array_size_ ; idx += 1)
-	    new (buf+offset_ + idx*sizeof(vvp_object_t)) vvp_object_t;
-}
-
-void property_object::destruct(char*buf) const
-{
-      vvp_object_t*tmp = reinterpret_cast<vvp_object_t*> (buf+offset_);
-      for (size_t idx = 0 ; idx < array_size_ ; idx += 1)
-	    (tmp+idx)->~vvp_object_t();
-}
-
-void property_object::set_object(char*buf, const vvp_object_t&val, uint64_t idx)
-{
-      assert(idx < array_size_);
-      vvp_object_t*tmp = reinterpret_cast<vvp_object_t*>(buf+offset_);
-      tmp[idx] = val;
-}
-
-void property_object::get_object(char*buf, vvp_object_t&val, uint64_t idx)
-{
-      assert(idx < array_size_);
-      vvp_object_t*tmp = reinterpret_cast<vvp_object_t*>(buf+offset_);
-      val = tmp[idx];
-}
-
-void property_object::copy(char*dst, char*src)
-{
-      vvp_object_t*dst_obj = reinterpret_cast<vvp_object_t*>(dst+offset_);
-      vvp_object_t*src_obj = reinterpret_cast<vvp_object_t*>(src+offset_);
-      for (size_t idx = 0 ; idx < array_size_ ; idx += 1)
-	    dst_obj[idx] = src_obj[idx];
-}
-
-/* **** */
-
 class_type::class_type(const string&nam, size_t nprop)
 : class_name_(nam), properties_(nprop)
 {
+      for (size_t idx = 0 ; idx < properties_.size() ; idx += 1) {
+	    properties_[idx].kind = PK_NONE;
+	    properties_[idx].offset = 0;
+	    properties_[idx].wid = 0;
+	    properties_[idx].array_size = 0;
+      }
       instance_size_ = 0;
+      free_list_ = 0;
 }
 
 class_type::~class_type()
 {
-      for (size_t idx = 0 ; idx < properties_.size() ; idx += 1)
-	    delete properties_[idx].type;
+      while (free_list_) {
+	    char*buf = reinterpret_cast<char*> (free_list_);
+	    free_list_ = *reinterpret_cast<void**> (buf);
+	    delete[]buf;
+      }
 }
 
 void class_type::set_property(size_t idx, const string&name, const string&type, uint64_t array_size)
 {
       assert(idx < properties_.size());
-      properties_[idx].name = name;
+      prop_t&prop = properties_[idx];
+      prop.name = name;
 
       if (type == "b8")
-	    properties_[idx].type = new property_atom<uint8_t>;
+	    prop.kind = PK_U8;
       else if (type == "b16")
-	    properties_[idx].type = new property_atom<uint16_t>;
+	    prop.kind = PK_U16;
       else if (type == "b32")
-	    properties_[idx].type = new property_atom<uint32_t>;
+	    prop.kind = PK_U32;
       else if (type == "b64")
-	    properties_[idx].type = new property_atom<uint64_t>;
+	    prop.kind = PK_U64;
       else if (type == "sb8")
-	    properties_[idx].type = new property_atom<int8_t>;
+	    prop.kind = PK_S8;
       else if (type == "sb16")
-	    properties_[idx].type = new property_atom<int16_t>;
+	    prop.kind = PK_S16;
       else if (type == "sb32")
-	    properties_[idx].type = new property_atom<int32_t>;
+	    prop.kind = PK_S32;
       else if (type == "sb64")
-	    properties_[idx].type = new property_atom<int64_t>;
+	    prop.kind = PK_S64;
       else if (type == "r")
-	    properties_[idx].type = new property_real<double>;
+	    prop.kind = PK_REAL;
       else if (type == "S")
-	    properties_[idx].type = new property_string;
-      else if (type == "o")
-	    properties_[idx].type = new property_object(array_size);
-      else if (type[0] == 'b') {
-	    size_t wid = strtoul(type.c_str()+1, 0, 0);
-	    properties_[idx].type = new property_bit(wid);
+	    prop.kind = PK_STRING;
+      else if (type == "o") {
+	    prop.kind = PK_OBJECT;
+	    prop.array_size = array_size==0? 1 : array_size;
+      } else if (type[0] == 'b') {
+	    prop.kind = PK_BIT;
+	    prop.wid = strtoul(type.c_str()+1, 0, 0);
       } else if (type[0] == 'L') {
-	    size_t wid = strtoul(type.c_str()+1,0,0);
-	    properties_[idx].type = new property_logic(wid);
+	    prop.kind = PK_LOGIC;
+	    prop.wid = strtoul(type.c_str()+1,0,0);
       } else if (type[0] == 's' && type[1] == 'L') {
-	    size_t wid = strtoul(type.c_str()+2,0,0);
-	    properties_[idx].type = new property_logic(wid);
+	    prop.kind = PK_LOGIC;
+	    prop.wid = strtoul(type.c_str()+2,0,0);
       } else {
-	    properties_[idx].type = 0;
+	    prop.kind = PK_NONE;
       }
 }
 
 void class_type::finish_setup(void)
 {
-      map<size_t, vector<size_t> > size_map;
-	// Add up all the sizes to get a total instance size. This
-	// figures out how much memory a complete instance will need.
+	// Lay the properties out in order, each aligned for its
+	// kind. Keeping the declaration order means that the
+	// properties inherited from a base class have the same
+	// offsets as they have in the base class.
       size_t accum = 0;
+      size_t max_align = __alignof__(void*);
       for (size_t idx = 0 ; idx < properties_.size() ; idx += 1) {
-	    assert(properties_[idx].type);
-	    size_t instance_size = properties_[idx].type->instance_size();
-	    accum += instance_size;
-	    size_map[instance_size].push_back(idx);
+	    prop_t&prop = properties_[idx];
+	    assert(prop.kind != PK_NONE);
+	    size_t align = prop_align(prop.kind);
+	    if (align > max_align) max_align = align;
+	    accum = (accum + align - 1) / align * align;
+	    prop.offset = accum;
+	    accum += prop_size(prop.kind, prop.array_size);
       }
 
-      instance_size_ = accum;
-
-	// Now allocate the properties to offsets within an instance
-	// space. Allocate the properties largest objects first so
-	// that they are assured better alignment.
-      accum = 0;
-      for (map<size_t, vector<size_t> >::reverse_iterator cur = size_map.rbegin()
-		 ; cur != size_map.rend() ; ++ cur) {
-	    for (size_t idx = 0 ; idx < cur->second.size() ; idx += 1) {
-		  size_t pid = cur->second[idx];
-		  class_property_t*ptype = properties_[pid].type;
-		  assert(ptype->instance_size() == cur->first);
-		  ptype->set_offset(accum);
-		  accum += cur->first;
-	    }
-      }
+	// The free list chains through the first word of a deleted
+	// instance, so every instance has room for a pointer.
+      if (accum < sizeof(void*)) accum = sizeof(void*);
+      instance_size_ = (accum + max_align - 1) / max_align * max_align;
 }
 
 class_type::inst_t class_type::instance_new() const
 {
-      char*buf = new char [instance_size_];
+      char*buf;
+      if (free_list_) {
+	    buf = reinterpret_cast<char*> (free_list_);
+	    free_list_ = *reinterpret_cast<void**> (buf);
+      } else {
+	    buf = new char [instance_size_];
+      }
 
-      for (size_t idx = 0 ; idx < properties_.size() ; idx += 1)
-	    properties_[idx].type->construct(buf);
+      for (size_t idx = 0 ; idx < properties_.size() ; idx += 1) {
+	    const prop_t&prop = properties_[idx];
+	    char*ptr = buf + prop.offset;
+	    switch (prop.kind) {
+		case PK_U8:
+		case PK_S8:
+		  *prop_ptr<uint8_t>(buf,prop.offset) = 0;
+		  break;
+		case PK_U16:
+		case PK_S16:
+		  *prop_ptr<uint16_t>(buf,prop.offset) = 0;
+		  break;
+		case PK_U32:
+		case PK_S32:
+		  *prop_ptr<uint32_t>(buf,prop.offset) = 0;
+		  break;
+		case PK_U64:
+		case PK_S64:
+		  *prop_ptr<uint64_t>(buf,prop.offset) = 0;
+		  break;
+		case PK_REAL:
+		  *prop_ptr<double>(buf,prop.offset) = 0.0;
+		  break;
+		case PK_STRING:
+		  new (ptr) string;
+		  break;
+		case PK_OBJECT:
+		  for (size_t aidx = 0 ; aidx < prop.array_size ; aidx += 1)
+			new (ptr + aidx*sizeof(vvp_object_t)) vvp_object_t;
+		  break;
+		case PK_BIT:
+		  new (ptr) vvp_vector2_t (0, prop.wid);
+		  break;
+		case PK_LOGIC:
+		  new (ptr) vvp_vector4_t (0, prop.wid);
+		  break;
+		default:
+		  assert(0);
+		  break;
+	    }
+      }
 
       return reinterpret_cast<inst_t> (buf);
 }
@@ -494,10 +261,31 @@ void class_type::instance_delete(class_type::inst_t obj) const
 {
       char*buf = reinterpret_cast<char*> (obj);
 
-      for (size_t idx = 0 ; idx < properties_.size() ; idx += 1)
-	    properties_[idx].type->destruct(buf);
+      for (size_t idx = 0 ; idx < properties_.size() ; idx += 1) {
+	    const prop_t&prop = properties_[idx];
+	    switch (prop.kind) {
+		case PK_STRING:
+		  prop_ptr<string>(buf,prop.offset)->~string();
+		  break;
+		case PK_OBJECT: {
+		      vvp_object_t*tmp = prop_ptr<vvp_object_t>(buf,prop.offset);
+		      for (size_t aidx = 0 ; aidx < prop.array_size ; aidx += 1)
+			    (tmp+aidx)->~vvp_object_t();
+		      break;
+		}
+		case PK_BIT:
+		  prop_ptr<vvp_vector2_t>(buf,prop.offset)->~vvp_vector2_t();
+		  break;
+		case PK_LOGIC:
+		  prop_ptr<vvp_vector4_t>(buf,prop.offset)->~vvp_vector4_t();
+		  break;
+		default:
+		  break;
+	    }
+      }
 
-      delete[]buf;
+      *reinterpret_cast<void**> (buf) = free_list_;
+      free_list_ = buf;
 }
 
 void class_type::set_vec4(class_type::inst_t obj, size_t pid,
@@ -505,7 +293,43 @@ void class_type::set_vec4(class_type::inst_t obj, size_t pid,
 {
       char*buf = reinterpret_cast<char*> (obj);
       assert(pid < properties_.size());
-      properties_[pid].type->set_vec4(buf, val);
+      const prop_t&prop = properties_[pid];
+
+      switch (prop.kind) {
+	  case PK_U8:
+	    atom_set_vec4<uint8_t>(buf, prop.offset, val);
+	    break;
+	  case PK_U16:
+	    atom_set_vec4<uint16_t>(buf, prop.offset, val);
+	    break;
+	  case PK_U32:
+	    atom_set_vec4<uint32_t>(buf, prop.offset, val);
+	    break;
+	  case PK_U64:
+	    atom_set_vec4<uint64_t>(buf, prop.offset, val);
+	    break;
+	  case PK_S8:
+	    atom_set_vec4<int8_t>(buf, prop.offset, val);
+	    break;
+	  case PK_S16:
+	    atom_set_vec4<int16_t>(buf, prop.offset, val);
+	    break;
+	  case PK_S32:
+	    atom_set_vec4<int32_t>(buf, prop.offset, val);
+	    break;
+	  case PK_S64:
+	    atom_set_vec4<int64_t>(buf, prop.offset, val);
+	    break;
+	  case PK_BIT:
+	    *prop_ptr<vvp_vector2_t>(buf,prop.offset) = val;
+	    break;
+	  case PK_LOGIC:
+	    *prop_ptr<vvp_vector4_t>(buf,prop.offset) = val;
+	    break;
+	  default:
+	    assert(0);
+	    break;
+      }
 }
 
 void class_type::get_vec4(class_type::inst_t obj, size_t pid,
@@ -513,7 +337,45 @@ void class_type::get_vec4(class_type::inst_t obj, size_t pid,
 {
       char*buf = reinterpret_cast<char*> (obj);
       assert(pid < properties_.size());
-      properties_[pid].type->get_vec4(buf, val);
+      const prop_t&prop = properties_[pid];
+
+      switch (prop.kind) {
+	  case PK_U8:
+	    atom_get_vec4<uint8_t>(buf, prop.offset, val);
+	    break;
+	  case PK_U16:
+	    atom_get_vec4<uint16_t>(buf, prop.offset, val);
+	    break;
+	  case PK_U32:
+	    atom_get_vec4<uint32_t>(buf, prop.offset, val);
+	    break;
+	  case PK_U64:
+	    atom_get_vec4<uint64_t>(buf, prop.offset, val);
+	    break;
+	  case PK_S8:
+	    atom_get_vec4<int8_t>(buf, prop.offset, val);
+	    break;
+	  case PK_S16:
+	    atom_get_vec4<int16_t>(buf, prop.offset, val);
+	    break;
+	  case PK_S32:
+	    atom_get_vec4<int32_t>(buf, prop.offset, val);
+	    break;
+	  case PK_S64:
+	    atom_get_vec4<int64_t>(buf, prop.offset, val);
+	    break;
+	  case PK_BIT: {
+		vvp_vector2_t*tmp = prop_ptr<vvp_vector2_t>(buf,prop.offset);
+		val = vector2_to_vector4(*tmp, tmp->size());
+		break;
+	  }
+	  case PK_LOGIC:
+	    val = *prop_ptr<vvp_vector4_t>(buf,prop.offset);
+	    break;
+	  default:
+	    assert(0);
+	    break;
+      }
 }
 
 void class_type::set_real(class_type::inst_t obj, size_t pid,
@@ -521,14 +383,16 @@ void class_type::set_real(class_type::inst_t obj, size_t pid,
 {
       char*buf = reinterpret_cast<char*> (obj);
       assert(pid < properties_.size());
-      properties_[pid].type->set_real(buf, val);
+      assert(properties_[pid].kind == PK_REAL);
+      *prop_ptr<double>(buf,properties_[pid].offset) = val;
 }
 
 double class_type::get_real(class_type::inst_t obj, size_t pid) const
 {
       char*buf = reinterpret_cast<char*> (obj);
       assert(pid < properties_.size());
-      return properties_[pid].type->get_real(buf);
+      assert(properties_[pid].kind == PK_REAL);
+      return *prop_ptr<double>(buf,properties_[pid].offset);
 }
 
 void class_type::set_string(class_type::inst_t obj, size_t pid,
@@ -536,14 +400,16 @@ void class_type::set_string(class_type::inst_t obj, size_t pid,
 {
       char*buf = reinterpret_cast<char*> (obj);
       assert(pid < properties_.size());
-      properties_[pid].type->set_string(buf, val);
+      assert(properties_[pid].kind == PK_STRING);
+      *prop_ptr<string>(buf,properties_[pid].offset) = val;
 }
 
 string class_type::get_string(class_type::inst_t obj, size_t pid) const
 {
       char*buf = reinterpret_cast<char*> (obj);
       assert(pid < properties_.size());
-      return properties_[pid].type->get_string(buf);
+      assert(properties_[pid].kind == PK_STRING);
+      return *prop_ptr<string>(buf,properties_[pid].offset);
 }
 
 void class_type::set_object(class_type::inst_t obj, size_t pid,
@@ -551,7 +417,10 @@ void class_type::set_object(class_type::inst_t obj, size_t pid,
 {
       char*buf = reinterpret_cast<char*> (obj);
       assert(pid < properties_.size());
-      properties_[pid].type->set_object(buf, val, idx);
+      const prop_t&prop = properties_[pid];
+      assert(prop.kind == PK_OBJECT);
+      assert(idx < prop.array_size);
+      prop_ptr<vvp_object_t>(buf,prop.offset)[idx] = val;
 }
 
 void class_type::get_object(class_type::inst_t obj, size_t pid,
@@ -559,7 +428,10 @@ void class_type::get_object(class_type::inst_t obj, size_t pid,
 {
       char*buf = reinterpret_cast<char*> (obj);
       assert(pid < properties_.size());
-      properties_[pid].type->get_object(buf, val, idx);
+      const prop_t&prop = properties_[pid];
+      assert(prop.kind == PK_OBJECT);
+      assert(idx < prop.array_size);
+      val = prop_ptr<vvp_object_t>(buf,prop.offset)[idx];
 }
 
 void class_type::copy_property(class_type::inst_t dst, size_t pid, class_type::inst_t src) const
@@ -568,8 +440,48 @@ void class_type::copy_property(class_type::inst_t dst, size_t pid, class_type::i
       char*src_buf = reinterpret_cast<char*> (src);
 
       assert(pid < properties_.size());
-
-      properties_[pid].type->copy(dst_buf, src_buf);
+      const prop_t&prop = properties_[pid];
+
+      switch (prop.kind) {
+	  case PK_U8:
+	  case PK_S8:
+	    atom_copy<uint8_t>(dst_buf, src_buf, prop.offset);
+	    break;
+	  case PK_U16:
+	  case PK_S16:
+	    atom_copy<uint16_t>(dst_buf, src_buf, prop.offset);
+	    break;
+	  case PK_U32:
+	  case PK_S32:
+	    atom_copy<uint32_t>(dst_buf, src_buf, prop.offset);
+	    break;
+	  case PK_U64:
+	  case PK_S64:
+	    atom_copy<uint64_t>(dst_buf, src_buf, prop.offset);
+	    break;
+	  case PK_REAL:
+	    atom_copy<double>(dst_buf, src_buf, prop.offset);
+	    break;
+	  case PK_STRING:
+	    atom_copy<string>(dst_buf, src_buf, prop.offset);
+	    break;
+	  case PK_OBJECT: {
+		vvp_object_t*dst_obj = prop_ptr<vvp_object_t>(dst_buf,prop.offset);
+		vvp_object_t*src_obj = prop_ptr<vvp_object_t>(src_buf,prop.offset);
+		for (size_t idx = 0 ; idx < prop.array_size ; idx += 1)
+		      dst_obj[idx] = src_obj[idx];
+		break;
+	  }
+	  case PK_BIT:
+	    atom_copy<vvp_vector2_t>(dst_buf, src_buf, prop.offset);
+	    break;
+	  case PK_LOGIC:
+	    atom_copy<vvp_vector4_t>(dst_buf, src_buf, prop.offset);
+	    break;
+	  default:
+	    assert(0);
+	    break;
+      }
 }
 
 int class_type::get_type_code(void) const
@@ -21,15 +21,22 @@
 
 # include  <string>
 # include  <vector>
+# include  <cassert>
 # include  "vpi_priv.h"
 
-class class_property_t;
 class vvp_vector4_t;
 
 /*
  * This represents the TYPE information for a class. A %new operator
  * uses this information to figure out how to construct an actual
  * instance.
+ *
+ * An instance is a single flat block of memory that holds all the
+ * properties in place. Each property has a kind that says how it is
+ * stored, and an offset into the block. The properties are laid out
+ * in declaration order, each aligned for its kind. A derived class
+ * starts with the properties of its base class, so a property has the
+ * same offset in every class that has it.
  */
 class class_type : public __vpiHandle {
 
@@ -37,6 +44,16 @@ class class_type : public __vpiHandle {
       struct inst_x;
       typedef inst_x*inst_t;
 
+	// These are the ways a property can be stored in an instance.
+      enum prop_kind_t {
+	    PK_NONE = 0,
+	    PK_U8, PK_U16, PK_U32, PK_U64,
+	    PK_S8, PK_S16, PK_S32, PK_S64,
+	    PK_REAL, PK_STRING, PK_OBJECT,
+	    PK_BIT,   // vvp_vector2_t
+	    PK_LOGIC  // vvp_vector4_t
+      };
+
     public:
       explicit class_type(const std::string&nam, size_t nprop);
       ~class_type();
@@ -56,7 +73,8 @@ class class_type : public __vpiHandle {
       void finish_setup(void);
 
     public:
-	// Constructors and destructors for making instances.
+	// Constructors and destructors for making instances. The
+	// memory for instances is kept in a free list and reused.
       inst_t instance_new() const;
       void instance_delete(inst_t) const;
 
@@ -71,6 +89,16 @@ class class_type : public __vpiHandle {
 
       void copy_property(inst_t dst, size_t idx, inst_t src) const;
 
+	// Direct access to a property that is stored as a
+	// vvp_vector4_t. The typed %prop/v4 instructions use this to
+	// read and write the value in place.
+      inline vvp_vector4_t&peek_vec4(inst_t inst, size_t pid) const
+      { assert(pid < properties_.size());
+	assert(properties_[pid].kind == PK_LOGIC);
+	return *reinterpret_cast<vvp_vector4_t*>
+	      (reinterpret_cast<char*>(inst) + properties_[pid].offset);
+      }
+
     public: // VPI related methods
       int get_type_code(void) const;
 
@@ -79,10 +107,20 @@ class class_type : public __vpiHandle {
 
       struct prop_t {
 	    std::string name;
-	    class_property_t*type;
+	    prop_kind_t kind;
+	      // Offset of the property within an instance.
+	    size_t offset;
+	      // Width of PK_BIT and PK_LOGIC properties.
+	    size_t wid;
+	      // Number of objects in a PK_OBJECT property.
+	    size_t array_size;
       };
       std::vector<prop_t> properties_;
       size_t instance_size_;
+
+	// Instances that were deleted, chained through their first
+	// word, ready to be used again.
+      mutable void*free_list_;
 };
 
 #endif /* IVL_class_type_H */
@@ -111,7 +111,8 @@ void codespace_delete(void)
 	    vvp_code_t next = cur[code_chunk_size-1].cptr;
 	    for (unsigned idx = 0 ; idx < code_chunk_size; idx += 1) {
 		  count_opcodes -= 1;
-		  if ((cur+idx)->opcode == &of_VPI_CALL) {
+		  if (((cur+idx)->opcode == &of_VPI_CALL) ||
+		      ((cur+idx)->opcode == &of_VPI_NATIVE)) {
 			vpi_call_delete((cur+idx)->handle);
 		  } else if (((cur+idx)->opcode == &of_EXEC_UFUNC_REAL) ||
 		             ((cur+idx)->opcode == &of_EXEC_UFUNC_VEC4)) {
@@ -34,9 +34,14 @@
 # include  "schedule.h"
 # include  <iostream>
 # include  <list>
+# include  <vector>
 # include  <cstdlib>
 # include  <cstring>
 # include  <cassert>
+# include  <unistd.h>
+#ifdef HAVE_LIBPTHREAD
+# include  <pthread.h>
+#endif
 
 #ifdef __MINGW32__
 #include <windows.h>
@@ -244,6 +249,7 @@ static const struct opcode_table_s opcode_table[] = {
       { "%prop/r",  of_PROP_R,  1,  {OA_NUMBER,   OA_NONE,     OA_NONE} },
       { "%prop/str",of_PROP_STR,1,  {OA_NUMBER,   OA_NONE,     OA_NONE} },
       { "%prop/v",  of_PROP_V,  1,  {OA_NUMBER,   OA_NONE,     OA_NONE} },
+      { "%prop/v4", of_PROP_V4, 1,  {OA_NUMBER,   OA_NONE,     OA_NONE} },
       { "%pushi/real",of_PUSHI_REAL,2,{OA_BIT1,   OA_BIT2,   OA_NONE} },
       { "%pushi/str", of_PUSHI_STR, 1,{OA_STRING, OA_NONE,   OA_NONE} },
       { "%pushi/vec4",of_PUSHI_VEC4,3,{OA_BIT1,   OA_BIT2,   OA_NUMBER} },
@@ -285,6 +291,7 @@ static const struct opcode_table_s opcode_table[] = {
       { "%store/prop/r",  of_STORE_PROP_R,  1, {OA_NUMBER,  OA_NONE, OA_NONE} },
       { "%store/prop/str",of_STORE_PROP_STR,1, {OA_NUMBER,  OA_NONE, OA_NONE} },
       { "%store/prop/v",  of_STORE_PROP_V,  2, {OA_NUMBER,  OA_BIT1, OA_NONE} },
+      { "%store/prop/v4", of_STORE_PROP_V4, 2, {OA_NUMBER,  OA_BIT1, OA_NONE} },
       { "%store/qb/r",   of_STORE_QB_R,    2, {OA_FUNC_PTR, OA_BIT1, OA_NONE} },
       { "%store/qb/str", of_STORE_QB_STR,  2, {OA_FUNC_PTR, OA_BIT1, OA_NONE} },
       { "%store/qb/v",   of_STORE_QB_V,    3, {OA_FUNC_PTR, OA_BIT1, OA_BIT2} },
@@ -389,6 +396,69 @@ vpiHandle vvp_lookup_handle(const char*label)
       return 0;
 }
 
+/*
+ * Get the vvp_net_t that carries the value of a vpi object that is
+ * used in a net context.
+ */
+static vvp_net_t* vpi_handle_net(vpiHandle vpi)
+{
+      switch (vpi->get_type_code()) {
+	  case vpiNet:
+	  case vpiReg:
+	  case vpiBitVar:
+	  case vpiByteVar:
+	  case vpiShortIntVar:
+	  case vpiIntVar:
+	  case vpiLongIntVar:
+	  case vpiIntegerVar: {
+		__vpiSignal*sig = dynamic_cast<__vpiSignal*>(vpi);
+		return sig->node;
+	  }
+
+	  case vpiRealVar: {
+		__vpiRealVar*sig = dynamic_cast<__vpiRealVar*>(vpi);
+		return sig->net;
+	  }
+
+	  case vpiStringVar:
+	  case vpiArrayVar:
+	  case vpiClassVar: {
+		__vpiBaseVar*sig = dynamic_cast<__vpiBaseVar*>(vpi);
+		return sig->get_net();
+	  }
+
+	  case vpiNamedEvent: {
+		__vpiNamedEvent*tmp = dynamic_cast<__vpiNamedEvent*>(vpi);
+		return tmp->funct;
+	  }
+
+	  default:
+	    fprintf(stderr, "Unsupported type %d.\n",
+		    vpi->get_type_code());
+	    assert(0);
+      }
+      return 0;
+}
+
+/*
+ * This is a read-only version of vvp_net_lookup. It does not add
+ * anything to the symbol tables, and does not create the implicit T0
+ * trigger event, so it can be used by the resolv_list prefetch
+ * threads. A 0 result means only that the slow path is needed.
+ */
+static vvp_net_t* vvp_net_find(const char*label)
+{
+      if (strcmp(label, "E_0x0") == 0)
+	    return 0;
+
+      symbol_value_t val = sym_find_value(sym_vpi, label);
+      if (val.ptr)
+	    return vpi_handle_net((vpiHandle) val.ptr);
+
+      val = sym_find_value(sym_functors, label);
+      return val.net;
+}
+
 vvp_net_t* vvp_net_lookup(const char*label)
 {
       static bool t0_trigger_generated = false;
@@ -397,45 +467,8 @@ vvp_net_t* vvp_net_lookup(const char*label)
 	   sort. If it is, then get the vvp_ipoint_t pointer out of
 	   the vpiHandle. */
       symbol_value_t val = sym_get_value(sym_vpi, label);
-      if (val.ptr) {
-	    vpiHandle vpi = (vpiHandle) val.ptr;
-	    switch (vpi->get_type_code()) {
-		case vpiNet:
-		case vpiReg:
-		case vpiBitVar:
-		case vpiByteVar:
-		case vpiShortIntVar:
-		case vpiIntVar:
-		case vpiLongIntVar:
-		case vpiIntegerVar: {
-		      __vpiSignal*sig = dynamic_cast<__vpiSignal*>(vpi);
-		      return sig->node;
-		}
-
-		case vpiRealVar: {
-		      __vpiRealVar*sig = dynamic_cast<__vpiRealVar*>(vpi);
-		      return sig->net;
-		}
-
-		case vpiStringVar:
-		case vpiArrayVar:
-		case vpiClassVar: {
-		      __vpiBaseVar*sig = dynamic_cast<__vpiBaseVar*>(vpi);
-		      return sig->get_net();
-		}
-
-		case vpiNamedEvent: {
-		      __vpiNamedEvent*tmp = dynamic_cast<__vpiNamedEvent*>(vpi);
-		      return tmp->funct;
-		}
-
-		default:
-		  fprintf(stderr, "Unsupported type %d.\n",
-		          vpi->get_type_code());
-		  assert(0);
-	    }
-      }
-
+      if (val.ptr)
+	    return vpi_handle_net((vpiHandle) val.ptr);
 
 	/* Failing that, look for a general functor. */
       vvp_net_t*tmp = lookup_functor_symbol(label);
@@ -505,15 +538,19 @@ void resolv_submit(resolv_list_s*cur)
  */
 struct vvp_net_resolv_list_s: public resolv_list_s {
 
-      explicit vvp_net_resolv_list_s(char*l) : resolv_list_s(l) { }
+      explicit vvp_net_resolv_list_s(char*l) : resolv_list_s(l), found_(0) { }
 	// port to be driven by the located node.
       vvp_net_ptr_t port;
       virtual bool resolve(bool mes);
+      virtual void prefetch() { found_ = vvp_net_find(label()); }
+
+    private:
+      vvp_net_t*found_;
 };
 
 bool vvp_net_resolv_list_s::resolve(bool mes)
 {
-      vvp_net_t*tmp = vvp_net_lookup(label());
+      vvp_net_t*tmp = found_? found_ : vvp_net_lookup(label());
 
       if (tmp) {
 	      // Link the input port to the located output.
@@ -544,14 +581,19 @@ void postpone_functor_input(vvp_net_ptr_t port, char*lab)
 struct functor_gen_resolv_list_s: public resolv_list_s {
       explicit functor_gen_resolv_list_s(char*txt) : resolv_list_s(txt) {
 	    ref = 0;
+	    found_ = 0;
       }
       vvp_net_t**ref;
       virtual bool resolve(bool mes);
+      virtual void prefetch() { found_ = vvp_net_find(label()); }
+
+    private:
+      vvp_net_t*found_;
 };
 
 bool functor_gen_resolv_list_s::resolve(bool mes)
 {
-      vvp_net_t*tmp = vvp_net_lookup(label());
+      vvp_net_t*tmp = found_? found_ : vvp_net_lookup(label());
 
       if (tmp) {
 	    *ref = tmp;
@@ -581,14 +623,19 @@ void functor_ref_lookup(vvp_net_t**ref, char*lab)
 struct vpi_handle_resolv_list_s: public resolv_list_s {
       explicit vpi_handle_resolv_list_s(char*lab) : resolv_list_s(lab) {
 	    handle = NULL;
+	    found_.ptr = 0;
       }
       virtual bool resolve(bool mes);
+      virtual void prefetch() { found_ = sym_find_value(sym_vpi, label()); }
       vpiHandle *handle;
+
+    private:
+      symbol_value_t found_;
 };
 
 bool vpi_handle_resolv_list_s::resolve(bool mes)
 {
-      symbol_value_t val = sym_get_value(sym_vpi, label());
+      symbol_value_t val = found_.ptr? found_ : sym_get_value(sym_vpi, label());
       if (!val.ptr) {
 	    // check for thread access symbols
 	    unsigned base, wid;
@@ -687,15 +734,20 @@ struct code_label_resolv_list_s: public resolv_list_s {
       explicit code_label_resolv_list_s(char*lab, bool cptr2) : resolv_list_s(lab) {
 	    code = NULL;
 	    cptr2_flag = cptr2;
+	    found_.ptr = 0;
       }
       struct vvp_code_s *code;
       bool cptr2_flag;
       virtual bool resolve(bool mes);
+      virtual void prefetch() { found_ = sym_find_value(sym_codespace, label()); }
+
+    private:
+      symbol_value_t found_;
 };
 
 bool code_label_resolv_list_s::resolve(bool mes)
 {
-      symbol_value_t val = sym_get_value(sym_codespace, label());
+      symbol_value_t val = found_.ptr? found_ : sym_get_value(sym_codespace, label());
       if (val.ptr) {
 	    if (cptr2_flag)
 		  code->cptr2 = reinterpret_cast<vvp_code_t>(val.ptr);
@@ -761,6 +813,75 @@ void compile_compiletf(struct __vpiSysTaskCall*obj)
       scheduled_compiletf.push_back(obj);
 }
 
+/*
+ * Run the prefetch method of all the items in the list. The symbol
+ * lookups are independent of each other and the symbol tables are
+ * not changed until the items are resolved, so the list can be split
+ * into chunks and prefetched by several threads at once. The actual
+ * linking is done afterwards by compile_cleanup, one item at a time in
+ * list order, so the resulting netlist is exactly what the serial
+ * resolution would produce.
+ */
+static const size_t resolv_prefetch_min = 16*1024;
+static const unsigned resolv_prefetch_max_threads = 8;
+
+struct resolv_prefetch_chunk_s {
+      resolv_list_s**base;
+      size_t count;
+};
+
+static void* resolv_prefetch_thread(void*arg)
+{
+      resolv_prefetch_chunk_s*chunk = (resolv_prefetch_chunk_s*)arg;
+      for (size_t idx = 0 ;  idx < chunk->count ;  idx += 1)
+	    chunk->base[idx]->prefetch();
+      return 0;
+}
+
+static void resolv_prefetch(std::vector<resolv_list_s*>&items)
+{
+      if (items.size() < resolv_prefetch_min)
+	    return;
+
+#if defined(HAVE_LIBPTHREAD) && defined(_SC_NPROCESSORS_ONLN)
+      long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+      unsigned nthreads = ncpu > 1? ncpu : 1;
+      if (nthreads > resolv_prefetch_max_threads)
+	    nthreads = resolv_prefetch_max_threads;
+
+      if (nthreads > 1) {
+	    std::vector<pthread_t> threads (nthreads);
+	    std::vector<resolv_prefetch_chunk_s> chunks (nthreads);
+	    std::vector<bool> started (nthreads);
+	    size_t base = 0;
+	    for (unsigned idx = 0 ;  idx < nthreads ;  idx += 1) {
+		  size_t next = items.size() * (idx+1) / nthreads;
+		  chunks[idx].base = &items[base];
+		  chunks[idx].count = next - base;
+		  base = next;
+		    // Chunk 0 is run by this thread.
+		  if (idx == 0) continue;
+		  started[idx] = pthread_create(&threads[idx], 0,
+						resolv_prefetch_thread,
+						&chunks[idx]) == 0;
+		    // If the thread cannot be created, do it here.
+		  if (! started[idx])
+			resolv_prefetch_thread(&chunks[idx]);
+	    }
+
+	    resolv_prefetch_thread(&chunks[0]);
+
+	    for (unsigned idx = 1 ;  idx < nthreads ;  idx += 1) {
+		  if (started[idx])
+			pthread_join(threads[idx], 0);
+	    }
+	    return;
+      }
+#endif
+      for (size_t idx = 0 ;  idx < items.size() ;  idx += 1)
+	    items[idx]->prefetch();
+}
+
 /*
  * When parsing is otherwise complete, this function is called to do
  * the final stuff. Clean up deferred linking here.
@@ -771,6 +892,7 @@ void compile_cleanup(void)
       int lnerrs = -1;
       int nerrs = 0;
       int last;
+      bool first_pass = true;
 
       if (verbose_flag) {
 	    fprintf(stderr, " ... Linking\n");
@@ -783,6 +905,19 @@ void compile_cleanup(void)
 	    last = nerrs == lnerrs;
 	    lnerrs = nerrs;
 	    nerrs = 0;
+
+	      /* The symbol tables are complete on the first pass, so
+		 that is when most of the lookups can be done in
+		 parallel. Later passes only see the few items that
+		 depend on other resolutions. */
+	    if (first_pass) {
+		  std::vector<resolv_list_s*> items;
+		  for (resolv_list_s*cur = res ; cur ; cur = cur->next)
+			items.push_back(cur);
+		  resolv_prefetch(items);
+		  first_pass = false;
+	    }
+
 	    while (res) {
 		  resolv_list_s *cur = res;
 		  res = res->next;
@@ -802,6 +937,13 @@ void compile_cleanup(void)
 
       compile_errors += nerrs;
 
+      if (verbose_flag) {
+	    fprintf(stderr, " ... Levelizing logic\n");
+	    fflush(stderr);
+      }
+
+      compile_levelize();
+
       if (verbose_flag) {
 	    fprintf(stderr, " ... Removing symbol tables\n");
 	    fflush(stderr);
@@ -854,15 +996,21 @@ void compile_vpi_symbol(const char*label, vpiHandle obj)
 
 /*
  * Initialize the compiler by allocation empty symbol tables and
- * initializing the various address spaces.
+ * initializing the various address spaces. The symbol tables are
+ * sized from the size of the input file: a typical .vvp file has a
+ * functor label every 64 or so bytes, and far fewer scope, signal
+ * and code labels. This is only a starting size. The symbol table
+ * limits how much it allocates for a hint, and grows as labels are
+ * added, so a large or a compressed input file (whose size says
+ * little about the number of labels) still gets the right size.
  */
-void compile_init(void)
+void compile_init(size_t design_size)
 {
-      sym_vpi = new_symbol_table();
+      sym_vpi = new_symbol_table(design_size / 256);
 
-      sym_functors = new_symbol_table();
+      sym_functors = new_symbol_table(design_size / 64);
 
-      sym_codespace = new_symbol_table();
+      sym_codespace = new_symbol_table(design_size / 256);
       codespace_init();
 }
 
@@ -1965,6 +2113,12 @@ void compile_vpi_func_call(char*label, char*name,
       if (code->handle == 0)
 	    compile_errors += 1;
 
+	/* If vvp implements the function itself, then call the
+	   native function directly. */
+      __vpiSysTaskCall*call = dynamic_cast<__vpiSysTaskCall*>(code->handle);
+      if (call && call->native)
+	    code->opcode = &of_VPI_NATIVE;
+
 	/* Done with the lexor-allocated name string. */
       delete[] name;
 }
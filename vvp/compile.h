@@ -39,10 +39,11 @@ extern std::vector<const char*> file_names;
  * here. What is called when is mostly controlled by the parser.
  *
  * Before compilation takes place, the compile_init function must be
- * called once to set stuff up.
+ * called once to set stuff up. The design_size is the size in bytes of
+ * the input file, if known, and is used to pre-size the symbol tables.
  */
 
-extern void compile_init(void);
+extern void compile_init(size_t design_size =0);
 
 extern void compile_cleanup(void);
 
@@ -104,6 +105,24 @@ extern void compile_functor(char*label, char*type, unsigned width,
 			    unsigned ostr0, unsigned ostr1,
 			    unsigned argc, struct symb_s*argv);
 
+/*
+ * This is called by the parser to make a LUT functor. The table is a
+ * string with an output ('0', '1' or 'x') for every combination of
+ * 0, 1 and x on the inputs, so it has 3**argc characters. The first
+ * input is the least significant digit of the (base 3) entry number.
+ */
+extern void compile_functor_lut(char*label, char*type, unsigned width,
+				char*table, unsigned argc,
+				struct symb_s*argv);
+
+/*
+ * After all the functors are linked, this assigns a level to each of
+ * the leveled logic functors made by compile_functor. Nets that are
+ * not leveled are passed through, so the level of a functor counts
+ * only the leveled functors that are downstream of it.
+ */
+extern void compile_levelize(void);
+
 
 /*
  * This is called by the parser to make a resolver. This is a special
@@ -308,6 +327,13 @@ extern void compile_param_real(char*label, char*name, char*value,
  * The mes parameter of the resolve method tells the resolver that
  * this call is its last chance. If it cannot complete the operation,
  * it must print an error message and return false.
+ *
+ * Derived classes that resolve by a plain symbol lookup may also
+ * implement the prefetch method. compile_cleanup calls it for all the
+ * pending items, possibly from several worker threads at once, before
+ * it calls resolve for each item in the usual order. The prefetch
+ * must therefore only read the symbol tables and write into its own
+ * object; the linking itself is left to resolve.
  */
 class resolv_list_s {
 
@@ -317,6 +343,7 @@ class resolv_list_s {
       }
       virtual ~resolv_list_s();
       virtual bool resolve(bool mes = false) = 0;
+      virtual void prefetch() { }
 
     protected:
       const char*label() const { return label_; }
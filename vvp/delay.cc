@@ -161,7 +161,8 @@ vvp_fun_delay::vvp_fun_delay(vvp_net_t*n, unsigned width, const vvp_delay_t&d)
       } else {
             schedule_init_propagate(net_, cur_real_);
       }
-      list_ = 0;
+      wake_set_ = false;
+      wake_ = 0;
       type_ = UNKNOWN_DELAY;
       initial_ = true;
 	// Calculate the values used when converting variable delays
@@ -179,67 +180,62 @@ vvp_fun_delay::vvp_fun_delay(vvp_net_t*n, unsigned width, const vvp_delay_t&d)
 
 vvp_fun_delay::~vvp_fun_delay()
 {
-      while (struct event_*cur = dequeue_())
-	    delete cur;
 }
 
-bool vvp_fun_delay::clean_pulse_events_(vvp_time64_t use_delay,
-                                        const vvp_vector4_t&bit)
+static inline bool same_value_(const vvp_vector4_t&a, const vvp_vector4_t&b)
 {
-      if (list_ == 0) return false;
-
-	/* If the most recent event and the new event have the same
-	 * value then we need to skip the new event. */
-      if (list_->next->ptr_vec4.eeq(bit)) return true;
-
-      clean_pulse_events_(use_delay);
-      return false;
+      return a.eeq(b);
 }
 
-bool vvp_fun_delay::clean_pulse_events_(vvp_time64_t use_delay,
-                                        const vvp_vector8_t&bit)
+static inline bool same_value_(const vvp_vector8_t&a, const vvp_vector8_t&b)
 {
-      if (list_ == 0) return false;
-
-	/* If the most recent event and the new event have the same
-	 * value then we need to skip the new event. */
-      if (list_->next->ptr_vec8.eeq(bit)) return true;
+      return a.eeq(b);
+}
 
-      clean_pulse_events_(use_delay);
-      return false;
+static inline bool same_value_(double a, double b)
+{
+      return a == b;
 }
 
-bool vvp_fun_delay::clean_pulse_events_(vvp_time64_t use_delay,
-                                        double bit)
+template <class T>
+bool vvp_fun_delay::clean_pulse_events_(vvp_delay_ring_t<T>&list,
+					vvp_time64_t use_delay, const T&bit)
 {
-      if (list_ == 0) return false;
+      if (list.empty()) return false;
 
 	/* If the most recent event and the new event have the same
 	 * value then we need to skip the new event. */
-      if (list_->next->ptr_real == bit) return true;
-
-      clean_pulse_events_(use_delay);
-      return false;
-}
-
-void vvp_fun_delay::clean_pulse_events_(vvp_time64_t use_delay)
-{
-      assert(list_ != 0);
+      if (same_value_(list.front(), bit)) return true;
 
       do {
-	    struct event_*cur = list_->next;
 	      /* If this event is far enough from the event I'm about
 	         to create, then that scheduled event is not a pulse
 	         to be eliminated, so we're done. */
-	    if (cur->sim_time+use_delay <= use_delay+schedule_simtime())
+	    if (list.front_time()+use_delay <= use_delay+schedule_simtime())
 		  break;
 
-	    if (list_ == cur)
-		  list_ = 0;
-	    else
-		  list_->next = cur->next;
-	    delete cur;
-      } while (list_);
+	    list.pop_front();
+      } while (! list.empty());
+
+      return false;
+}
+
+/*
+ * Make sure that there is a scheduler event at or before sim_time,
+ * the time of the oldest pending transition.
+ */
+void vvp_fun_delay::schedule_wake_(vvp_time64_t sim_time)
+{
+      vvp_time64_t now = schedule_simtime();
+      if (sim_time < now)
+	    sim_time = now;
+
+      if (wake_set_ && wake_ <= sim_time)
+	    return;
+
+      wake_set_ = true;
+      wake_ = sim_time;
+      schedule_generic(this, sim_time - now, false);
 }
 
 /*
@@ -296,7 +292,7 @@ void vvp_fun_delay::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
 	      // current value of the output. Detect and handle the
 	      // special case that the event list contains the current
 	      // value as a zero-delay-remaining event.
-	    const vvp_vector4_t&use_vec4 = (list_ && list_->next->sim_time == schedule_simtime())? list_->next->ptr_vec4 : cur_vec4_;
+	    const vvp_vector4_t&use_vec4 = (!list_vec4_.empty() && list_vec4_.front_time() == schedule_simtime())? list_vec4_.front() : cur_vec4_;
 
 	      /* How many bits to compare? */
 	    unsigned use_wid = use_vec4.size();
@@ -316,21 +312,18 @@ void vvp_fun_delay::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
       /* what *should* happen here is we check to see if there is a
          transaction in the queue. This would be a pulse that needs to be
          eliminated. */
-      if (clean_pulse_events_(use_delay, bit)) return;
+      if (clean_pulse_events_(list_vec4_, use_delay, bit)) return;
 
       vvp_time64_t use_simtime = schedule_simtime() + use_delay;
 
 	/* And propagate it. */
-      if (use_delay == 0 && list_ == 0) {
+      if (use_delay == 0 && list_vec4_.empty()) {
 	    cur_vec4_ = bit;
 	    initial_ = false;
 	    net_->send_vec4(cur_vec4_, 0);
       } else {
-	    struct event_*cur = new struct event_(use_simtime);
-	    cur->run_run_ptr = &vvp_fun_delay::run_run_vec4_;
-	    cur->ptr_vec4 = bit;
-	    enqueue_(cur);
-	    schedule_generic(this, use_delay, false);
+	    list_vec4_.push_back(use_simtime, bit);
+	    schedule_wake_(list_vec4_.front_time());
       }
 }
 
@@ -365,7 +358,7 @@ void vvp_fun_delay::recv_vec8(vvp_net_ptr_t port, const vvp_vector8_t&bit)
 	      // current value of the output. Detect and handle the
 	      // special case that the event list contains the current
 	      // value as a zero-delay-remaining event.
-	    const vvp_vector8_t&use_vec8 = (list_ && list_->next->sim_time == schedule_simtime())? list_->next->ptr_vec8 : cur_vec8_;
+	    const vvp_vector8_t&use_vec8 = (!list_vec8_.empty() && list_vec8_.front_time() == schedule_simtime())? list_vec8_.front() : cur_vec8_;
 
 	      /* How many bits to compare? */
 	    unsigned use_wid = use_vec8.size();
@@ -387,21 +380,18 @@ void vvp_fun_delay::recv_vec8(vvp_net_ptr_t port, const vvp_vector8_t&bit)
       /* what *should* happen here is we check to see if there is a
          transaction in the queue. This would be a pulse that needs to be
          eliminated. */
-      if (clean_pulse_events_(use_delay, bit)) return;
+      if (clean_pulse_events_(list_vec8_, use_delay, bit)) return;
 
       vvp_time64_t use_simtime = schedule_simtime() + use_delay;
 
 	/* And propagate it. */
-      if (use_delay == 0 && list_ == 0) {
+      if (use_delay == 0 && list_vec8_.empty()) {
 	    cur_vec8_ = bit;
 	    initial_ = false;
 	    net_->send_vec8(cur_vec8_);
       } else {
-	    struct event_*cur = new struct event_(use_simtime);
-	    cur->ptr_vec8 = bit;
-	    cur->run_run_ptr = &vvp_fun_delay::run_run_vec8_;
-	    enqueue_(cur);
-	    schedule_generic(this, use_delay, false);
+	    list_vec8_.push_back(use_simtime, bit);
+	    schedule_wake_(list_vec8_.front_time());
       }
 }
 
@@ -452,7 +442,7 @@ void vvp_fun_delay::recv_real(vvp_net_ptr_t port, double bit,
       use_delay = delay_.get_min_delay();
 
       /* Eliminate glitches. */
-      if (clean_pulse_events_(use_delay, bit)) return;
+      if (clean_pulse_events_(list_real_, use_delay, bit)) return;
 
       /* This must be done after cleaning pulses to avoid propagating
        * an incorrect value. */
@@ -460,51 +450,71 @@ void vvp_fun_delay::recv_real(vvp_net_ptr_t port, double bit,
 
       vvp_time64_t use_simtime = schedule_simtime() + use_delay;
 
-      if (use_delay == 0 && list_ == 0) {
+      if (use_delay == 0 && list_real_.empty()) {
 	    cur_real_ = bit;
 	    initial_ = false;
 	    net_->send_real(cur_real_, 0);
       } else {
-	    struct event_*cur = new struct event_(use_simtime);
-	    cur->run_run_ptr = &vvp_fun_delay::run_run_real_;
-	    cur->ptr_real = bit;
-	    enqueue_(cur);
-
-	    schedule_generic(this, use_delay, false);
+	    list_real_.push_back(use_simtime, bit);
+	    schedule_wake_(list_real_.front_time());
       }
 }
 
+/*
+ * Run the oldest pending transition if it is due, then make sure the
+ * next one, if any, has a scheduler event of its own. An event may
+ * also find nothing due, if the transition it was scheduled for was
+ * removed as a pulse.
+ */
 void vvp_fun_delay::run_run()
 {
       vvp_time64_t sim_time = schedule_simtime();
-      if (list_ == 0 || list_->next->sim_time > sim_time)
-	    return;
+      if (wake_set_ && wake_ <= sim_time)
+	    wake_set_ = false;
 
-      struct event_*cur = dequeue_();
-      if (cur == 0)
-	    return;
-
-      (this->*(cur->run_run_ptr))(cur);
-      initial_ = false;
-      delete cur;
-}
+      switch (type_) {
+	  case VEC4_DELAY:
+	    if (list_vec4_.empty())
+		  return;
+	    if (list_vec4_.front_time() <= sim_time) {
+		  cur_vec4_ = list_vec4_.front();
+		  list_vec4_.pop_front();
+		  initial_ = false;
+		  net_->send_vec4(cur_vec4_, 0);
+	    }
+	    if (! list_vec4_.empty())
+		  schedule_wake_(list_vec4_.front_time());
+	    break;
 
-void vvp_fun_delay::run_run_vec4_(struct event_*cur)
-{
-      cur_vec4_ = cur->ptr_vec4;
-      net_->send_vec4(cur_vec4_, 0);
-}
+	  case VEC8_DELAY:
+	    if (list_vec8_.empty())
+		  return;
+	    if (list_vec8_.front_time() <= sim_time) {
+		  cur_vec8_ = list_vec8_.front();
+		  list_vec8_.pop_front();
+		  initial_ = false;
+		  net_->send_vec8(cur_vec8_);
+	    }
+	    if (! list_vec8_.empty())
+		  schedule_wake_(list_vec8_.front_time());
+	    break;
 
-void vvp_fun_delay::run_run_vec8_(struct vvp_fun_delay::event_*cur)
-{
-      cur_vec8_ = cur->ptr_vec8;
-      net_->send_vec8(cur_vec8_);
-}
+	  case REAL_DELAY:
+	    if (list_real_.empty())
+		  return;
+	    if (list_real_.front_time() <= sim_time) {
+		  cur_real_ = list_real_.front();
+		  list_real_.pop_front();
+		  initial_ = false;
+		  net_->send_real(cur_real_, 0);
+	    }
+	    if (! list_real_.empty())
+		  schedule_wake_(list_real_.front_time());
+	    break;
 
-void vvp_fun_delay::run_run_real_(struct vvp_fun_delay::event_*cur)
-{
-      cur_real_ = cur->ptr_real;
-      net_->send_real(cur_real_, 0);
+	  case UNKNOWN_DELAY:
+	    break;
+      }
 }
 
 vvp_fun_modpath::vvp_fun_modpath(vvp_net_t*net, unsigned width)
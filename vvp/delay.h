@@ -59,6 +59,65 @@ class vvp_delay_t {
       void calculate_min_delay_();
 };
 
+/*
+ * A ring of pending (time, value) transitions, oldest first. It grows
+ * by doubling and never shrinks.
+ */
+template <class T> class vvp_delay_ring_t {
+
+    public:
+      vvp_delay_ring_t() : buf_(0), size_(0), head_(0), count_(0) { }
+      ~vvp_delay_ring_t() { delete[]buf_; }
+
+      bool empty() const { return count_ == 0; }
+
+      vvp_time64_t front_time() const { return buf_[head_].sim_time; }
+      const T& front() const { return buf_[head_].val; }
+
+      void push_back(vvp_time64_t sim_time, const T&val)
+      {
+	    if (count_ == size_) grow_();
+	    entry_&cur = buf_[(head_ + count_) & (size_-1)];
+	    cur.sim_time = sim_time;
+	    cur.val = val;
+	    count_ += 1;
+      }
+
+	// Remove the oldest entry. The value is cleared so that the
+	// ring does not hold on to the storage of wide vectors.
+      void pop_front()
+      {
+	    buf_[head_].val = T();
+	    head_ = (head_ + 1) & (size_-1);
+	    count_ -= 1;
+      }
+
+    private:
+      struct entry_ {
+	    vvp_time64_t sim_time;
+	    T val;
+      };
+
+      void grow_()
+      {
+	    unsigned new_size = size_? 2*size_ : 2;
+	    entry_*tmp = new entry_[new_size];
+	    for (unsigned idx = 0 ; idx < count_ ; idx += 1)
+		  tmp[idx] = buf_[(head_ + idx) & (size_-1)];
+	    delete[]buf_;
+	    buf_ = tmp;
+	    size_ = new_size;
+	    head_ = 0;
+      }
+
+      entry_*buf_;
+      unsigned size_, head_, count_;
+
+    private: // not implemented
+      vvp_delay_ring_t(const vvp_delay_ring_t&);
+      vvp_delay_ring_t& operator= (const vvp_delay_ring_t&);
+};
+
 /* vvp_fun_delay
  * This is a lighter weight version of vvp_fun_drive, that only
  * carries delays. The output that it propagates is vvp_vector4_t so
@@ -75,18 +134,6 @@ class vvp_delay_t {
 class vvp_fun_delay  : public vvp_net_fun_t, private vvp_gen_event_s {
 
       enum delay_type_t {UNKNOWN_DELAY, VEC4_DELAY, VEC8_DELAY, REAL_DELAY};
-      struct event_ {
-	    explicit event_(vvp_time64_t s) : sim_time(s) {
-		  ptr_real = 0.0;
-		  next = NULL;
-	    }
-	    void (vvp_fun_delay::*run_run_ptr)(struct vvp_fun_delay::event_*cur);
-	    const vvp_time64_t sim_time;
-	    vvp_vector4_t ptr_vec4;
-	    vvp_vector8_t ptr_vec8;
-	    double ptr_real;
-	    struct event_*next;
-      };
 
     public:
       vvp_fun_delay(vvp_net_t*net, unsigned width, const vvp_delay_t&d);
@@ -106,11 +153,6 @@ class vvp_fun_delay  : public vvp_net_fun_t, private vvp_gen_event_s {
     private:
       virtual void run_run();
 
-
-      void run_run_vec4_(struct vvp_fun_delay::event_*cur);
-      void run_run_vec8_(struct vvp_fun_delay::event_*cur);
-      void run_run_real_(struct vvp_fun_delay::event_*cur);
-
     private:
       vvp_net_t*net_;
       vvp_delay_t delay_;
@@ -122,34 +164,21 @@ class vvp_fun_delay  : public vvp_net_fun_t, private vvp_gen_event_s {
       double cur_real_;
       vvp_time64_t round_, scale_; // Needed to scale variable time values.
 
-      struct event_ *list_;
-      void enqueue_(struct event_*cur)
-      {
-	    if (list_) {
-		  cur->next = list_->next;
-		  list_->next = cur;
-		  list_ = cur;
-	    } else {
-		  cur->next = cur;
-		  list_ = cur;
-	    }
-      }
-      struct event_* dequeue_(void)
-      {
-	    if (list_ == 0)
-		  return 0;
-	    struct event_*cur = list_->next;
-	    if (list_ == cur)
-		  list_ = 0;
-	    else
-		  list_->next = cur->next;
-	    return cur;
-      }
-      bool clean_pulse_events_(vvp_time64_t use_delay, const vvp_vector4_t&bit);
-      bool clean_pulse_events_(vvp_time64_t use_delay, const vvp_vector8_t&bit);
-      bool clean_pulse_events_(vvp_time64_t use_delay, double bit);
-// Delete this when done!
-      void clean_pulse_events_(vvp_time64_t use_delay);
+	// The pending transitions. Only the ring for type_ is used.
+      vvp_delay_ring_t<vvp_vector4_t> list_vec4_;
+      vvp_delay_ring_t<vvp_vector8_t> list_vec8_;
+      vvp_delay_ring_t<double> list_real_;
+
+	// Only the oldest pending transition has an event in the
+	// scheduler. Running that event schedules the next one. The
+	// wake_ time is the earliest of those events still pending.
+      bool wake_set_;
+      vvp_time64_t wake_;
+      void schedule_wake_(vvp_time64_t sim_time);
+
+      template <class T>
+      bool clean_pulse_events_(vvp_delay_ring_t<T>&list,
+			       vvp_time64_t use_delay, const T&bit);
 };
 
 /*
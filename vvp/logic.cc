@@ -25,6 +25,11 @@
 # include  "delay.h"
 # include  "statistics.h"
 # include  <iostream>
+# include  <map>
+# include  <set>
+# include  <string>
+# include  <vector>
+# include  <climits>
 # include  <cstring>
 # include  <cassert>
 # include  <cstdlib>
@@ -609,6 +614,90 @@ void vvp_fun_xor::run_run()
       ptr->send_vec4(result, 0);
 }
 
+vvp_fun_lut::vvp_fun_lut(const char*table, unsigned ninputs)
+: table_(table), ninputs_(ninputs)
+{
+      assert(ninputs_ <= 4);
+      for (unsigned idx = 0 ;  idx < 4 ;  idx += 1)
+	    input_[idx] = BIT4_Z;
+      net_ = 0;
+      count_functors_logic += 1;
+}
+
+vvp_fun_lut::~vvp_fun_lut()
+{
+}
+
+void vvp_fun_lut::recv_vec4(vvp_net_ptr_t ptr, const vvp_vector4_t&bit,
+			    vvp_context_t)
+{
+      unsigned port = ptr.port();
+      if (port >= ninputs_)
+	    return;
+
+      vvp_bit4_t val = bit.size() > 0? bit.value(0) : BIT4_X;
+      if (input_[port] == val)
+	    return;
+
+      input_[port] = val;
+      if (net_ == 0) {
+	    net_ = ptr.ptr();
+	    schedule_functor(this);
+      }
+}
+
+void vvp_fun_lut::recv_vec4_pv(vvp_net_ptr_t ptr, const vvp_vector4_t&bit,
+			       unsigned base, unsigned vwid, vvp_context_t)
+{
+      assert(base + bit.size() <= vwid);
+      if (base != 0 || bit.size() == 0)
+	    return;
+
+      recv_vec4(ptr, bit, 0);
+}
+
+void vvp_fun_lut::run_run()
+{
+      vvp_net_t*ptr = net_;
+      net_ = 0;
+
+      unsigned entry = 0;
+      for (unsigned idx = ninputs_ ;  idx > 0 ;  idx -= 1) {
+	    entry *= 3;
+	    switch (input_[idx-1]) {
+		case BIT4_0:
+		  break;
+		case BIT4_1:
+		  entry += 1;
+		  break;
+		default:
+		  entry += 2;
+		  break;
+	    }
+      }
+
+      vvp_bit4_t out;
+      switch (table_[entry]) {
+	  case '0':
+	    out = BIT4_0;
+	    break;
+	  case '1':
+	    out = BIT4_1;
+	    break;
+	  default:
+	    out = BIT4_X;
+	    break;
+      }
+
+      ptr->send_vec4(vvp_vector4_t(1, out), 0);
+}
+
+/*
+ * These are the nets made by compile_functor whose functor is a
+ * vvp_leveled_event_s. They are the roots for compile_levelize.
+ */
+static std::vector<vvp_net_t*> leveled_nets;
+
 /*
  * The parser calls this function to create a logic functor. I allocate a
  * functor, and map the name to the vvp_ipoint_t address for the
@@ -712,6 +801,9 @@ void compile_functor(char*label, char*type, unsigned width,
       vvp_net_t*net = new vvp_net_t;
       net->fun = obj;
 
+      if (dynamic_cast<vvp_leveled_event_s*>(obj))
+	    leveled_nets.push_back(net);
+
       inputs_connect(net, argc, argv);
       free(argv);
 
@@ -734,3 +826,112 @@ void compile_functor(char*label, char*type, unsigned width,
       define_functor_symbol(label, net_drv);
       free(label);
 }
+
+/*
+ * Assign the levels with a depth first walk of the fan-out of every
+ * leveled net. The level of a net is the largest level of the nets it
+ * drives, plus one if the net itself is leveled. The walk is
+ * iterative because gate chains in real netlists are deep enough to
+ * blow the stack. A net that is reached again while it is still on the
+ * stack closes a loop, and that edge is ignored. This leaves loops
+ * with approximate levels, which only costs extra evaluations.
+ */
+void compile_levelize(void)
+{
+      static const unsigned LEVEL_BUSY = UINT_MAX;
+
+      struct frame_s {
+	    vvp_net_t*net;
+	    vvp_net_ptr_t cur;
+	    unsigned level;
+      };
+
+      std::map<vvp_net_t*,unsigned> levels;
+      std::vector<frame_s> stack;
+
+      for (size_t idx = 0 ; idx < leveled_nets.size() ; idx += 1) {
+	    vvp_net_t*root = leveled_nets[idx];
+	    if (levels.find(root) != levels.end())
+		  continue;
+
+	    levels[root] = LEVEL_BUSY;
+	    frame_s root_frame = { root, root->fanout(), 0 };
+	    stack.push_back(root_frame);
+
+	    while (! stack.empty()) {
+		  frame_s&top = stack.back();
+
+		  if (vvp_net_t*dst = top.cur.ptr()) {
+			top.cur = dst->port[top.cur.port()];
+
+			std::map<vvp_net_t*,unsigned>::iterator cur
+			      = levels.find(dst);
+			if (cur == levels.end()) {
+			      levels[dst] = LEVEL_BUSY;
+			      frame_s dst_frame = { dst, dst->fanout(), 0 };
+			      stack.push_back(dst_frame);
+			} else if (cur->second != LEVEL_BUSY
+				   && cur->second > top.level) {
+			      top.level = cur->second;
+			}
+			continue;
+		  }
+
+		  vvp_net_t*net = top.net;
+		  unsigned level = top.level;
+		  stack.pop_back();
+
+		  if (vvp_leveled_event_s*lev
+		      = dynamic_cast<vvp_leveled_event_s*>(net->fun)) {
+			level += 1;
+			lev->level = level;
+		  }
+		  levels[net] = level;
+
+		  if (! stack.empty() && stack.back().level < level)
+			stack.back().level = level;
+	    }
+      }
+
+      std::vector<vvp_net_t*>().swap(leveled_nets);
+}
+
+/*
+ * The tables of the LUT functors are shared, since a design tends to
+ * have many copies of the same few functions.
+ */
+static std::set<std::string> lut_tables;
+
+void compile_functor_lut(char*label, char*type, unsigned width,
+			 char*table, unsigned argc, struct symb_s*argv)
+{
+      size_t ntable = 1;
+      for (unsigned idx = 0 ;  idx < argc ;  idx += 1)
+	    ntable *= 3;
+
+      if (strcmp(type, "LUT") != 0 || width != 1 || argc > 4
+	  || strlen(table) != ntable
+	  || strspn(table, "01x") != ntable) {
+	    yyerror("invalid LUT functor.");
+	    free(table);
+	    free(type);
+	    free(argv);
+	    free(label);
+	    return;
+      }
+
+      const std::string&shared = *lut_tables.insert(table).first;
+      free(table);
+      free(type);
+
+      vvp_fun_lut*obj = new vvp_fun_lut(shared.c_str(), argc);
+      vvp_net_t*net = new vvp_net_t;
+      net->fun = obj;
+      leveled_nets.push_back(net);
+
+      inputs_connect(net, argc, argv);
+      free(argv);
+
+      define_functor_symbol(label, net);
+      free(label);
+}
@@ -25,8 +25,12 @@
 
 /*
  * vvp_fun_boolean_ is just a common hook for holding operands.
+ *
+ * The zero-delay logic functors in this file are leveled (see
+ * vvp_leveled_event_s) so that their deferred evaluation happens in
+ * topological order within a delta.
  */
-class vvp_fun_boolean_ : public vvp_net_fun_t, protected vvp_gen_event_s {
+class vvp_fun_boolean_ : public vvp_net_fun_t, public vvp_leveled_event_s {
 
     public:
       explicit vvp_fun_boolean_(unsigned wid);
@@ -79,7 +83,7 @@ class vvp_fun_impl : public vvp_fun_boolean_ {
  * The retransmitted vector has all Z values changed to X, just like
  * the buf(Q,D) gate in Verilog.
  */
-class vvp_fun_buf: public vvp_net_fun_t, private vvp_gen_event_s {
+class vvp_fun_buf: public vvp_net_fun_t, public vvp_leveled_event_s {
 
     public:
       explicit vvp_fun_buf(unsigned wid);
@@ -143,7 +147,7 @@ enum sel_type {SEL_PORT0, SEL_PORT1, SEL_BOTH};
  * input (port-0 or port-1) to enter the device. The narrow vector is
  * padded with X values.
  */
-class vvp_fun_muxz : public vvp_net_fun_t, private vvp_gen_event_s {
+class vvp_fun_muxz : public vvp_net_fun_t, public vvp_leveled_event_s {
 
     public:
       explicit vvp_fun_muxz(unsigned width);
@@ -165,7 +169,7 @@ class vvp_fun_muxz : public vvp_net_fun_t, private vvp_gen_event_s {
       bool has_run_;
 };
 
-class vvp_fun_muxr : public vvp_net_fun_t, private vvp_gen_event_s {
+class vvp_fun_muxr : public vvp_net_fun_t, public vvp_leveled_event_s {
 
     public:
       explicit vvp_fun_muxr();
@@ -186,7 +190,7 @@ class vvp_fun_muxr : public vvp_net_fun_t, private vvp_gen_event_s {
       sel_type select_;
 };
 
-class vvp_fun_not: public vvp_net_fun_t, private vvp_gen_event_s {
+class vvp_fun_not: public vvp_net_fun_t, public vvp_leveled_event_s {
 
     public:
       explicit vvp_fun_not(unsigned wid);
@@ -205,6 +209,34 @@ class vvp_fun_not: public vvp_net_fun_t, private vvp_gen_event_s {
       vvp_net_t*net_;
 };
 
+/*
+ * The LUT functor is a single bit function of up to 4 single bit
+ * inputs, given as a truth table. The code generator uses it to
+ * replace a cone of simple gates. Z inputs are treated as X, like the
+ * gates that it replaces.
+ */
+class vvp_fun_lut : public vvp_net_fun_t, public vvp_leveled_event_s {
+
+    public:
+      vvp_fun_lut(const char*table, unsigned ninputs);
+      virtual ~vvp_fun_lut();
+
+      void recv_vec4(vvp_net_ptr_t p, const vvp_vector4_t&bit,
+                     vvp_context_t);
+      void recv_vec4_pv(vvp_net_ptr_t p, const vvp_vector4_t&bit,
+			unsigned base, unsigned vwid, vvp_context_t);
+
+    private:
+      void run_run();
+
+    private:
+	// The table is shared by all the LUTs with the same function.
+      const char*table_;
+      unsigned ninputs_;
+      vvp_bit4_t input_[4];
+      vvp_net_t*net_;
+};
+
 class vvp_fun_or  : public vvp_fun_boolean_ {
 
     public:
@@ -31,6 +31,7 @@ const char COPYRIGHT[] =
 # include  <cstdlib>
 # include  <cstring>
 # include  <unistd.h>
+# include  <sys/stat.h>
 # include  <cassert>
 #ifdef CHECK_WITH_VALGRIND
 # include  <pthread.h>
@@ -202,8 +203,13 @@ void set_delay_selection(const char* sel)
       delete[] sel;
 }
 
+extern void vpip_mcd_async_finish(void);
+
 static void final_cleanup()
 {
+	/* Write out the files that the -b flag buffers. */
+      vpip_mcd_async_finish();
+
       vvp_object::cleanup();
 
 	/*
@@ -264,6 +270,7 @@ int main(int argc, char*argv[])
       FILE *logfile = 0x0;
       extern void vpi_set_vlog_info(int, char**);
       extern bool stop_is_finish;
+      extern bool vpip_mcd_async;
       extern int  stop_is_finish_exit_code;
 
       if( ::getenv("VVP_WAIT_FOR_DEBUGGER") != 0 ) {
@@ -282,11 +289,12 @@ int main(int argc, char*argv[])
         /* For non-interactive runs we do not want to run the interactive
          * debugger, so make $stop just execute a $finish. */
       stop_is_finish = false;
-      while ((opt = getopt(argc, argv, "+hil:M:m:nNsvV")) != EOF) switch (opt) {
+      while ((opt = getopt(argc, argv, "+bhil:M:m:nNsvV")) != EOF) switch (opt) {
          case 'h':
            fprintf(stderr,
                    "Usage: vvp [options] input-file [+plusargs...]\n"
                    "Options:\n"
+                   " -b             Buffer $fopen output, write it in the background.\n"
                    " -h             Print this help message.\n"
                    " -i             Interactive mode (unbuffered stdio).\n"
                    " -l file        Logfile, '-' for <stderr>\n"
@@ -299,6 +307,9 @@ int main(int argc, char*argv[])
                    " -v             Verbose progress messages.\n"
                    " -V             Print the version information.\n" );
            exit(0);
+	  case 'b':
+	    vpip_mcd_async = true;
+	    break;
 	  case 'i':
 	    setvbuf(stdout, 0, _IONBF, 0);
 	    break;
@@ -405,7 +416,11 @@ int main(int argc, char*argv[])
 	/* Make the extended arguments available to the simulation. */
       vpi_set_vlog_info(argc-optind, argv+optind);
 
-      compile_init();
+      struct stat design_stat;
+      if (stat(design_path, &design_stat) == 0 && S_ISREG(design_stat.st_mode))
+	    compile_init(design_stat.st_size);
+      else
+	    compile_init();
 
       for (unsigned idx = 0 ;  idx < module_cnt ;  idx += 1)
 	    vpip_load_module(module_tab[idx]);
@@ -477,8 +492,14 @@ int main(int argc, char*argv[])
 			   count_time_events, count_time_pool());
 	    vpi_mcd_printf(1, "    %8lu thread schedule events\n",
 		    count_thread_events);
+	    vpi_mcd_printf(1, "             ...%lu event wakeups of %lu threads\n",
+			   count_thread_batches, count_thread_batched);
+	    vpi_mcd_printf(1, "    %8lu threads created (pool=%lu)\n",
+			   count_thread_creates, count_thread_pool());
 	    vpi_mcd_printf(1, "    %8lu assign events\n",
 		    count_assign_events);
+	    vpi_mcd_printf(1, "             ...%lu merged into pending events\n",
+			   count_assign_merged);
 	    vpi_mcd_printf(1, "             ...assign(vec4) pool=%lu\n",
 			   count_assign4_pool());
 	    vpi_mcd_printf(1, "             ...assign(vec8) pool=%lu\n",
@@ -491,6 +512,8 @@ int main(int argc, char*argv[])
 			   count_assign_arword_pool());
 	    vpi_mcd_printf(1, "    %8lu other events (pool=%lu)\n",
 			   count_gen_events, count_gen_pool());
+	    vpi_mcd_printf(1, "    %8lu leveled functor evaluations\n",
+			   count_leveled_events);
       }
 
       final_cleanup();
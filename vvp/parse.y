@@ -31,11 +31,6 @@
 
 using namespace std;
 
-/*
- * These are bits in the lexor.
- */
-extern FILE*yyin;
-
 vector <const char*> file_names;
 
 /*
@@ -194,6 +189,9 @@ statement
 	: T_LABEL K_FUNCTOR T_SYMBOL T_NUMBER ',' symbols ';'
 		{ compile_functor($1, $3, $4, 6, 6, $6.cnt, $6.vect); }
 
+	| T_LABEL K_FUNCTOR T_SYMBOL T_NUMBER ',' T_STRING ',' symbols ';'
+		{ compile_functor_lut($1, $3, $4, $6, $8.cnt, $8.vect); }
+
 	| T_LABEL K_FUNCTOR T_SYMBOL T_NUMBER
 	          '[' T_NUMBER T_NUMBER ']' ',' symbols ';'
 		{ unsigned str0 = $6;
@@ -1243,13 +1241,12 @@ int compile_design(const char*path)
 {
       yypath = path;
       yyline = 1;
-      yyin = fopen(path, "r");
-      if (yyin == 0) {
+      if (! lexor_open(path)) {
 	    fprintf(stderr, "%s: Unable to open input file.\n", path);
 	    return -1;
       }
 
       int rc = yyparse();
-      fclose(yyin);
+      lexor_close();
       return rc;
 }
@@ -46,6 +46,13 @@ extern void yyerror(const char*msg);
 
 extern void destroy_lexor();
 
+/*
+ * Open and close the design file that the lexor reads. The file may
+ * be gzip compressed.
+ */
+extern bool lexor_open(const char*path);
+extern void lexor_close();
+
 /*
  * This is the path of the current source file.
  */
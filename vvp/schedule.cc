@@ -25,6 +25,8 @@
 # include  "slab.h"
 # include  "compile.h"
 # include  <new>
+# include  <queue>
+# include  <vector>
 # include  <typeinfo>
 # include  <csignal>
 # include  <cstdlib>
@@ -38,8 +40,13 @@
 using namespace std;
 
 unsigned long count_assign_events = 0;
+unsigned long count_assign_merged = 0;
 unsigned long count_gen_events = 0;
+unsigned long count_leveled_events = 0;
 unsigned long count_thread_events = 0;
+  // Count the event wakeups and the threads they woke
+unsigned long count_thread_batches = 0;
+unsigned long count_thread_batched = 0;
   // Count the time events (A time cell created)
 unsigned long count_time_events = 0;
 
@@ -111,6 +118,66 @@ void vvp_gen_event_s::single_step_display(void)
       cerr << "vvp_gen_event_s: Step into event " << typeid(*this).name() << endl;
 }
 
+/*
+ * A non-blocking assignment to the same target as the assignment at
+ * the tail of the nbassign list is dropped if that assignment already
+ * writes every bit it writes, with the same value. The later
+ * assignment would run right after the earlier one and change
+ * nothing, so nothing can tell that it is gone. Any other pair of
+ * assignments is kept apart, even if they write different bits,
+ * because the value the target has between them can be seen (for
+ * example by a net that decodes the target). The target is the
+ * functor input of a variable, or an array and a word address.
+ */
+
+/*
+ * The value of a vector assignment. If vwid is 0, val replaces the
+ * entire target. Otherwise val is written at base into a target that
+ * is vwid bits wide.
+ */
+struct nba_vec4_s {
+      explicit nba_vec4_s(const vvp_vector4_t&that) : val(that) {
+	    base = 0;
+	    vwid = 0;
+      }
+
+	/* Value to assign. */
+      vvp_vector4_t val;
+	/* Offset of the part into the destination. */
+      unsigned base;
+	/* Width of the destination vector. */
+      unsigned vwid;
+
+	// Return true if this assignment writes every bit that the
+	// given assignment writes, with the same value.
+      bool covers(unsigned base, unsigned vwid, const vvp_vector4_t&val) const;
+};
+
+bool nba_vec4_s::covers(unsigned nbase, unsigned nvwid,
+			const vvp_vector4_t&nval) const
+{
+      if (nvwid != vwid)
+	    return false;
+
+      unsigned nwid = nval.size();
+      if (vwid == 0) {
+	    nbase = 0;
+	    if (nwid != val.size())
+		  return false;
+      }
+
+      if (nbase < base || nbase-base > val.size()
+	  || nwid > val.size() - (nbase-base))
+	    return false;
+
+      for (unsigned idx = 0 ; idx < nwid ; idx += 1) {
+	    if (val.value(nbase-base+idx) != nval.value(idx))
+		  return false;
+      }
+
+      return true;
+}
+
 /*
  * Derived event types
  */
@@ -169,21 +236,13 @@ void del_thr_event_s::single_step_display(void)
 	   << " scope=" << scope->vpi_get_str(vpiFullName) << endl;
 }
 
-struct assign_vector4_event_s  : public event_s {
+struct assign_vector4_event_s  : public event_s, public nba_vec4_s {
 	/* The default constructor. */
-      explicit assign_vector4_event_s(const vvp_vector4_t&that) : val(that) {
-	    base = 0;
-	    vwid = 0;
-      }
+      explicit assign_vector4_event_s(const vvp_vector4_t&that)
+      : nba_vec4_s(that) { }
 
 	/* Where to do the assign. */
       vvp_net_ptr_t ptr;
-	/* Value to assign. */
-      vvp_vector4_t val;
-	/* Offset of the part into the destination. */
-      unsigned base;
-	/* Width of the destination vector. */
-      unsigned vwid;
       void run_run(void);
       void single_step_display(void);
 
@@ -296,11 +355,12 @@ void assign_real_event_s::operator delete(void*dptr)
 
 unsigned long count_assign_real_pool(void) { return assignr_heap.pool; }
 
-struct assign_array_word_s  : public event_s {
+struct assign_array_word_s  : public event_s, public nba_vec4_s {
+      explicit assign_array_word_s(const vvp_vector4_t&that)
+      : nba_vec4_s(that) { }
+
       vvp_array_t mem;
       unsigned adr;
-      vvp_vector4_t val;
-      unsigned off;
       void run_run(void);
 
       static void* operator new(size_t);
@@ -310,7 +370,7 @@ struct assign_array_word_s  : public event_s {
 void assign_array_word_s::run_run(void)
 {
       count_assign_events += 1;
-      mem->set_word(adr, off, val);
+      mem->set_word(adr, base, val);
 }
 
 static const size_t ARRAY_W_CHUNK_COUNT = 8192 / sizeof(struct assign_array_word_s);
@@ -674,18 +734,11 @@ static void schedule_final_event(struct event_s*cur)
 }
 
 /*
- * This function does all the hard work of putting an event into the
- * event queue. The event delay is taken from the event structure
- * itself, and the structure is placed in the right place in the
- * queue.
+ * This function does all the hard work of finding the event_time
+ * object for an event that is delay from now, creating it if needed.
  */
-typedef enum event_queue_e { SEQ_START, SEQ_ACTIVE, SEQ_INACTIVE, SEQ_NBASSIGN,
-			     SEQ_RWSYNC, SEQ_ROSYNC, DEL_THREAD } event_queue_t;
-
-static void schedule_event_(struct event_s*cur, vvp_time64_t delay,
-			    event_queue_t select_queue)
+static struct event_time_s* schedule_time_(vvp_time64_t delay)
 {
-      cur->next = cur;
       struct event_time_s*ctim = sched_list;
 
       if (sched_list == 0) {
@@ -738,10 +791,20 @@ static void schedule_event_(struct event_s*cur, vvp_time64_t delay,
 	    }
       }
 
-	/* By this point, ctim is the event_time structure that is to
-	   receive the event at hand. Put the event in to the
-	   appropriate list for the kind of assign we have at hand. */
+      return ctim;
+}
+
+/*
+ * Put the event into the list for the selected queue of the
+ * event_time structure ctim.
+ */
+typedef enum event_queue_e { SEQ_START, SEQ_ACTIVE, SEQ_INACTIVE, SEQ_NBASSIGN,
+			     SEQ_RWSYNC, SEQ_ROSYNC, DEL_THREAD } event_queue_t;
 
+static void schedule_event_at_(struct event_s*cur, struct event_time_s*ctim,
+			       event_queue_t select_queue)
+{
+      cur->next = cur;
       struct event_s** q = 0;
 
       switch (select_queue) {
@@ -754,7 +817,6 @@ static void schedule_event_(struct event_s*cur, vvp_time64_t delay,
 	    break;
 
 	  case SEQ_INACTIVE:
-	    assert(delay == 0);
 	    q = &ctim->inactive;
 	    break;
 
@@ -785,6 +847,16 @@ static void schedule_event_(struct event_s*cur, vvp_time64_t delay,
       }
 }
 
+/*
+ * Put an event into the event queue, delay from now.
+ */
+static void schedule_event_(struct event_s*cur, vvp_time64_t delay,
+			    event_queue_t select_queue)
+{
+      assert(select_queue != SEQ_INACTIVE || delay == 0);
+      schedule_event_at_(cur, schedule_time_(delay), select_queue);
+}
+
 static void schedule_event_push_(struct event_s*cur)
 {
       if ((sched_list == 0) || (sched_list->delay > 0)) {
@@ -823,6 +895,14 @@ void schedule_vthread(vthread_t thr, vvp_time64_t delay, bool push_flag)
       }
 }
 
+void schedule_vthread_list(vthread_t thr)
+{
+      struct vthread_event_s*cur = new vthread_event_s;
+
+      cur->thr = thr;
+      schedule_event_(cur, 0, SEQ_ACTIVE);
+}
+
 void schedule_t0_trigger(vvp_net_ptr_t ptr)
 {
       vvp_vector4_t bit (1, BIT4_X);
@@ -865,11 +945,20 @@ void schedule_assign_vector(vvp_net_ptr_t ptr,
 			    const vvp_vector4_t&bit,
 			    vvp_time64_t delay)
 {
-      struct assign_vector4_event_s*cur = new struct assign_vector4_event_s(bit);
+      struct event_time_s*ctim = schedule_time_(delay);
+
+      struct assign_vector4_event_s*cur
+	    = dynamic_cast<assign_vector4_event_s*>(ctim->nbassign);
+      if (cur && cur->ptr == ptr && cur->covers(base, vwid, bit)) {
+	    count_assign_merged += 1;
+	    return;
+      }
+
+      cur = new struct assign_vector4_event_s(bit);
       cur->ptr = ptr;
       cur->base = base;
       cur->vwid = vwid;
-      schedule_event_(cur, delay, SEQ_NBASSIGN);
+      schedule_event_at_(cur, ctim, SEQ_NBASSIGN);
 }
 
 void schedule_force_vector(vvp_net_t*net,
@@ -913,12 +1002,23 @@ void schedule_assign_array_word(vvp_array_t mem,
 				const vvp_vector4_t&val,
 				vvp_time64_t delay)
 {
-      struct assign_array_word_s*cur = new struct assign_array_word_s;
+      struct event_time_s*ctim = schedule_time_(delay);
+      unsigned wid = mem->get_word_size();
+
+      struct assign_array_word_s*cur
+	    = dynamic_cast<assign_array_word_s*>(ctim->nbassign);
+      if (cur && cur->mem == mem && cur->adr == word_addr
+	  && cur->covers(off, wid, val)) {
+	    count_assign_merged += 1;
+	    return;
+      }
+
+      cur = new struct assign_array_word_s(val);
       cur->mem = mem;
       cur->adr = word_addr;
-      cur->off = off;
-      cur->val = val;
-      schedule_event_(cur, delay, SEQ_NBASSIGN);
+      cur->base = off;
+      cur->vwid = wid;
+      schedule_event_at_(cur, ctim, SEQ_NBASSIGN);
 }
 
 void schedule_assign_array_word(vvp_array_t mem,
@@ -926,11 +1026,21 @@ void schedule_assign_array_word(vvp_array_t mem,
 				double val,
 				vvp_time64_t delay)
 {
-      struct assign_array_r_word_s*cur = new struct assign_array_r_word_s;
+      struct event_time_s*ctim = schedule_time_(delay);
+
+	/* A repeated write of the same value changes nothing. */
+      struct assign_array_r_word_s*cur
+	    = dynamic_cast<assign_array_r_word_s*>(ctim->nbassign);
+      if (cur && cur->mem == mem && cur->adr == word_addr && cur->val == val) {
+	    count_assign_merged += 1;
+	    return;
+      }
+
+      cur = new struct assign_array_r_word_s;
       cur->mem = mem;
       cur->adr = word_addr;
       cur->val = val;
-      schedule_event_(cur, delay, SEQ_NBASSIGN);
+      schedule_event_at_(cur, ctim, SEQ_NBASSIGN);
 }
 
 void schedule_set_vector(vvp_net_ptr_t ptr, const vvp_vector4_t&bit)
@@ -1036,6 +1146,68 @@ void schedule_functor(vvp_gen_event_t obj)
       }
 }
 
+/*
+ * Leveled functors that are dirty in the current time step wait in
+ * this queue, highest level first. A single leveled_drain_event_s in
+ * the active queue evaluates them all, so there is at most one active
+ * event for the whole queue no matter how many functors it holds.
+ */
+struct leveled_event_less {
+      bool operator() (const vvp_leveled_event_s*a,
+		       const vvp_leveled_event_s*b) const
+      { return a->level < b->level; }
+};
+
+static std::priority_queue<vvp_leveled_event_s*,
+			   std::vector<vvp_leveled_event_s*>,
+			   leveled_event_less> leveled_queue;
+static bool leveled_drain_pending = false;
+
+struct leveled_drain_event_s : public event_s {
+      void run_run(void);
+      void single_step_display(void);
+};
+
+void leveled_drain_event_s::run_run(void)
+{
+      while (! leveled_queue.empty()) {
+	      /* A zero-delay loop can keep the queue busy forever, so
+		 give a pending $stop (or ^C) a chance to run. The rest
+		 of the queue is picked up by a new drain event. */
+	    if (schedule_stopped_flag) {
+		  schedule_event_(new leveled_drain_event_s, 0, SEQ_ACTIVE);
+		  return;
+	    }
+
+	    vvp_leveled_event_s*cur = leveled_queue.top();
+	    leveled_queue.pop();
+	    count_leveled_events += 1;
+	    cur->run_run();
+      }
+
+      leveled_drain_pending = false;
+}
+
+void leveled_drain_event_s::single_step_display(void)
+{
+      cerr << "leveled_drain_event: Evaluate " << leveled_queue.size()
+	   << " leveled functors" << endl;
+}
+
+void schedule_functor(vvp_leveled_event_s*obj)
+{
+      if (obj->level == 0 || !sim_started) {
+	    schedule_functor(static_cast<vvp_gen_event_t>(obj));
+	    return;
+      }
+
+      leveled_queue.push(obj);
+      if (! leveled_drain_pending) {
+	    leveled_drain_pending = true;
+	    schedule_event_(new leveled_drain_event_s, 0, SEQ_ACTIVE);
+      }
+}
+
 void schedule_at_start_of_simtime(vvp_gen_event_t obj, vvp_time64_t delay)
 {
       struct generic_event_s*cur = new generic_event_s;
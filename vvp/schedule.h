@@ -35,6 +35,14 @@
 extern void schedule_vthread(vthread_t thr, vvp_time64_t delay,
 			     bool push_flag =false);
 
+/*
+ * Schedule a list of threads, chained through their wait_next
+ * pointers, as a single event in the active queue. The threads run
+ * back to back when the event runs. The caller has already marked
+ * every thread in the list as scheduled.
+ */
+extern void schedule_vthread_list(vthread_t thr);
+
 extern void schedule_inactive(vthread_t thr);
 
 extern void schedule_init_vthread(vthread_t thr);
@@ -166,6 +174,30 @@ struct vvp_gen_event_s
       virtual void single_step_display(void);
 };
 
+/*
+ * Zero-delay combinational functors that evaluate through
+ * schedule_functor can derive from this instead of vvp_gen_event_s
+ * to take part in static levelization. The level is assigned by
+ * compile_levelize() after the netlist is linked, and is the length
+ * of the longest chain of leveled functors that this functor drives
+ * (itself included). A level of 0 means the functor was not leveled.
+ *
+ * Leveled functors that become dirty during simulation are collected
+ * in a queue ordered by level and evaluated from a single active
+ * event, highest level first. A functor is therefore evaluated after
+ * everything upstream of it has settled, and reconvergent fanout does
+ * not cause it to be evaluated (and glitch) several times in a
+ * delta. The level is only an ordering hint: a stale or approximate
+ * level (e.g. in a combinational loop) costs extra evaluations, but
+ * never loses one.
+ */
+struct vvp_leveled_event_s : public vvp_gen_event_s {
+      vvp_leveled_event_s() : level(0) { }
+      unsigned level;
+};
+
+extern void schedule_functor(vvp_leveled_event_s*obj);
+
 /*
  * This runs the simulator. It runs until all the functors run out or
  * the simulation is otherwise finished.
@@ -212,8 +244,11 @@ extern void stop_handler(int rc);
  */
 extern unsigned long count_assign_events;
 extern unsigned long count_gen_events;
+extern unsigned long count_leveled_events;
 extern unsigned long count_prop_events;
 extern unsigned long count_thread_events;
+extern unsigned long count_thread_batches;
+extern unsigned long count_thread_batched;
 extern unsigned long count_event_pool;
 
 #endif /* IVL_schedule_H */
@@ -49,6 +49,7 @@ extern unsigned long count_time_events;
 extern unsigned long count_time_pool(void);
 
 extern unsigned long count_assign_events;
+extern unsigned long count_assign_merged;
 extern unsigned long count_assign4_pool(void);
 extern unsigned long count_assign8_pool(void);
 extern unsigned long count_assign_real_pool(void);
@@ -56,8 +57,12 @@ extern unsigned long count_assign_aword_pool(void);
 extern unsigned long count_assign_arword_pool(void);
 
 extern unsigned long count_gen_events;
+extern unsigned long count_leveled_events;
 extern unsigned long count_gen_pool(void);
 
+extern unsigned long count_thread_creates;
+extern unsigned long count_thread_pool(void);
+
 extern size_t size_opcodes;
 extern size_t size_vvp_nets;
 extern size_t size_vvp_net_funs;
@@ -55,7 +55,10 @@ typedef struct symbol_value_s {
 
 class symbol_table_s {
     public:
-      explicit symbol_table_s();
+	// The size_hint is the number of keys the table is expected
+	// to hold. The table grows as needed, so this is only to save
+	// the work of growing a table that is known to get large.
+      explicit symbol_table_s(size_t size_hint =0);
       virtual ~symbol_table_s();
 
 	// This method locates the value in the symbol table and sets its
@@ -67,14 +70,23 @@ class symbol_table_s {
 	// zero and return the zero value.
       symbol_value_t sym_get_value(const char*key);
 
+	// This method locates the value in the symbol table and returns
+	// it, or a zero value if the key does not exist. It does not
+	// change the table, so it is safe to call from several threads
+	// as long as no thread is adding keys at the same time.
+      symbol_value_t sym_find_value(const char*key) const;
+
     private:
       symbol_table_s(const symbol_table_s&) { assert(0); };
-      struct tree_node_*root;
+      struct symbol_entry_*table_;
+      size_t mask_;
+      size_t count_;
       struct key_strings*str_chunk;
       unsigned str_used;
 
-      symbol_value_t find_value_(struct tree_node_*cur,
-				 const char*key, symbol_value_t val,
+      size_t find_slot_(const char*key, size_t hash) const;
+      void grow_(void);
+      symbol_value_t find_value_(const char*key, symbol_value_t val,
 				 bool force_flag);
       char*key_strdup_(const char*str);
 };
@@ -86,7 +98,8 @@ class symbol_table_s {
  * the delete_symbol_table method will delete the table, including all
  * the space for the keys.
  */
-inline symbol_table_t new_symbol_table(void) { return new symbol_table_s; }
+inline symbol_table_t new_symbol_table(size_t size_hint =0)
+{ return new symbol_table_s(size_hint); }
 inline void delete_symbol_table(symbol_table_t tbl) { delete tbl; }
 
 // These are obsolete, and here only to support older code.
@@ -96,6 +109,9 @@ inline void sym_set_value(symbol_table_t tbl, const char*key, symbol_value_t val
 inline symbol_value_t sym_get_value(symbol_table_t tbl, const char*key)
 { return tbl->sym_get_value(key); }
 
+inline symbol_value_t sym_find_value(symbol_table_t tbl, const char*key)
+{ return tbl->sym_find_value(key); }
+
 /*
  * This template is a type-safe interface to the symbol table.
  */
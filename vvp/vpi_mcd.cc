@@ -27,10 +27,217 @@
 # include  <cstdio>
 # include  <cstdlib>
 # include  <cstring>
+# include  <deque>
+# include  <string>
+# include  <unistd.h>
+#ifdef HAVE_LIBPTHREAD
+# include  <pthread.h>
+#endif
+#ifdef HAVE_LIBZ
+# include  <zlib.h>
+#endif
 # include  "ivl_alloc.h"
 
 extern FILE* vpi_trace;
 
+/*
+ * The -b flag turns on the asynchronous output mode. In this mode the
+ * files that $fopen opens as MCD channels collect their output in
+ * large buffers. A background thread writes the full buffers, so the
+ * simulation does not wait for write(2). A $fflush of such a channel,
+ * $fclose and the end of the simulation block until everything written
+ * to the channel is in the file, so a test bench can still flush a
+ * file and then read it back. A $fflush is therefore not cheap in this
+ * mode, and a test bench that only wants its output in order should
+ * not call it. Channels whose file name ends in ".gz"
+ * are gzip compressed as they are written.
+ *
+ * The output of each channel stays in order. The standard output
+ * channel (mcd bit 0) and its copy in the log file are never buffered
+ * this way, so they stay in order with each other and with vpi_printf.
+ * File descriptors are FILE pointers that other system tasks read,
+ * seek and write directly, so they only get a larger stdio buffer
+ * when they are opened for writing only.
+ */
+bool vpip_mcd_async = false;
+
+static const size_t MCD_ASYNC_BUF_SIZE = 1024*1024;
+
+struct mcd_async_s {
+      FILE*fp;
+#ifdef HAVE_LIBZ
+      gzFile gz;
+#endif
+      std::string fill;
+};
+
+struct mcd_async_job_s {
+      struct mcd_async_s*file;
+      std::string*data;
+	// Flush the stream after writing, for $fflush.
+      bool flush;
+};
+
+static void mcd_async_write_job(const mcd_async_job_s&job)
+{
+#ifdef HAVE_LIBZ
+      if (job.file->gz) {
+	    if (! job.data->empty())
+		  gzwrite(job.file->gz, job.data->data(), job.data->size());
+	    if (job.flush)
+		  gzflush(job.file->gz, Z_SYNC_FLUSH);
+	    delete job.data;
+	    return;
+      }
+#endif
+      if (! job.data->empty())
+	    fwrite(job.data->data(), 1, job.data->size(), job.file->fp);
+      if (job.flush)
+	    fflush(job.file->fp);
+      delete job.data;
+}
+
+#ifdef HAVE_LIBPTHREAD
+static pthread_mutex_t mcd_async_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t mcd_async_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t mcd_async_idle = PTHREAD_COND_INITIALIZER;
+static std::deque<mcd_async_job_s> mcd_async_queue;
+static bool mcd_async_busy = false;
+static bool mcd_async_started = false;
+static bool mcd_async_stop = false;
+static pthread_t mcd_async_writer;
+
+static void* mcd_async_thread(void*)
+{
+      pthread_mutex_lock(&mcd_async_lock);
+      for (;;) {
+	    while (mcd_async_queue.empty() && !mcd_async_stop)
+		  pthread_cond_wait(&mcd_async_work, &mcd_async_lock);
+	    if (mcd_async_queue.empty())
+		  break;
+
+	    mcd_async_job_s job = mcd_async_queue.front();
+	    mcd_async_queue.pop_front();
+	    mcd_async_busy = true;
+	    pthread_mutex_unlock(&mcd_async_lock);
+
+	    mcd_async_write_job(job);
+
+	    pthread_mutex_lock(&mcd_async_lock);
+	    mcd_async_busy = false;
+	    if (mcd_async_queue.empty())
+		  pthread_cond_broadcast(&mcd_async_idle);
+      }
+      pthread_mutex_unlock(&mcd_async_lock);
+      return 0;
+}
+#endif
+
+/*
+ * Pass the buffered output of the file to the writer. If flush is
+ * true, the writer also flushes the file stream.
+ */
+static void mcd_async_submit(struct mcd_async_s*file, bool flush)
+{
+      if (file->fill.empty() && !flush)
+	    return;
+
+      mcd_async_job_s job;
+      job.file = file;
+      job.data = new std::string;
+      job.data->swap(file->fill);
+      job.flush = flush;
+      file->fill.reserve(MCD_ASYNC_BUF_SIZE);
+
+#ifdef HAVE_LIBPTHREAD
+      if (mcd_async_started) {
+	    pthread_mutex_lock(&mcd_async_lock);
+	    mcd_async_queue.push_back(job);
+	    pthread_cond_signal(&mcd_async_work);
+	    pthread_mutex_unlock(&mcd_async_lock);
+	    return;
+      }
+#endif
+	// Without a writer thread, at least write in large blocks.
+      mcd_async_write_job(job);
+}
+
+/*
+ * Wait until the writer has written everything passed to it.
+ */
+static void mcd_async_wait(void)
+{
+#ifdef HAVE_LIBPTHREAD
+      if (! mcd_async_started)
+	    return;
+
+      pthread_mutex_lock(&mcd_async_lock);
+      while (!mcd_async_queue.empty() || mcd_async_busy)
+	    pthread_cond_wait(&mcd_async_idle, &mcd_async_lock);
+      pthread_mutex_unlock(&mcd_async_lock);
+#endif
+}
+
+static void mcd_async_write(struct mcd_async_s*file, const char*buf, size_t cnt)
+{
+      file->fill.append(buf, cnt);
+      if (file->fill.size() >= MCD_ASYNC_BUF_SIZE)
+	    mcd_async_submit(file, false);
+}
+
+static int mcd_async_close(struct mcd_async_s*file)
+{
+      int rc = 0;
+      mcd_async_submit(file, false);
+      mcd_async_wait();
+#ifdef HAVE_LIBZ
+      if (file->gz && gzclose(file->gz) != Z_OK)
+	    rc = EOF;
+#endif
+      if (fclose(file->fp))
+	    rc = EOF;
+      delete file;
+      return rc;
+}
+
+void vpip_mcd_async_finish(void);
+
+static struct mcd_async_s* mcd_async_open(FILE*fp, const char*name)
+{
+	// final_cleanup writes out the buffers, but a call to exit()
+	// in the middle of the simulation does not get there.
+      static bool finish_at_exit = false;
+      if (! finish_at_exit) {
+	    atexit(vpip_mcd_async_finish);
+	    finish_at_exit = true;
+      }
+
+#ifdef HAVE_LIBPTHREAD
+      if (! mcd_async_started) {
+	    mcd_async_stop = false;
+	    if (pthread_create(&mcd_async_writer, 0, mcd_async_thread, 0) == 0)
+		  mcd_async_started = true;
+      }
+#endif
+
+      struct mcd_async_s*file = new mcd_async_s;
+      file->fp = fp;
+      file->fill.reserve(MCD_ASYNC_BUF_SIZE);
+#ifdef HAVE_LIBZ
+      file->gz = 0;
+      size_t len = strlen(name);
+      if (len > 3 && strcmp(name+len-3, ".gz") == 0) {
+	    fflush(fp);
+	    int fd = dup(fileno(fp));
+	    if (fd >= 0) file->gz = gzdopen(fd, "wb");
+	    if (file->gz == 0 && fd >= 0) close(fd);
+      }
+#else
+      (void)name;
+#endif
+      return file;
+}
+
 /*
  * This table keeps track of the MCD files. Note that there may be
  * only 31 such files, and mcd bit0 (32'h00_00_00_01) is the special
@@ -48,6 +255,8 @@ extern FILE* vpi_trace;
 typedef struct mcd_entry {
 	FILE *fp;
 	char *filename;
+	  // Only for MCD channels in the asynchronous output mode.
+	struct mcd_async_s *async;
 } mcd_entry_s;
 static mcd_entry_s mcd_table[31];
 static mcd_entry_s *fd_table = NULL;
@@ -55,6 +264,35 @@ static unsigned fd_table_len = 0;
 
 static FILE* logfile;
 
+/*
+ * This is called at the end of the simulation, and again at exit in
+ * case the simulation ended without getting to final_cleanup. Write
+ * out everything the asynchronous channels still hold, and stop the
+ * writer thread. The files are closed as well, as gzip needs to write
+ * its trailer.
+ */
+void vpip_mcd_async_finish(void)
+{
+      for (int i = 1; i < 31; i++) {
+	    if (mcd_table[i].async) {
+		  mcd_async_close(mcd_table[i].async);
+		  mcd_table[i].async = NULL;
+		  mcd_table[i].fp = NULL;
+	    }
+      }
+
+#ifdef HAVE_LIBPTHREAD
+      if (mcd_async_started) {
+	    pthread_mutex_lock(&mcd_async_lock);
+	    mcd_async_stop = true;
+	    pthread_cond_signal(&mcd_async_work);
+	    pthread_mutex_unlock(&mcd_async_lock);
+	    pthread_join(mcd_async_writer, 0);
+	    mcd_async_started = false;
+      }
+#endif
+}
+
 /* Initialize mcd portion of vpi.  Must be called before
  * any vpi_mcd routines can be used.
  */
@@ -65,6 +303,7 @@ void vpip_mcd_init(FILE *log)
       for (unsigned idx = 0; idx < fd_table_len; idx += 1) {
 	    fd_table[idx].fp = NULL;
 	    fd_table[idx].filename = NULL;
+	    fd_table[idx].async = NULL;
       }
 
       mcd_table[0].fp = stdout;
@@ -116,7 +355,13 @@ extern "C" PLI_UINT32 vpi_mcd_close(PLI_UINT32 mcd)
 	    if (mcd & 1) rc |= 1;
 	    for(int i = 1; i < 31; i++) {
 		  if ((mcd>>i) & 1) {
-			if (mcd_table[i].fp) {
+			if (mcd_table[i].async) {
+			      if (mcd_async_close(mcd_table[i].async)) rc |= 1<<i;
+			      free(mcd_table[i].filename);
+			      mcd_table[i].fp = NULL;
+			      mcd_table[i].filename = NULL;
+			      mcd_table[i].async = NULL;
+			} else if (mcd_table[i].fp) {
 			      if (fclose(mcd_table[i].fp)) rc |= 1<<i;
 			      free(mcd_table[i].filename);
 			      mcd_table[i].fp = NULL;
@@ -175,6 +420,8 @@ got_entry:
 	if(mcd_table[i].fp == NULL)
 		return 0;
 	mcd_table[i].filename = strdup(name);
+	if (vpip_mcd_async)
+		mcd_table[i].async = mcd_async_open(mcd_table[i].fp, name);
 
 	if (vpi_trace) {
 	      fprintf(vpi_trace, "vpi_mcd_open(%s) --> 0x%08x\n",
@@ -213,6 +460,7 @@ vpi_mcd_vprintf(PLI_UINT32 mcd, const char*fmt, va_list ap)
 	    rc = vsnprintf(buf_ptr, rc+1, fmt, saved_ap);
       }
       va_end(saved_ap);
+      size_t len = rc;
 
       for(int i = 0; i < 31; i++) {
 	    if((mcd>>i) & 1) {
@@ -220,7 +468,10 @@ vpi_mcd_vprintf(PLI_UINT32 mcd, const char*fmt, va_list ap)
 			  // echo to logfile
 			if (i == 0 && logfile)
 			      fputs(buf_ptr, logfile);
-			fputs(buf_ptr, mcd_table[i].fp);
+			if (mcd_table[i].async)
+			      mcd_async_write(mcd_table[i].async, buf_ptr, len);
+			else
+			      fputs(buf_ptr, mcd_table[i].fp);
 		  } else {
 			rc = EOF;
 		  }
@@ -251,6 +502,11 @@ extern "C" void vpip_mcd_rawwrite(PLI_UINT32 mcd, const char*buf, size_t cnt)
 	    if (mcd_table[idx].fp == 0)
 		  continue;
 
+	    if (mcd_table[idx].async) {
+		  mcd_async_write(mcd_table[idx].async, buf, cnt);
+		  continue;
+	    }
+
 	    fwrite(buf, 1, cnt, mcd_table[idx].fp);
 	    if (idx == 0 && logfile)
 		  fwrite(buf, 1, cnt, logfile);
@@ -258,17 +514,29 @@ extern "C" void vpip_mcd_rawwrite(PLI_UINT32 mcd, const char*buf, size_t cnt)
       }
 }
 
+/*
+ * A flush of channels in the asynchronous output mode blocks until
+ * the writer thread has written and flushed everything the channels
+ * hold. All the selected channels are passed to the writer before
+ * waiting, so flushing many channels waits only once.
+ */
 extern "C" PLI_INT32 vpi_mcd_flush(PLI_UINT32 mcd)
 {
 	int rc = 0;
 
 	if (IS_MCD(mcd)) {
+		bool async = false;
 		for(int i = 0; i < 31; i++) {
 			if((mcd>>i) & 1) {
 				if (i == 0 && logfile) fflush(logfile);
-				if (fflush(mcd_table[i].fp)) rc |= 1<<i;
+				if (mcd_table[i].async) {
+				      mcd_async_submit(mcd_table[i].async, true);
+				      async = true;
+				} else if (mcd_table[i].fp &&
+				           fflush(mcd_table[i].fp)) rc |= 1<<i;
 			}
 		}
+		if (async) mcd_async_wait();
 	} else {
 		unsigned idx = FD_IDX(mcd);
 		if (idx < fd_table_len) rc = fflush(fd_table[idx].fp);
@@ -305,6 +573,7 @@ extern "C" PLI_INT32 vpi_fopen(const char*name, const char*mode)
       for (unsigned idx = i; idx < fd_table_len; idx += 1) {
 	    fd_table[idx].fp = NULL;
 	    fd_table[idx].filename = NULL;
+	    fd_table[idx].async = NULL;
       }
 
 got_entry:
@@ -318,6 +587,9 @@ got_entry:
 #endif
       if (fd_table[i].fp == NULL) return 0;
       fd_table[i].filename = strdup(name);
+	/* A file that is only written can at least use a large buffer. */
+      if (vpip_mcd_async && strchr(mode, 'r') == 0 && strchr(mode, '+') == 0)
+	    setvbuf(fd_table[i].fp, NULL, _IOFBF, MCD_ASYNC_BUF_SIZE);
       return ((1U<<31)|i);
 }
 
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2026 the Icarus Verilog contributors
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This file holds the native implementations of the builtin system
+ * functions that vvp runs without the VPI call machinery. Each of
+ * these must return exactly what the calltf in the system module
+ * (vpi/sys_time.c, vpi/sys_random.c, vpi/sys_clog2.c) returns, so the
+ * code here follows those functions closely.
+ */
+
+# include  "config.h"
+# include  "vpi_priv.h"
+# include  "vthread.h"
+# include  "schedule.h"
+# include  <cstring>
+# include  <cmath>
+# include  <climits>
+# include  <cassert>
+
+/*
+ * The no argument $random shares its seed with every other no
+ * argument $random call, and $urandom shares its seed with every
+ * $urandom and $urandom_range call. If any call that shares a seed
+ * is left to the VPI path, then the seed lives in the system module
+ * and all the native calls that share it must also use the VPI path.
+ */
+static bool random_needs_vpi = false;
+static bool urandom_needs_vpi = false;
+
+static int32_t random_seed = 0;
+static int32_t urandom_seed = 0;
+
+/*
+ * This is rtl_dist_uniform(seed, INT32_MIN, INT32_MAX) from
+ * vpi/sys_random.c, which is the only range that $random and $urandom
+ * use. The arithmetic is kept exactly as it is there so that the
+ * sequence of values does not change.
+ */
+static int32_t random_full_range(int32_t*seed)
+{
+      double d = 0.00000011920928955078125;
+      double a = (double)INT32_MIN;
+      double b = (double)INT32_MAX;
+      double c, r;
+      uint32_t oldseed, newseed;
+
+      oldseed = *seed;
+      if (oldseed == 0)
+	    oldseed = 259341593;
+
+      newseed = 69069 * oldseed + 1;
+      *seed = newseed;
+
+      c = 1.0 + (newseed >> 9) * 0.00000011920928955078125;
+      c = c + (c*d);
+      c = ((b - a) * (c - 1.0)) + a;
+
+      r = (c + 2147483648.0) / 4294967295.0;
+      r = r * 4294967296.0 - 2147483648.0;
+
+      if (r >= 0)
+	    return (int32_t) r;
+      else
+	    return (int32_t) (r - 1);
+}
+
+static void pop_stacks(vthread_t thr, const __vpiSysTaskCall*call)
+{
+      if (call->vec4_stack > 0)
+	    vthread_pop_vec4(thr, call->vec4_stack);
+      if (call->real_stack > 0)
+	    vthread_pop_real(thr, call->real_stack);
+      if (call->string_stack > 0)
+	    vthread_pop_str(thr, call->string_stack);
+}
+
+/*
+ * Push an integer result that is at most 64 bits wide.
+ */
+static void push_vec4(vthread_t thr, unsigned wid, uint64_t val)
+{
+      const unsigned BITS_PER_ULONG = 8*sizeof(unsigned long);
+      assert(wid <= 64);
+
+      vvp_vector4_t res (wid, BIT4_0);
+      for (unsigned idx = 0 ; idx < wid ; idx += BITS_PER_ULONG) {
+	    unsigned long word = (unsigned long) (val >> idx);
+	    unsigned trans = wid - idx;
+	    if (trans > BITS_PER_ULONG)
+		  trans = BITS_PER_ULONG;
+	    res.setarray(idx, trans, &word);
+      }
+      vthread_push(thr, res);
+}
+
+/*
+ * $time, $stime and $simtime. The time is scaled to the units of the
+ * calling module and rounded to the nearest integer.
+ */
+static void native_time(vthread_t thr, __vpiSysTaskCall*call)
+{
+      uint64_t now = schedule_simtime();
+      long scale = call->native_scale;
+
+      if (scale > 1) {
+	    uint64_t frac = now % scale;
+	    now /= scale;
+	    if (frac >= (uint64_t)(scale/2))
+		  now += 1;
+      }
+
+      push_vec4(thr, call->native_wid, now);
+}
+
+/*
+ * $realtime. This is vpip_time_to_scaled_real for the calling module,
+ * whose scale exponent was saved when the call was bound.
+ */
+static void native_realtime(vthread_t thr, __vpiSysTaskCall*call)
+{
+      double val = (double)schedule_simtime();
+      long scale = call->native_scale;
+
+      if (scale >= 0) val *= pow(10.0, scale);
+      else val /= pow(10.0, -scale);
+
+      vthread_push(thr, val);
+}
+
+static void native_random(vthread_t thr, __vpiSysTaskCall*call)
+{
+      if (call->nargs == 0) {
+	    if (random_needs_vpi) {
+		  vpip_execute_vpi_call(thr, call);
+		  return;
+	    }
+	    push_vec4(thr, call->native_wid,
+		      (uint32_t)random_full_range(&random_seed));
+	    return;
+      }
+
+	/* Get the seed, calculate the result and send the updated
+	   seed back to the seed argument. */
+      vpip_current_vthread = thr;
+      s_vpi_value val;
+      val.format = vpiIntVal;
+      vpi_get_value(call->args[0], &val);
+      int32_t seed = val.value.integer;
+      int32_t res = random_full_range(&seed);
+      val.value.integer = seed;
+      vpi_put_value(call->args[0], &val, 0, vpiNoDelay);
+
+      push_vec4(thr, call->native_wid, (uint32_t)res);
+}
+
+static void native_urandom(vthread_t thr, __vpiSysTaskCall*call)
+{
+      if (urandom_needs_vpi) {
+	    vpip_execute_vpi_call(thr, call);
+	    return;
+      }
+
+	/* A seed argument reseeds the shared generator, and gets
+	   the updated seed back. */
+      s_vpi_value val;
+      if (call->nargs > 0) {
+	    vpip_current_vthread = thr;
+	    val.format = vpiIntVal;
+	    vpi_get_value(call->args[0], &val);
+	    urandom_seed = val.value.integer;
+      }
+
+      uint32_t res = (uint32_t)random_full_range(&urandom_seed) - INT32_MIN;
+
+      if (call->nargs > 0) {
+	    val.value.integer = urandom_seed;
+	    vpi_put_value(call->args[0], &val, 0, vpiNoDelay);
+      }
+
+      push_vec4(thr, call->native_wid, res);
+}
+
+static void native_clog2(vthread_t thr, __vpiSysTaskCall*call)
+{
+      vpip_current_vthread = thr;
+      s_vpi_vecval res = vpip_calc_clog2(call->args[0]);
+      pop_stacks(thr, call);
+
+      if (res.bval != 0)
+	    vthread_push(thr, vvp_vector4_t(call->native_wid, BIT4_X));
+      else
+	    push_vec4(thr, call->native_wid, (uint32_t)res.aval);
+}
+
+/*
+ * Find the module that contains the scope, the same way that
+ * sys_func_module in the system module does.
+ */
+static __vpiScope*module_of_scope(__vpiScope*scope)
+{
+      while (scope && scope->get_type_code() != vpiModule)
+	    scope = scope->scope;
+
+      return scope;
+}
+
+static bool bind_time(__vpiSysTaskCall*call, const char*name,
+		      int val_code, unsigned return_width)
+{
+      if (val_code != -vpiVectorVal || return_width > 64 || call->nargs != 0)
+	    return false;
+
+      int units;
+      if (strcmp(name, "$simtime") == 0) {
+	    units = vpip_get_time_precision();
+      } else {
+	    __vpiScope*mod = module_of_scope(call->scope);
+	    if (mod == 0)
+		  return false;
+	    units = mod->time_units;
+      }
+
+      long scale = 1;
+      for (int prec = vpip_get_time_precision() ; units > prec ; units -= 1)
+	    scale *= 10;
+
+      call->native = &native_time;
+      call->native_wid = return_width;
+      call->native_scale = scale;
+      return true;
+}
+
+static bool bind_native(__vpiSysTaskCall*call, int val_code,
+			unsigned return_width)
+{
+      const char*name = call->defn->info.tfname;
+
+	/* Only the functions of the system modules, called from
+	   behavioral code, are run natively. */
+      if (call->defn->is_user_defn || call->fnet != 0 || val_code == 0)
+	    return false;
+
+      if (strcmp(name, "$time") == 0 || strcmp(name, "$stime") == 0 ||
+	  strcmp(name, "$simtime") == 0)
+	    return bind_time(call, name, val_code, return_width);
+
+      if (strcmp(name, "$realtime") == 0) {
+	    if (val_code != -vpiRealVal || call->nargs != 0)
+		  return false;
+	    __vpiScope*mod = module_of_scope(call->scope);
+	    if (mod == 0)
+		  return false;
+	    call->native = &native_realtime;
+	    call->native_scale = vpip_get_time_precision() - mod->time_units;
+	    return true;
+      }
+
+      bool int_func = val_code == -vpiVectorVal && return_width == 32;
+
+      if (strcmp(name, "$random") == 0 || strcmp(name, "$urandom") == 0) {
+	    if (!int_func || call->nargs > 1 || call->vec4_stack != 0
+		|| call->real_stack != 0 || call->string_stack != 0)
+		  return false;
+	    call->native = name[1] == 'r'? &native_random : &native_urandom;
+	    call->native_wid = return_width;
+	    return true;
+      }
+
+      if (strcmp(name, "$clog2") == 0) {
+	    if (!int_func || call->nargs != 1)
+		  return false;
+	    call->native = &native_clog2;
+	    call->native_wid = return_width;
+	    return true;
+      }
+
+      return false;
+}
+
+void vpip_native_bind(__vpiSysTaskCall*call, int val_code,
+		      unsigned return_width)
+{
+      if (bind_native(call, val_code, return_width))
+	    return;
+
+	/* This call uses the VPI path, so note if it shares a seed
+	   with calls that could otherwise be native. */
+      const char*name = call->defn->info.tfname;
+      if (strcmp(name, "$random") == 0 && call->nargs == 0)
+	    random_needs_vpi = true;
+      else if (strcmp(name, "$urandom") == 0 ||
+	       strcmp(name, "$urandom_range") == 0)
+	    urandom_needs_vpi = true;
+}
@@ -20,6 +20,7 @@
 # include  "version_base.h"
 # include  "vpi_priv.h"
 # include  "schedule.h"
+# include  "symbols.h"
 #ifdef CHECK_WITH_VALGRIND
 # include  "vvp_cleanup.h"
 #endif
@@ -1325,6 +1326,12 @@ static vpiHandle find_name(const char *name, vpiHandle handle)
       if (!strcmp(name, vpi_get_str(vpiName, handle)))
 	    rtn = handle;
 
+      /* Memory words have names of the form name[index], so only a
+       * name with a '[' in it can be a word. Other names can be
+       * found in the scope name index. */
+      if (rtn == 0 && strchr(name, '[') == 0)
+	    return vpip_find_scope_item(ref, name);
+
       /* brute force search for the name in all objects in this scope */
       for (unsigned i = 0 ;  i < ref->intern.size() ;  i += 1) {
 	      /* The standard says that since a port does not have a full
@@ -1380,12 +1387,20 @@ static char * find_rest(char *name)
       return rest;
 }
 
+/*
+ * Scope paths looked up from the root are cached by the full path
+ * string, so a repeated lookup of a.b.c costs a single hash lookup.
+ * Scopes are never created or deleted once the simulation is running,
+ * so a cached scope stays valid.
+ */
+static symbol_table_t root_path_cache = 0;
+
 static vpiHandle find_scope(const char *name, vpiHandle handle, int depth)
 {
-
-      vpiHandle iter = handle==0
-	    ? vpi_iterate(vpiModule, NULL)
-	    : vpi_iterate(vpiInternalScope, handle);
+      if (handle == 0 && depth == 0 && root_path_cache) {
+	    vpiHandle rtn = (vpiHandle) sym_find_value(root_path_cache, name).ptr;
+	    if (rtn) return rtn;
+      }
 
       vector<char> name_buf (strlen(name)+1);
       strcpy(&name_buf[0], name);
@@ -1396,23 +1411,20 @@ static vpiHandle find_scope(const char *name, vpiHandle handle, int depth)
 	    *nm_rest++ = 0;
       }
 
-      vpiHandle rtn = 0;
-      vpiHandle hand;
-      while (iter && (hand = vpi_scan(iter))) {
-	    char *nm = vpi_get_str(vpiName, hand);
-
-	    if (strcmp(nm_first,nm)==0) {
-		  if (nm_rest)
-			rtn=find_scope(nm_rest, hand, depth+1);
-		  else
-			rtn = hand;
-	    }
+      __vpiScope*scope = dynamic_cast<__vpiScope*>(handle);
+      if (handle && scope == 0)
+	    return 0;
 
-	    /* found it yet ? */
-	    if (rtn) {
-		  vpi_free_object(iter);
-		  break;
-	    }
+      vpiHandle rtn = vpip_find_internal_scope(scope, nm_first);
+      if (rtn && nm_rest)
+	    rtn = find_scope(nm_rest, rtn, depth+1);
+
+      if (rtn && handle == 0 && depth == 0) {
+	    if (root_path_cache == 0)
+		  root_path_cache = new_symbol_table();
+	    symbol_value_t val;
+	    val.ptr = rtn;
+	    sym_set_value(root_path_cache, name, val);
       }
 
       return rtn;
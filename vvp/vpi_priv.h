@@ -255,6 +255,7 @@ struct __vpiScopedRealtime : public __vpiSystemTime {
 class __vpiScope : public __vpiHandle {
 
     public:
+      ~__vpiScope();
       int vpi_get(int code);
       char* vpi_get_str(int code);
       vpiHandle vpi_handle(int code);
@@ -293,6 +294,8 @@ class __vpiScope : public __vpiHandle {
       vvp_context_t free_contexts;
 	/* Keep a list of threads in the scope. */
       std::set<vthread_t> threads;
+	/* Lazily built name index for vpi_handle_by_name. */
+      class scope_name_index_s*name_index;
       signed int time_units :8;
       signed int time_precision :8;
 
@@ -345,6 +348,16 @@ extern vpiHandle vpip_make_root_iterator(int type_code);
 extern void vpip_make_root_iterator(class __vpiHandle**&table,
 				    unsigned&ntable);
 
+/*
+ * Look up the named item (not a port) in the scope, or the named
+ * internal scope of the scope. If the scope is nil, the internal
+ * scope lookup finds a root module. These use a hash index that the
+ * scope builds the first time it is searched, and return the first
+ * match in scope order, or nil.
+ */
+extern vpiHandle vpip_find_scope_item(__vpiScope*scope, const char*name);
+extern vpiHandle vpip_find_internal_scope(__vpiScope*scope, const char*name);
+
 /*
  * Signals include the variable types (reg, integer, time) and are
  * distinguished by the vpiType code. They also have a parent scope,
@@ -847,17 +860,37 @@ struct __vpiSysTaskCall : public __vpiHandle {
       unsigned file_idx;
       unsigned lineno;
       bool put_value;
+	/* Set if vvp runs this call itself (see vpi_native.cc). */
+      void (*native)(vthread_t thr, struct __vpiSysTaskCall*call);
+      unsigned native_wid;
+      long native_scale;
     protected:
       inline __vpiSysTaskCall()
       {
 	    vec4_stack = 0;
 	    real_stack = 0;
 	    string_stack = 0;
+	    native = 0;
+	    native_wid = 0;
+	    native_scale = 1;
       }
 };
 
 extern struct __vpiSysTaskCall*vpip_cur_task;
 
+/*
+ * A few of the builtin system functions are simple and called often
+ * enough that vvp implements them itself. vpip_native_bind looks at a
+ * newly built call and, if it is a %vpi_func call of one of those
+ * functions as defined by the system modules, attaches the native
+ * implementation to it. The native function then takes the place of
+ * vpip_execute_vpi_call: it reads the arguments, pops the thread
+ * stacks and pushes the result without going through the calltf.
+ * Calls of functions that a user module defines always use VPI.
+ */
+extern void vpip_native_bind(struct __vpiSysTaskCall*call, int val_code,
+			     unsigned return_width);
+
 /*
  * The persistent flag to vpip_make_string_const causes the created
  * handle to be persistent. This is necessary for cases where the
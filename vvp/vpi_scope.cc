@@ -26,6 +26,8 @@
 # include  "vvp_cleanup.h"
 #endif
 # include  <vector>
+# include  <string>
+# include  <algorithm>
 # include  <cstring>
 # include  <cstdlib>
 # include  <cassert>
@@ -337,13 +339,162 @@ static vpiHandle module_iter(int code, vpiHandle obj)
 }
 
 
+/*
+ * The name index of a scope maps the names of the items of the scope
+ * to the items, and the names of the internal scopes to the scopes,
+ * so vpi_handle_by_name does not have to scan the scope contents
+ * item by item. Only the first item with any given name goes in the
+ * table, to match the order of a linear scan. The index is built the
+ * first time the scope is searched, and rebuilt if items have been
+ * added to the scope since then.
+ *
+ * The index is a vector sorted by name with one entry per name, and
+ * the names are kept end to end in a single string, so a scope with
+ * few items has a small index.
+ */
+class scope_name_index_s {
+    public:
+      scope_name_index_s() : built_(false), size_(0) { }
+
+      vpiHandle find_item(const vector<vpiHandle>&table, const char*name,
+			  int scope_code)
+      { const entry_s*cur = find_(table, name, scope_code);
+	return cur? cur->item : 0;
+      }
+
+      vpiHandle find_scope(const vector<vpiHandle>&table, const char*name,
+			   int scope_code)
+      { const entry_s*cur = find_(table, name, scope_code);
+	return cur? cur->scope : 0;
+      }
+
+    private:
+      struct entry_s {
+	      // Offset of the name in names_.
+	    size_t name;
+	      // The first item with this name.
+	    vpiHandle item;
+	      // The first internal scope with this name, if any.
+	    vpiHandle scope;
+      };
+
+      struct entry_less_s {
+	    explicit entry_less_s(const char*n) : names(n) { }
+	    bool operator() (const entry_s&a, const entry_s&b) const
+	    { return strcmp(names+a.name, names+b.name) < 0; }
+	    bool operator() (const entry_s&a, const char*b) const
+	    { return strcmp(names+a.name, b) < 0; }
+	    const char*names;
+      };
+
+      const entry_s* find_(const vector<vpiHandle>&table, const char*name,
+			   int scope_code);
+      void build_(const vector<vpiHandle>&table, int scope_code);
+
+      vector<entry_s> entries_;
+      std::string names_;
+      bool built_;
+      size_t size_;
+};
+
+static int compare_types(int code, int type);
+
+const scope_name_index_s::entry_s*
+scope_name_index_s::find_(const vector<vpiHandle>&table, const char*name,
+			  int scope_code)
+{
+      build_(table, scope_code);
+
+      entry_less_s less (names_.c_str());
+      vector<entry_s>::const_iterator cur
+	    = lower_bound(entries_.begin(), entries_.end(), name, less);
+      if (cur == entries_.end() || strcmp(names_.c_str()+cur->name, name) != 0)
+	    return 0;
+
+      return &*cur;
+}
+
+void scope_name_index_s::build_(const vector<vpiHandle>&table, int scope_code)
+{
+      if (built_ && size_ == table.size())
+	    return;
+
+      vector<entry_s> tmp;
+      tmp.reserve(table.size());
+      names_.clear();
+
+      for (unsigned idx = 0 ;  idx < table.size() ;  idx += 1) {
+	    vpiHandle item = table[idx];
+	    int type = vpi_get(vpiType, item);
+	      /* A port does not have a full name, so the standard
+		 says it cannot be found by name. */
+	    if (type == vpiPort)
+		  continue;
+
+	    char*nm = vpi_get_str(vpiName, item);
+	    if (nm == 0)
+		  continue;
+
+	    entry_s cur;
+	    cur.name = names_.size();
+	    cur.item = item;
+	    cur.scope = compare_types(scope_code, item->get_type_code())? item : 0;
+	    names_.append(nm, strlen(nm)+1);
+	    tmp.push_back(cur);
+      }
+
+	/* The sort keeps items with the same name in scope order, so
+	   the first of each run is the one a linear scan finds. */
+      entry_less_s less (names_.c_str());
+      stable_sort(tmp.begin(), tmp.end(), less);
+
+      entries_.clear();
+      for (size_t idx = 0 ;  idx < tmp.size() ;  idx += 1) {
+	    if (! entries_.empty() && ! less(entries_.back(), tmp[idx])) {
+		  if (entries_.back().scope == 0)
+			entries_.back().scope = tmp[idx].scope;
+		  continue;
+	    }
+	    entries_.push_back(tmp[idx]);
+      }
+
+      names_.shrink_to_fit();
+      entries_.shrink_to_fit();
+      built_ = true;
+      size_ = table.size();
+}
+
+static scope_name_index_s root_name_index;
+
+vpiHandle vpip_find_scope_item(__vpiScope*scope, const char*name)
+{
+      if (scope->name_index == 0)
+	    scope->name_index = new scope_name_index_s;
+      return scope->name_index->find_item(scope->intern, name, vpiInternalScope);
+}
+
+vpiHandle vpip_find_internal_scope(__vpiScope*scope, const char*name)
+{
+      if (scope == 0)
+	    return root_name_index.find_scope(vpip_root_table, name, vpiModule);
+
+      if (scope->name_index == 0)
+	    scope->name_index = new scope_name_index_s;
+      return scope->name_index->find_scope(scope->intern, name, vpiInternalScope);
+}
+
 __vpiScope::__vpiScope(const char*nam, const char*tnam, bool auto_flag)
-: is_automatic_(auto_flag)
+: name_index(0), is_automatic_(auto_flag)
 {
       name_ = vpip_name_string(nam);
       tname_ = vpip_name_string(tnam? tnam : "");
 }
 
+__vpiScope::~__vpiScope()
+{
+      delete name_index;
+}
+
 int __vpiScope::vpi_get(int code)
 {
       switch (code) {
@@ -881,6 +881,7 @@ vpiHandle vpip_build_vpi_call(const char*name, int val_code, unsigned return_wid
       obj->put_value = false;
 
       compile_compiletf(obj);
+      vpip_native_bind(obj, val_code, return_width);
 
       return obj;
 }
@@ -28,12 +28,14 @@
 # include  "vvp_cobject.h"
 # include  "vvp_darray.h"
 # include  "class_type.h"
+# include  "statistics.h"
 #ifdef CHECK_WITH_VALGRIND
 # include  "vvp_cleanup.h"
 #endif
 # include  <set>
 # include  <typeinfo>
 # include  <vector>
+# include  <utility>
 # include  <cstdlib>
 # include  <climits>
 # include  <cstring>
@@ -60,18 +62,18 @@ using namespace std;
  * ** Notes On The Interactions of %fork/%join/%end:
  *
  * The %fork instruction creates a new thread and pushes that into a
- * set of children for the thread. This new thread, then, becomes a
+ * list of children for the thread. This new thread, then, becomes a
  * child of the current thread, and the current thread a parent of the
  * new thread. Any child can be reaped by a %join.
  *
  * Children that are detached with %join/detach need to have a different
  * parent/child relationship since the parent can still effect them if
  * it uses the %disable/fork or %wait/fork opcodes. The i_am_detached
- * flag and detached_children set are used for this relationship.
+ * flag and detached_children list are used for this relationship.
  *
  * It is a programming error for a thread that created threads to not
  * %join (or %join/detach) as many as it created before it %ends. The
- * children set will get messed up otherwise.
+ * children list will get messed up otherwise.
  *
  * the i_am_joining flag is a clue to children that the parent is
  * blocked in a %join and may need to be scheduled. The %end
@@ -88,6 +90,33 @@ using namespace std;
  * to reap the child immediately.
  */
 
+/*
+ * The children of a thread are kept in intrusive doubly linked lists
+ * threaded through the child_prev/child_next members of the child
+ * threads. A thread is in at most one such list (the children or
+ * detached_children of its parent) at a time, and its child_list
+ * member points to that list, so erase can tell if the thread is
+ * there. New children go at the end, so the list is in fork order.
+ */
+class vthread_list_s {
+    public:
+      vthread_list_s() : head_(0), tail_(0), count_(0) { }
+
+      bool empty() const { return count_ == 0; }
+      size_t size() const { return count_; }
+      struct vthread_s* front() const { return head_; }
+
+      inline void insert(struct vthread_s*thr);
+	// Remove the thread from the list, and return the number of
+	// threads removed (0 or 1).
+      inline size_t erase(struct vthread_s*thr);
+
+    private:
+      struct vthread_s*head_;
+      struct vthread_s*tail_;
+      size_t count_;
+};
+
 struct vthread_s {
       vthread_s();
 
@@ -118,7 +147,7 @@ struct vthread_s {
       inline vvp_vector4_t pop_vec4(void)
       {
 	    assert(! stack_vec4_.empty());
-	    vvp_vector4_t val = stack_vec4_.back();
+	    vvp_vector4_t val = std::move(stack_vec4_.back());
 	    stack_vec4_.pop_back();
 	    return val;
       }
@@ -126,6 +155,10 @@ struct vthread_s {
       {
 	    stack_vec4_.push_back(val);
       }
+      inline void push_vec4(vvp_vector4_t&&val)
+      {
+	    stack_vec4_.push_back(std::move(val));
+      }
       inline const vvp_vector4_t& peek_vec4(unsigned depth)
       {
 	    unsigned size = stack_vec4_.size();
@@ -274,9 +307,12 @@ struct vthread_s {
       unsigned is_scheduled      :1;
       unsigned delay_delete      :1;
 	/* This points to the children of the thread. */
-      set<struct vthread_s*>children;
+      vthread_list_s children;
 	/* This points to the detached children of the thread. */
-      set<struct vthread_s*>detached_children;
+      vthread_list_s detached_children;
+	/* These link me into the children list of my parent. */
+      struct vthread_s*child_prev, *child_next;
+      vthread_list_s*child_list;
 	/* This points to my parent, if I have one. */
       struct vthread_s*parent;
 	/* This points to the containing scope. */
@@ -318,6 +354,44 @@ inline vthread_s::vthread_s()
       stack_obj_size_ = 0;
       filenm_ = 0;
       lineno_ = 0;
+      child_prev = 0;
+      child_next = 0;
+      child_list = 0;
+}
+
+inline void vthread_list_s::insert(struct vthread_s*thr)
+{
+      assert(thr->child_list == 0);
+      thr->child_list = this;
+      thr->child_prev = tail_;
+      thr->child_next = 0;
+      if (tail_)
+	    tail_->child_next = thr;
+      else
+	    head_ = thr;
+      tail_ = thr;
+      count_ += 1;
+}
+
+inline size_t vthread_list_s::erase(struct vthread_s*thr)
+{
+      if (thr->child_list != this)
+	    return 0;
+
+      if (thr->child_prev)
+	    thr->child_prev->child_next = thr->child_next;
+      else
+	    head_ = thr->child_next;
+      if (thr->child_next)
+	    thr->child_next->child_prev = thr->child_prev;
+      else
+	    tail_ = thr->child_prev;
+
+      thr->child_prev = 0;
+      thr->child_next = 0;
+      thr->child_list = 0;
+      count_ -= 1;
+      return 1;
 }
 
 void vthread_s::set_fileline(char *filenm, unsigned lineno)
@@ -686,12 +760,43 @@ void contexts_delete(struct __vpiScope*scope)
 }
 #endif
 
+/*
+ * Threads that are deleted are kept in a pool and reused by
+ * vthread_new, so code that forks many short lived threads does not
+ * need to go to the heap for each one. A reused thread also keeps
+ * the memory of its stacks. The pool is linked through the wait_next
+ * member, and is limited in size so that a burst of threads does not
+ * hold on to the memory forever.
+ */
+static vthread_t vthread_pool = 0;
+static unsigned long vthread_pool_count = 0;
+static const unsigned long vthread_pool_max = 1024;
+
+unsigned long count_thread_creates = 0;
+
+unsigned long count_thread_pool(void)
+{
+      return vthread_pool_count;
+}
+
 /*
  * Create a new thread with the given start address.
  */
 vthread_t vthread_new(vvp_code_t pc, __vpiScope*scope)
 {
-      vthread_t thr = new struct vthread_s;
+      vthread_t thr;
+      if (vthread_pool) {
+	    thr = vthread_pool;
+	    vthread_pool = thr->wait_next;
+	    vthread_pool_count -= 1;
+	    thr->args_real.clear();
+	    thr->args_str.clear();
+	    thr->args_vec4.clear();
+      } else {
+	    thr = new struct vthread_s;
+      }
+      count_thread_creates += 1;
+
       thr->pc     = pc;
 	//thr->bits4  = vvp_vector4_t(32);
       thr->parent = 0;
@@ -767,25 +872,18 @@ void vthreads_delete(struct __vpiScope*scope)
  */
 static void vthread_reap(vthread_t thr)
 {
-      if (! thr->children.empty()) {
-	    for (set<vthread_t>::iterator cur = thr->children.begin()
-		       ; cur != thr->children.end() ; ++cur) {
-		  vthread_t child = *cur;
-		  assert(child);
-		  assert(child->parent == thr);
-		  child->parent = thr->parent;
-	    }
+      for (vthread_t child = thr->children.front()
+		 ; child ; child = child->child_next) {
+	    assert(child->parent == thr);
+	    child->parent = thr->parent;
       }
-      if (! thr->detached_children.empty()) {
-	    for (set<vthread_t>::iterator cur = thr->detached_children.begin()
-		       ; cur != thr->detached_children.end() ; ++cur) {
-		  vthread_t child = *cur;
-		  assert(child);
-		  assert(child->parent == thr);
-		  assert(child->i_am_detached);
-		  child->parent = 0;
-		  child->i_am_detached = 0;
-	    }
+      while (! thr->detached_children.empty()) {
+	    vthread_t child = thr->detached_children.front();
+	    assert(child->parent == thr);
+	    assert(child->i_am_detached);
+	    child->parent = 0;
+	    child->i_am_detached = 0;
+	    thr->detached_children.erase(child);
       }
       if (thr->parent) {
 	      /* assert that the given element was removed. */
@@ -821,6 +919,17 @@ static void vthread_reap(vthread_t thr)
 void vthread_delete(vthread_t thr)
 {
       thr->cleanup();
+#ifndef CHECK_WITH_VALGRIND
+      if (vthread_pool_count < vthread_pool_max) {
+	    assert(thr->children.empty());
+	    assert(thr->detached_children.empty());
+	    assert(thr->child_list == 0);
+	    thr->wait_next = vthread_pool;
+	    vthread_pool = thr;
+	    vthread_pool_count += 1;
+	    return;
+      }
+#endif
       delete thr;
 }
 
@@ -887,15 +996,25 @@ bool of_CHUNK_LINK(vthread_t thr, vvp_code_t code)
  * This is called by an event functor to wake up all the threads on
  * its list. I in fact created that list in the %wait instruction, and
  * I also am certain that the waiting_for_event flag is set.
+ *
+ * The whole list goes into the active queue as one event, and this
+ * single pass over the list does all the flag work, so each thread is
+ * touched only here and again when vthread_run runs it.
  */
 void vthread_schedule_list(vthread_t thr)
 {
+      unsigned long cnt = 0;
       for (vthread_t cur = thr ;  cur ;  cur = cur->wait_next) {
 	    assert(cur->waiting_for_event);
+	    assert(cur->is_scheduled == 0);
 	    cur->waiting_for_event = 0;
+	    cur->is_scheduled = 1;
+	    cnt += 1;
       }
 
-      schedule_vthread(thr, 0);
+      count_thread_batches += 1;
+      count_thread_batched += cnt;
+      schedule_vthread_list(thr);
 }
 
 vvp_context_t vthread_get_wt_context()
@@ -2584,7 +2703,7 @@ static bool do_disable(vthread_t thr, vthread_t match)
 	   %forks that this thread has done. */
       while (! thr->children.empty()) {
 
-	    vthread_t tmp = *(thr->children.begin());
+	    vthread_t tmp = thr->children.front();
 	    assert(tmp);
 	    assert(tmp->parent == thr);
 	    thr->i_am_joining = 0;
@@ -2680,7 +2799,7 @@ bool of_DISABLE_FORK(vthread_t thr, vvp_code_t)
 
 	/* Disable any detached children. */
       while (! thr->detached_children.empty()) {
-	    vthread_t child = *(thr->detached_children.begin());
+	    vthread_t child = thr->detached_children.front();
 	    assert(child);
 	    assert(child->parent == thr);
 	      /* Disabling the children can never match the parent thread. */
@@ -3040,13 +3159,13 @@ bool of_END(vthread_t thr, vvp_code_t)
 
 	/* Fully detach any detached children. */
       while (! thr->detached_children.empty()) {
-	    vthread_t child = *(thr->detached_children.begin());
+	    vthread_t child = thr->detached_children.front();
 	    assert(child);
 	    assert(child->parent == thr);
 	    assert(child->i_am_detached);
 	    child->parent = 0;
 	    child->i_am_detached = 0;
-	    thr->detached_children.erase(thr->detached_children.begin());
+	    thr->detached_children.erase(child);
       }
 
 	/* It is an error to still have active children running at this
@@ -3067,7 +3186,7 @@ bool of_END(vthread_t thr, vvp_code_t)
       }
 
 	/* If this thread is not fully detached then remove it from the
-	 * parents detached_children set and reap it. */
+	 * parents detached_children list and reap it. */
       if (thr->i_am_detached) {
 	    vthread_t tmp = thr->parent;
 	    assert(tmp);
@@ -3740,9 +3859,8 @@ static bool do_join_opcode(vthread_t thr)
 
 	// Are there any children that have already ended? If so, then
 	// join with that one.
-      for (set<vthread_t>::iterator cur = thr->children.begin()
-		 ; cur != thr->children.end() ; ++cur) {
-	    vthread_t curp = *cur;
+      for (vthread_t curp = thr->children.front()
+		 ; curp ; curp = curp->child_next) {
 	    if (! curp->i_have_ended)
 		  continue;
 
@@ -3773,7 +3891,7 @@ bool of_JOIN_DETACH(vthread_t thr, vvp_code_t cp)
       assert(count == thr->children.size());
 
       while (! thr->children.empty()) {
-	    vthread_t child = *thr->children.begin();
+	    vthread_t child = thr->children.front();
 	    assert(child->parent == thr);
 
 	      // We cannot detach automatic tasks/functions within an
@@ -4970,6 +5088,22 @@ bool of_PROP_V(vthread_t thr, vvp_code_t cp)
       return prop<vvp_vector4_t>(thr, cp);
 }
 
+/*
+ * %prop/v4 <pid>
+ *
+ * This is the same as %prop/v, but the property is known to be a
+ * 4-state vector, so it is pushed straight from the object.
+ */
+bool of_PROP_V4(vthread_t thr, vvp_code_t cp)
+{
+      vvp_object_t&obj = thr->peek_object();
+      vvp_cobject*cobj = obj.peek<vvp_cobject>();
+      assert(cobj);
+
+      thr->push_vec4(cobj->peek_vec4(cp->number));
+      return true;
+}
+
 bool of_PUSHI_REAL(vthread_t thr, vvp_code_t cp)
 {
       double mant = cp->bit_idx[0];
@@ -5970,6 +6104,31 @@ bool of_STORE_PROP_V(vthread_t thr, vvp_code_t cp)
       return store_prop<vvp_vector4_t>(thr, cp, cp->bit_idx[0]);
 }
 
+/*
+ * %store/prop/v4 <pid>, <wid>
+ *
+ * This is the same as %store/prop/v, but the property is known to be
+ * a 4-state vector, so the value is written straight into the object.
+ */
+bool of_STORE_PROP_V4(vthread_t thr, vvp_code_t cp)
+{
+      unsigned wid = cp->bit_idx[0];
+
+      vvp_object_t&obj = thr->peek_object();
+      vvp_cobject*cobj = obj.peek<vvp_cobject>();
+      assert(cobj);
+
+      vvp_vector4_t&dst = cobj->peek_vec4(cp->number);
+      const vvp_vector4_t&val = thr->peek_vec4();
+      assert(val.size() >= wid);
+      dst = val;
+      if (dst.size() != wid)
+	    dst.resize(wid);
+
+      thr->pop_vec4(1);
+      return true;
+}
+
 template <typename ELEM, class QTYPE>
 static bool store_qb(vthread_t thr, vvp_code_t cp, unsigned wid=0)
 {
@@ -6496,6 +6655,18 @@ bool of_VPI_CALL(vthread_t thr, vvp_code_t cp)
       return schedule_finished()? false : true;
 }
 
+/*
+ * This takes the place of %vpi_func for the builtin system functions
+ * that vvp implements itself (see vpi_native.cc). These never stop or
+ * finish the simulation.
+ */
+bool of_VPI_NATIVE(vthread_t thr, vvp_code_t cp)
+{
+      __vpiSysTaskCall*call = static_cast<__vpiSysTaskCall*>(cp->handle);
+      call->native(thr, call);
+      return true;
+}
+
 /* %wait <label>;
  * Implement the wait by locating the vvp_net_T for the event, and
  * adding this thread to the threads list for the event. The some
@@ -46,6 +46,10 @@ class vvp_cobject : public vvp_object {
 
       void shallow_copy(const vvp_object*that);
 
+	// The value of a 4-state vector property, in place.
+      inline vvp_vector4_t&peek_vec4(size_t pid)
+      { return defn_->peek_vec4(properties_, pid); }
+
     private:
       const class_type* defn_;
 	// For now, only support 32bit bool signed properties.
@@ -19,6 +19,8 @@
 
 # include  "vvp_darray.h"
 # include  <iostream>
+# include  <cstring>
+# include  <cassert>
 # include  <typeinfo>
 
 using namespace std;
@@ -777,13 +779,117 @@ void vvp_queue_string::erase_tail(unsigned idx)
 	    queue.resize(idx);
 }
 
+vvp_queue_vec4::vvp_queue_vec4()
+: wid_(0), words_(0), buf_(0), cap_(0), head_(0), count_(0)
+{
+}
+
 vvp_queue_vec4::~vvp_queue_vec4()
 {
+      delete[]buf_;
+}
+
+vvp_vector4_t vvp_queue_vec4::get_elem_(size_t idx) const
+{
+      assert(idx < count_);
+      vvp_vector4_t res (wid_);
+      const unsigned long*ptr = elem_(idx);
+      res.set_words(ptr, ptr + words_/2);
+      return res;
+}
+
+void vvp_queue_vec4::put_elem_(size_t idx, const vvp_vector4_t&value)
+{
+      assert(idx < count_);
+      unsigned long*ptr = elem_(idx);
+      if (value.size() == wid_) {
+	    value.get_words(ptr, ptr + words_/2);
+      } else {
+	    vvp_vector4_t tmp (value);
+	    tmp.resize(wid_, BIT4_0);
+	    tmp.get_words(ptr, ptr + words_/2);
+      }
+}
+
+void vvp_queue_vec4::reserve_(const vvp_vector4_t&value)
+{
+      if (count_ == 0) {
+	    size_t words = 2 * value.words_count();
+	    if (words != words_) {
+		  delete[]buf_;
+		  buf_ = 0;
+		  cap_ = 0;
+		  words_ = words;
+	    }
+	    wid_ = value.size();
+	    head_ = 0;
+      }
+
+      if (count_ < cap_)
+	    return;
+
+	// Grow the ring, and unwrap the elements to the start of
+	// the new buffer.
+      size_t new_cap = cap_? 2*cap_ : 8;
+      unsigned long*new_buf = new unsigned long[new_cap * words_];
+      for (size_t idx = 0 ; idx < count_ ; idx += 1)
+	    memcpy(new_buf + idx*words_, elem_(idx), words_*sizeof(unsigned long));
+      delete[]buf_;
+      buf_ = new_buf;
+      cap_ = new_cap;
+      head_ = 0;
+}
+
+void vvp_queue_vec4::move_(size_t dst, size_t src, size_t cnt)
+{
+      const size_t bytes = words_*sizeof(unsigned long);
+      if (dst < src) {
+	    for (size_t idx = 0 ; idx < cnt ; idx += 1)
+		  memcpy(elem_(dst+idx), elem_(src+idx), bytes);
+      } else if (dst > src) {
+	    for (size_t idx = cnt ; idx > 0 ; idx -= 1)
+		  memcpy(elem_(dst+idx-1), elem_(src+idx-1), bytes);
+      }
 }
 
 void vvp_queue_vec4::copy_elems(vvp_object_t src, unsigned max_size)
 {
-      if (vvp_queue*src_queue = src.peek<vvp_queue>())
+      vvp_queue_vec4*src_vec4 = src.peek<vvp_queue_vec4>();
+      if (src_vec4 && src_vec4->count_ > 0) {
+	      // Another vector queue is copied a word array at a time.
+	    size_t src_size = src_vec4->count_;
+	    if ((max_size != 0) && (src_size > max_size)) {
+		  vvp_vector4_t tmp;
+		  print_copy_is_too_big(tmp, src_size, max_size);
+	    }
+	    size_t copy_size = ((src_size < max_size) ||
+				(max_size == 0)) ? src_size : max_size;
+	    if (src_vec4 == this) {
+		  erase_tail(copy_size);
+		  return;
+	    }
+
+	    size_t new_cap = 8;
+	    while (new_cap < copy_size)
+		  new_cap *= 2;
+
+	    words_ = src_vec4->words_;
+	    wid_ = src_vec4->wid_;
+	    delete[]buf_;
+	    buf_ = new unsigned long[new_cap * words_];
+	    cap_ = new_cap;
+	    head_ = 0;
+	    count_ = copy_size;
+
+	      // The source holds at most two runs of elements.
+	    size_t first = src_vec4->cap_ - src_vec4->head_;
+	    if (first > copy_size) first = copy_size;
+	    memcpy(buf_, src_vec4->elem_(0), first*words_*sizeof(unsigned long));
+	    if (first < copy_size)
+		  memcpy(buf_ + first*words_, src_vec4->elem_(first),
+			 (copy_size-first)*words_*sizeof(unsigned long));
+
+      } else if (vvp_queue*src_queue = src.peek<vvp_queue>())
 	    copy_elements<vvp_vector4_t, vvp_queue_vec4, vvp_queue>(this, src_queue, max_size);
       else if (vvp_darray*src_darray = src.peek<vvp_darray>())
 	    copy_elements<vvp_vector4_t, vvp_queue_vec4, vvp_darray>(this, src_darray, max_size);
@@ -793,10 +899,12 @@ void vvp_queue_vec4::copy_elems(vvp_object_t src, unsigned max_size)
 
 void vvp_queue_vec4::set_word_max(unsigned adr, const vvp_vector4_t&value, unsigned max_size)
 {
-      if (adr == queue.size())
-	    if (!max_size || (queue.size() < max_size))
-		  queue.push_back(value);
-	    else
+      if (adr == count_)
+	    if (!max_size || (count_ < max_size)) {
+		  reserve_(value);
+		  count_ += 1;
+		  put_elem_(count_-1, value);
+	    } else
 		  cerr << get_fileline()
 		       << "Warning: assigning to queue<vector>[" << adr << "] is"
 		          " outside bound (" << max_size << "). " << value
@@ -807,57 +915,71 @@ void vvp_queue_vec4::set_word_max(unsigned adr, const vvp_vector4_t&value, unsig
 
 void vvp_queue_vec4::set_word(unsigned adr, const vvp_vector4_t&value)
 {
-      if (adr < queue.size())
-	    queue[adr] = value;
+      if (adr < count_)
+	    put_elem_(adr, value);
       else
 	    cerr << get_fileline()
 	         << "Warning: assigning to queue<vector>[" << adr << "] is outside "
-	            "of size (" << queue.size() << "). " << value
+	            "of size (" << count_ << "). " << value
 	         << " was not added." << endl;
 }
 
 void vvp_queue_vec4::get_word(unsigned adr, vvp_vector4_t&value)
 {
-      if (adr >= queue.size())
-	    value = vvp_vector4_t(queue[0].size());
+      if (adr >= count_)
+	    value = vvp_vector4_t(wid_);
       else
-	    value = queue[adr];
+	    value = get_elem_(adr);
 }
 
 void vvp_queue_vec4::insert(unsigned idx, const vvp_vector4_t&value, unsigned max_size)
 {
 	// Inserting past the end of the queue
-      if (idx > queue.size())
+      if (idx > count_)
 	    cerr << get_fileline()
 	         << "Warning: inserting to queue<vector[" << value.size()
-	         << "]>[" << idx << "] is outside of size (" << queue.size()
+	         << "]>[" << idx << "] is outside of size (" << count_
 	         << "). " << value << " was not added." << endl;
 	// Inserting at the end
-      else if (idx == queue.size())
-	    if (!max_size || (queue.size() < max_size))
-		  queue.push_back(value);
-	    else
+      else if (idx == count_)
+	    if (!max_size || (count_ < max_size)) {
+		  reserve_(value);
+		  count_ += 1;
+		  put_elem_(idx, value);
+	    } else
 		  cerr << get_fileline()
 		       << "Warning: inserting to queue<vector[" << value.size()
 		       << "]>[" << idx << "] is outside bound (" << max_size
 		       << "). " << value << " was not added." << endl;
       else  {
-	    if (max_size && (queue.size() == max_size)) {
+	    if (max_size && (count_ == max_size)) {
 		  cerr << get_fileline()
 		       << "Warning: insert("<< idx << ", " << value << ") removed "
-		       << queue.back() << " from already full bounded queue<vector["
+		       << get_elem_(count_-1) << " from already full bounded queue<vector["
 		       << value.size() << "]> [" << max_size << "]." << endl;
-		  queue.pop_back();
+		  pop_back();
 	    }
-	    queue.insert(queue.begin()+idx, value);
+	    reserve_(value);
+	      // Open a gap at idx by moving the shorter side out.
+	    if (idx < count_/2) {
+		  head_ = (head_ + cap_ - 1) & (cap_ - 1);
+		  count_ += 1;
+		  move_(0, 1, idx);
+	    } else {
+		  count_ += 1;
+		  move_(idx+1, idx, count_-1-idx);
+	    }
+	    put_elem_(idx, value);
       }
 }
 
 void vvp_queue_vec4::push_back(const vvp_vector4_t&value, unsigned max_size)
 {
-      if (!max_size || (queue.size() < max_size))
-	    queue.push_back(value);
-      else
+      if (!max_size || (count_ < max_size)) {
+	    reserve_(value);
+	    count_ += 1;
+	    put_elem_(count_-1, value);
+      } else
 	    cerr << get_fileline()
 	         << "Warning: push_back(" << value
 	         << ") skipped for already full bounded queue<vector["
@@ -866,25 +988,47 @@ void vvp_queue_vec4::push_back(const vvp_vector4_t&value, unsigned max_size)
 
 void vvp_queue_vec4::push_front(const vvp_vector4_t&value, unsigned max_size)
 {
-      if (max_size && (queue.size() == max_size)) {
+      if (max_size && (count_ == max_size)) {
 	    cerr << get_fileline()
 	         << "Warning: push_front(" << value << ") removed "
-	         << queue.back() << " from already full bounded queue<vector["
+	         << get_elem_(count_-1) << " from already full bounded queue<vector["
 	         << value.size() << "]> [" << max_size << "]." << endl;
-	    queue.pop_back();
+	    pop_back();
       }
-      queue.push_front(value);
+      reserve_(value);
+      head_ = (head_ + cap_ - 1) & (cap_ - 1);
+      count_ += 1;
+      put_elem_(0, value);
+}
+
+void vvp_queue_vec4::pop_back(void)
+{
+      assert(count_ > 0);
+      count_ -= 1;
+}
+
+void vvp_queue_vec4::pop_front(void)
+{
+      assert(count_ > 0);
+      head_ = (head_ + 1) & (cap_ - 1);
+      count_ -= 1;
 }
 
 void vvp_queue_vec4::erase(unsigned idx)
 {
-      assert(queue.size() > idx);
-      queue.erase(queue.begin()+idx);
+      assert(count_ > idx);
+	// Close the gap by moving the shorter side in.
+      if (idx < count_/2) {
+	    move_(1, 0, idx);
+	    head_ = (head_ + 1) & (cap_ - 1);
+      } else {
+	    move_(idx, idx+1, count_-1-idx);
+      }
+      count_ -= 1;
 }
 
 void vvp_queue_vec4::erase_tail(unsigned idx)
 {
-      assert(queue.size() >= idx);
-      if (queue.size() > idx)
-	    queue.resize(idx);
+      assert(count_ >= idx);
+      count_ = idx;
 }
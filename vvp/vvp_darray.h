@@ -225,12 +225,23 @@ class vvp_queue_string : public vvp_queue {
       std::deque<std::string> queue;
 };
 
+/*
+ * The elements of a vector queue all have the same width, so they are
+ * stored packed in a ring buffer of words instead of as separate
+ * vvp_vector4_t objects. Each element takes words_ words: the abits
+ * followed by the bbits. The ring capacity is a power of 2 and the
+ * buffer grows by doubling, so pushing and popping at either end is
+ * amortized O(1), and insert/erase move the elements on the shorter
+ * side of the index. The element width is taken from the first value
+ * stored into the queue.
+ */
 class vvp_queue_vec4 : public vvp_queue {
 
     public:
+      vvp_queue_vec4();
       ~vvp_queue_vec4();
 
-      size_t get_size(void) const { return queue.size(); };
+      size_t get_size(void) const { return count_; };
       void copy_elems(vvp_object_t src, unsigned max_size);
       void set_word_max(unsigned adr, const vvp_vector4_t&value, unsigned max_size);
       void set_word(unsigned adr, const vvp_vector4_t&value);
@@ -238,13 +249,34 @@ class vvp_queue_vec4 : public vvp_queue {
       void insert(unsigned idx, const vvp_vector4_t&value, unsigned max_size);
       void push_back(const vvp_vector4_t&value, unsigned max_size);
       void push_front(const vvp_vector4_t&value, unsigned max_size);
-      void pop_back(void) { queue.pop_back(); };
-      void pop_front(void) { queue.pop_front(); };
+      void pop_back(void);
+      void pop_front(void);
       void erase(unsigned idx);
       void erase_tail(unsigned idx);
 
     private:
-      std::deque<vvp_vector4_t> queue;
+	// Address of the words of element idx.
+      inline unsigned long*elem_(size_t idx) const
+      { return buf_ + ((head_ + idx) & (cap_ - 1)) * words_; }
+
+      vvp_vector4_t get_elem_(size_t idx) const;
+      void put_elem_(size_t idx, const vvp_vector4_t&value);
+	// Make sure the next element fits, setting the width from
+	// the value if the queue is empty.
+      void reserve_(const vvp_vector4_t&value);
+	// Move cnt elements from index src to index dst.
+      void move_(size_t dst, size_t src, size_t cnt);
+
+      unsigned wid_;
+      size_t words_;
+      unsigned long*buf_;
+      size_t cap_;
+      size_t head_;
+      size_t count_;
+
+    private: // not implemented
+      vvp_queue_vec4(const vvp_queue_vec4&);
+      vvp_queue_vec4& operator= (const vvp_queue_vec4&);
 };
 
 extern std::string get_fileline();
@@ -583,6 +583,7 @@ const vvp_vector4_t vvp_vector4_t::nil;
 
 void vvp_vector4_t::copy_bits(const vvp_vector4_t&that)
 {
+      unshare_();
 
       if (size_ == that.size_) {
 	    if (size_ > BITS_PER_WORD) {
@@ -664,19 +665,24 @@ void vvp_vector4_t::copy_bits(const vvp_vector4_t&that)
 }
 
 /*
- * This function should ONLY BE CALLED FROM vvp_vector4_t::copy_from_,
- * as it performs part of that functions tasks.
+ * Replace the shared word block of this vector with a private copy.
+ * This is only called through unshare_(), which checks that the
+ * vector is wide and the block is shared.
  */
-void vvp_vector4_t::copy_from_big_(const vvp_vector4_t&that)
+void vvp_vector4_t::unshare_big_()
 {
       unsigned words = (size_+BITS_PER_WORD-1) / BITS_PER_WORD;
-      abits_ptr_ = new unsigned long[2*words];
-      bbits_ptr_ = abits_ptr_ + words;
+      unsigned long*old_abits = abits_ptr_;
+      unsigned long*old_bbits = bbits_ptr_;
 
+      abits_ptr_ = alloc_words_(words);
+      bbits_ptr_ = abits_ptr_ + words;
       for (unsigned idx = 0 ;  idx < words ;  idx += 1)
-	    abits_ptr_[idx] = that.abits_ptr_[idx];
+	    abits_ptr_[idx] = old_abits[idx];
       for (unsigned idx = 0 ;  idx < words ;  idx += 1)
-	    bbits_ptr_[idx] = that.bbits_ptr_[idx];
+	    bbits_ptr_[idx] = old_bbits[idx];
+
+      old_abits[-1] -= 1;
 }
 
 /*
@@ -689,7 +695,7 @@ void vvp_vector4_t::copy_inverted_from_(const vvp_vector4_t&that)
       size_ = that.size_;
       if (size_ > BITS_PER_WORD) {
 	    unsigned words = (size_+BITS_PER_WORD-1) / BITS_PER_WORD;
-	    abits_ptr_ = new unsigned long[2*words];
+	    abits_ptr_ = alloc_words_(words);
 	    bbits_ptr_ = abits_ptr_ + words;
 
 	    unsigned remaining = size_;
@@ -719,7 +725,7 @@ void vvp_vector4_t::allocate_words_(unsigned long inita, unsigned long initb)
 {
       if (size_ > BITS_PER_WORD) {
 	    unsigned cnt = (size_ + BITS_PER_WORD - 1) / BITS_PER_WORD;
-	    abits_ptr_ = new unsigned long[2*cnt];
+	    abits_ptr_ = alloc_words_(cnt);
 	    bbits_ptr_ = abits_ptr_ + cnt;
 	    for (unsigned idx = 0 ;  idx < cnt ;  idx += 1)
 		  abits_ptr_[idx] = inita;
@@ -959,6 +965,7 @@ void vvp_vector4_t::resize(unsigned newsize, vvp_bit4_t pad_bit)
 		    // no need for re-allocation so we are done now.
 		  if (newsize > size_) {
 			if (unsigned fill = size_ % BITS_PER_WORD) {
+			      unshare_();
 			      abits_ptr_[cnt-1] &= ~((-1UL) << fill);
 			      bbits_ptr_[cnt-1] &= ~((-1UL) << fill);
 			      abits_ptr_[cnt-1] |= word_pad_abits << fill;
@@ -969,7 +976,7 @@ void vvp_vector4_t::resize(unsigned newsize, vvp_bit4_t pad_bit)
 		  return;
 	    }
 
-	    unsigned long*newbits = new unsigned long[2*newcnt];
+	    unsigned long*newbits = alloc_words_(newcnt);
 
 	    if (cnt > 1) {
 		  unsigned trans = cnt;
@@ -981,7 +988,7 @@ void vvp_vector4_t::resize(unsigned newsize, vvp_bit4_t pad_bit)
 		  for (unsigned idx = 0 ;  idx < trans ;  idx += 1)
 			newbits[newcnt+idx] = bbits_ptr_[idx];
 
-		  delete[]abits_ptr_;
+		  release_words_();
 
 	    } else {
 		  newbits[0] = abits_val_;
@@ -1009,7 +1016,7 @@ void vvp_vector4_t::resize(unsigned newsize, vvp_bit4_t pad_bit)
 	    if (cnt > 1) {
 		  unsigned long newvala = abits_ptr_[0];
 		  unsigned long newvalb = bbits_ptr_[0];
-		  delete[]abits_ptr_;
+		  release_words_();
 		  abits_val_ = newvala;
 		  bbits_val_ = newvalb;
 	    }
@@ -1106,6 +1113,7 @@ unsigned long* vvp_vector4_t::subarray(unsigned adr, unsigned wid, bool xz_to_0)
 
 void vvp_vector4_t::setarray(unsigned adr, unsigned wid, const unsigned long*val)
 {
+      unshare_();
       assert(adr+wid <= size_);
 
       const unsigned BIT2_PER_WORD = 8*sizeof(unsigned long);
@@ -1177,6 +1185,7 @@ void vvp_vector4_t::setarray(unsigned adr, unsigned wid, const unsigned long*val
  */
 bool vvp_vector4_t::set_vec(unsigned adr, const vvp_vector4_t&that)
 {
+      unshare_();
       assert(adr+that.size_  <= size_);
       bool diff_flag = false;
 
@@ -1395,6 +1404,7 @@ bool vvp_vector4_t::set_vec(unsigned adr, const vvp_vector4_t&that)
  */
 void vvp_vector4_t::add(const vvp_vector4_t&that)
 {
+      unshare_();
       assert(size_ == that.size_);
 
       if (size_ < BITS_PER_WORD) {
@@ -1454,6 +1464,7 @@ void vvp_vector4_t::add(const vvp_vector4_t&that)
 
 void vvp_vector4_t::sub(const vvp_vector4_t&that)
 {
+      unshare_();
       assert(size_ == that.size_);
 
       if (size_ < BITS_PER_WORD) {
@@ -1514,6 +1525,7 @@ void vvp_vector4_t::sub(const vvp_vector4_t&that)
 
 void vvp_vector4_t::mov(unsigned dst, unsigned src, unsigned cnt)
 {
+      unshare_();
       assert(dst+cnt <= size_);
       assert(src+cnt <= size_);
 
@@ -1587,6 +1599,7 @@ void vvp_vector4_t::mov(unsigned dst, unsigned src, unsigned cnt)
 
 void vvp_vector4_t::mul(const vvp_vector4_t&that)
 {
+      unshare_();
       assert(size_ == that.size_);
 
       if (size_ < BITS_PER_WORD) {
@@ -1779,6 +1792,7 @@ bool vvp_vector4_t::has_xz() const
 
 void vvp_vector4_t::change_z2x()
 {
+      unshare_();
 	// This method relies on the fact that both BIT4_X and BIT4_Z
 	// have the bbit set in the vector4 encoding, and also that
 	// the BIT4_X has abit set in the vector4 encoding. By simply
@@ -1796,6 +1810,7 @@ void vvp_vector4_t::change_z2x()
 
 void vvp_vector4_t::set_to_x()
 {
+      unshare_();
       if (size_ <= BITS_PER_WORD) {
 	    abits_val_ = vvp_vector4_t::WORD_X_ABITS;
             bbits_val_ = vvp_vector4_t::WORD_X_BBITS;
@@ -1840,6 +1855,7 @@ char* vvp_vector4_t::as_string(char*buf, size_t buf_len) const
 
 void vvp_vector4_t::invert()
 {
+      unshare_();
       if (size_ <= BITS_PER_WORD) {
 	    unsigned long mask = (size_<BITS_PER_WORD)? (1UL<<size_)-1UL : -1UL;
 	    abits_val_ = mask & ~abits_val_;
@@ -1863,6 +1879,7 @@ void vvp_vector4_t::invert()
 
 vvp_vector4_t& vvp_vector4_t::operator &= (const vvp_vector4_t&that)
 {
+      unshare_();
 	// The truth table is:
 	//     00 01 11 10
 	//  00 00 00 00 00
@@ -1891,6 +1908,7 @@ vvp_vector4_t& vvp_vector4_t::operator &= (const vvp_vector4_t&that)
 
 vvp_vector4_t& vvp_vector4_t::operator |= (const vvp_vector4_t&that)
 {
+      unshare_();
 	// The truth table is:
 	//     00 01 11 10
 	//  00 00 01 11 11
@@ -1926,6 +1944,7 @@ vvp_vector4_t& vvp_vector4_t::operator |= (const vvp_vector4_t&that)
 */
 vvp_vector4_t& vvp_vector4_t::operator += (int64_t that)
 {
+      unshare_();
       vvp_bit4_t carry = BIT4_0;
       unsigned idx;
 
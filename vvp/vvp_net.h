@@ -264,6 +264,11 @@ class vvp_vector4_t {
       vvp_vector4_t(const vvp_vector4_t&that);
       vvp_vector4_t(const vvp_vector4_t&that, bool invert_flag);
       vvp_vector4_t& operator= (const vvp_vector4_t&that);
+# if __cplusplus >= 201103L
+	// The moved from vector is left with size 0.
+      vvp_vector4_t(vvp_vector4_t&&that);
+      vvp_vector4_t& operator= (vvp_vector4_t&&that);
+# endif
 
       ~vvp_vector4_t();
 
@@ -280,6 +285,14 @@ class vvp_vector4_t {
       unsigned long*subarray(unsigned idx, unsigned size, bool xz_to_0 =false) const;
       void setarray(unsigned idx, unsigned size, const unsigned long*val);
 
+	// Copy the raw abit and bbit words of the vector out to, or
+	// in from, arrays of words_count() words each. set_words does
+	// not change the size of the vector.
+      inline unsigned words_count() const
+      { return size_ > BITS_PER_WORD? (size_+BITS_PER_WORD-1)/BITS_PER_WORD : 1; }
+      void get_words(unsigned long*abits, unsigned long*bbits) const;
+      void set_words(const unsigned long*abits, const unsigned long*bbits);
+
 	// Set a 4-value bit or subvector into the vector. Return true
 	// if any bits of the vector change as a result of this operation.
       void set_bit(unsigned idx, vvp_bit4_t val);
@@ -349,11 +362,24 @@ class vvp_vector4_t {
 	// Initialize and operator= use this private method to copy
 	// the data from that object into this object.
       void copy_from_(const vvp_vector4_t&that);
-      void copy_from_big_(const vvp_vector4_t&that);
+	// Copy the size and the bits or block pointers, without
+	// touching the reference count.
+      inline void take_bits_(const vvp_vector4_t&that);
       void copy_inverted_from_(const vvp_vector4_t&that);
 
       void allocate_words_(unsigned long inita, unsigned long initb);
 
+	// A vector wider than a word keeps its abits and bbits in a
+	// heap block that starts with a reference count, and copies
+	// of the vector share the block. Every method that changes
+	// the bits calls unshare_() first, to get a private copy of
+	// the block if it is shared.
+      static unsigned long*alloc_words_(unsigned cnt);
+      inline void release_words_();
+      inline void unshare_()
+      { if (size_ > BITS_PER_WORD && abits_ptr_[-1] > 1) unshare_big_(); }
+      void unshare_big_();
+
 	// Values in the vvp_vector4_t are stored split across two
 	// arrays. For each bit in the vector, there is an abit and a
 	// bbit. the encoding of a vvp_vector4_t is:
@@ -407,13 +433,25 @@ inline vvp_vector4_t::vvp_vector4_t(unsigned size__, vvp_bit4_t val)
       allocate_words_(init_atable[val], init_btable[val]);
 }
 
+inline unsigned long*vvp_vector4_t::alloc_words_(unsigned cnt)
+{
+      unsigned long*blk = new unsigned long[2*cnt + 1];
+      blk[0] = 1;
+      return blk + 1;
+}
+
+inline void vvp_vector4_t::release_words_()
+{
+	// bbits_ptr_ actually points half-way into the same block as
+	// abits_ptr_, and the reference count is just before abits.
+      if (--abits_ptr_[-1] == 0)
+	    delete[] (abits_ptr_ - 1);
+}
+
 inline vvp_vector4_t::~vvp_vector4_t()
 {
-      if (size_ > BITS_PER_WORD) {
-	    delete[] abits_ptr_;
-	      // bbits_ptr_ actually points half-way into a
-	      // double-length array started at abits_ptr_
-      }
+      if (size_ > BITS_PER_WORD)
+	    release_words_();
 }
 
 inline vvp_vector4_t& vvp_vector4_t::operator= (const vvp_vector4_t&that)
@@ -422,21 +460,82 @@ inline vvp_vector4_t& vvp_vector4_t::operator= (const vvp_vector4_t&that)
 	    return *this;
 
       if (size_ > BITS_PER_WORD)
-	    delete[] abits_ptr_;
+	    release_words_();
 
       copy_from_(that);
 
       return *this;
 }
 
-inline void vvp_vector4_t::copy_from_(const vvp_vector4_t&that)
+# if __cplusplus >= 201103L
+inline vvp_vector4_t::vvp_vector4_t(vvp_vector4_t&&that)
+{
+      take_bits_(that);
+      that.size_ = 0;
+}
+
+inline vvp_vector4_t& vvp_vector4_t::operator= (vvp_vector4_t&&that)
+{
+      if (this == &that)
+	    return *this;
+
+      if (size_ > BITS_PER_WORD)
+	    release_words_();
+
+      take_bits_(that);
+      that.size_ = 0;
+
+      return *this;
+}
+# endif
+
+inline void vvp_vector4_t::take_bits_(const vvp_vector4_t&that)
 {
       size_ = that.size_;
-      if (size_ <= BITS_PER_WORD) {
+      if (size_ > BITS_PER_WORD) {
+	    abits_ptr_ = that.abits_ptr_;
+	    bbits_ptr_ = that.bbits_ptr_;
+      } else {
 	    abits_val_ = that.abits_val_;
 	    bbits_val_ = that.bbits_val_;
+      }
+}
+
+inline void vvp_vector4_t::copy_from_(const vvp_vector4_t&that)
+{
+      take_bits_(that);
+      if (size_ > BITS_PER_WORD)
+	    abits_ptr_[-1] += 1;
+}
+
+inline void vvp_vector4_t::get_words(unsigned long*abits,
+				      unsigned long*bbits) const
+{
+      if (size_ > BITS_PER_WORD) {
+	    unsigned cnt = words_count();
+	    for (unsigned idx = 0 ; idx < cnt ; idx += 1) {
+		  abits[idx] = abits_ptr_[idx];
+		  bbits[idx] = bbits_ptr_[idx];
+	    }
+      } else {
+	    abits[0] = abits_val_;
+	    bbits[0] = bbits_val_;
+      }
+}
+
+inline void vvp_vector4_t::set_words(const unsigned long*abits,
+				      const unsigned long*bbits)
+{
+      unshare_();
+      if (size_ > BITS_PER_WORD) {
+	    unsigned cnt = words_count();
+	    for (unsigned idx = 0 ; idx < cnt ; idx += 1) {
+		  abits_ptr_[idx] = abits[idx];
+		  bbits_ptr_[idx] = bbits[idx];
+	    }
       } else {
-	    copy_from_big_(that);
+	    abits_val_ = abits[0];
+	    bbits_val_ = bbits[0];
       }
 }
 
@@ -479,6 +578,7 @@ inline void vvp_vector4_t::set_bit(unsigned idx, vvp_bit4_t val)
       unsigned long mask = 1UL << off;
 
       if (size_ > BITS_PER_WORD) {
+	    unshare_();
 	    unsigned wdx = idx / BITS_PER_WORD;
 	    switch (val) {
 		case BIT4_0:
@@ -1129,6 +1229,9 @@ class vvp_net_t {
       void link(vvp_net_ptr_t port);
 	// Disconnect the port from the output of this net.
       void unlink(vvp_net_ptr_t port);
+	// The head of the fan-out list. The rest of the list is
+	// reached through the port[] members of the receiving nets.
+      vvp_net_ptr_t fanout() const { return out_; }
 
     public: // Methods to propagate output from this node.
       void send_vec4(const vvp_vector4_t&val, vvp_context_t context);